@@ -13,9 +13,12 @@
 
 #include "Cintex/Cintex.h"
 #include "G__ci.h"
+#include "RVersion.h"
 #include "TError.h"
 #include "TH1.h"
+#include "TROOT.h"
 #include "TSystem.h"
+#include "TThread.h"
 #include "TTree.h"
 
 #include <sstream>
@@ -194,4 +197,23 @@ namespace art {
       configureRefCoreStreamer();
    }
 
+   void enableRootThreadSafety()
+   {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+      ROOT::EnableThreadSafety();
+#else
+      TThread::Initialize();
+#endif
+   }
+
+   bool enableRootImplicitMT()
+   {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,6,0)
+      ROOT::EnableImplicitMT();
+      return true;
+#else
+      return false;
+#endif
+   }
+
 }  // art
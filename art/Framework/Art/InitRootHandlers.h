@@ -7,6 +7,13 @@ namespace art {
    void setRootErrorHandler(bool want_custom);
    void completeRootHandlers();
 
+   // Make ROOT safe for use from several threads at once.
+   void enableRootThreadSafety();
+
+   // Have ROOT compress the baskets of a tree in parallel when the tree
+   // is filled. Returns false if this version of ROOT cannot.
+   bool enableRootImplicitMT();
+
 }  // art
 
 // ======================================================================
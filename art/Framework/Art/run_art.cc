@@ -296,6 +296,18 @@ int art::run_art_common_(fhicl::ParameterSet main_pset)
     rdm.dumpReflexDictionaryInfo(std::cerr);
   }
   art::completeRootHandlers();
+  if (scheduler_pset.get<bool>("parallelOutput", false) ||
+      scheduler_pset.get<bool>("concurrentTriggerPaths", false) ||
+      scheduler_pset.get<bool>("concurrentProducers", false) ||
+      scheduler_pset.get<unsigned>("num_schedules", 1) > 1) {
+    art::enableRootThreadSafety();
+  }
+  if (scheduler_pset.get<bool>("parallelBasketCompression", false) &&
+      !art::enableRootImplicitMT()) {
+    mf::LogWarning("Configuration")
+      << "services.scheduler.parallelBasketCompression is ignored:\n"
+      << "it is not supported by this version of ROOT.\n";
+  }
   art::ServiceToken dummyToken;
   // TODO: Possibly remove addServices -- we have already made
   // most of them. Have to see how the module factory interacts
@@ -20,6 +20,14 @@ EventObserver::
 {
 }
 
+ConsumedProducts const&
+EventObserver::
+consumedProducts() const
+{
+  static ConsumedProducts const none;
+  return none;
+}
+
 EventObserver::
 EventObserver(ParameterSet const& pset)
   : wantAllEvents_(false)
@@ -4,6 +4,7 @@
 // OutputModule and EDAnalyzer.
 
 #include "art/Framework/Core/CachedProducts.h"
+#include "art/Framework/Principal/ConsumedProduct.h"
 #include "fhiclcpp/ParameterSet.h"
 #include "fhiclcpp/ParameterSetID.h"
 
@@ -23,6 +24,10 @@ public:
   // FIXME: One could obviate the need for this trivial implementation
   // by putting some type logic in WorkerT.
   void registerProducts(MasterProductRegistry&, ModuleDescription const &) {}
+  // Observers take no part in the ordering of modules by their data
+  // dependencies, so need declare nothing.
+  ConsumedProducts const& consumedProducts() const;
+  bool declaresConsumes() const { return false; }
   //
   // SelectEvents handling
   //
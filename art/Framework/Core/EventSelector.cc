@@ -48,56 +48,68 @@
 using namespace cet;
 using namespace std;
 
+namespace {
+
+  // The low bit of each two-bit path state field.
+  constexpr std::uint64_t lowBits = 0x5555555555555555ull;
+
+  // From packed path states, the low bits of the fields of the paths
+  // in each state.
+  inline std::uint64_t passed(std::uint64_t const w)
+  {
+    return w & ~(w >> 1) & lowBits;
+  }
+
+  inline std::uint64_t failed(std::uint64_t const w)
+  {
+    return (w >> 1) & ~w & lowBits;
+  }
+
+  inline std::uint64_t excepted(std::uint64_t const w)
+  {
+    return w & (w >> 1) & lowBits;
+  }
+
+}
+
 
 namespace art {
 
   EventSelector::EventSelector(Strings const& pathspecs,
                                Strings const& names):
-    accept_all_(false),
-    absolute_acceptors_(),
-    conditional_acceptors_(),
-    exception_acceptors_(),
-    all_must_fail_(),
-    all_must_fail_noex_(),
+    sel_(),
     results_from_current_process_(true),
     psetID_initialized_(false),
     psetID_(),
+    selections_(),
+    packed_(),
     paths_(),
-    nTriggerNames_(0),
     notStarPresent_(false)
   {
     init(pathspecs, names);
   }
 
   EventSelector::EventSelector(Strings const& pathspecs):
-    accept_all_(false),
-    absolute_acceptors_(),
-    conditional_acceptors_(),
-    exception_acceptors_(),
-    all_must_fail_(),
-    all_must_fail_noex_(),
+    sel_(),
     results_from_current_process_(false),
     psetID_initialized_(false),
     psetID_(),
+    selections_(),
+    packed_(),
     paths_(pathspecs),
-    nTriggerNames_(0),
     notStarPresent_(false)
   {
   }
 
   EventSelector::EventSelector(fhicl::ParameterSet const& config,
                                Strings const& triggernames):
-    accept_all_(false),
-    absolute_acceptors_(),
-    conditional_acceptors_(),
-    exception_acceptors_(),
-    all_must_fail_(),
-    all_must_fail_noex_(),
+    sel_(),
     results_from_current_process_(true),
     psetID_initialized_(false),
     psetID_(),
+    selections_(),
+    packed_(),
     paths_(),
-    nTriggerNames_(0),
     notStarPresent_(false)
   {
     Strings paths; // default is empty...
@@ -113,18 +125,18 @@ namespace art {
                       Strings const& triggernames)
   {
     // cerr << "### init entered\n";
-    accept_all_ = false;
-    absolute_acceptors_.clear(),
-    conditional_acceptors_.clear(),
-    exception_acceptors_.clear(),
-    all_must_fail_.clear();
-    all_must_fail_noex_.clear();
-    nTriggerNames_ = triggernames.size();
+    sel_.accept_all_ = false;
+    sel_.absolute_acceptors_.clear(),
+    sel_.conditional_acceptors_.clear(),
+    sel_.exception_acceptors_.clear(),
+    sel_.all_must_fail_.clear();
+    sel_.all_must_fail_noex_.clear();
+    sel_.nTriggerNames_ = triggernames.size();
     notStarPresent_ = false;
 
     if (paths.empty())
       {
-        accept_all_ = true;
+        sel_.accept_all_ = true;
         return;
       }
 
@@ -214,17 +226,17 @@ namespace art {
       if (!negative_criterion && !noex_demanded && !exception_spec) {
         for (unsigned int t = 0; t != matches.size(); ++t) {
           BitInfo bi(distance(triggernames.begin(),matches[t]), true);
-          absolute_acceptors_.push_back(bi);
+          sel_.absolute_acceptors_.push_back(bi);
         }
       } else if (!negative_criterion && noex_demanded) {
         for (unsigned int t = 0; t != matches.size(); ++t) {
           BitInfo bi(distance(triggernames.begin(),matches[t]), true);
-          conditional_acceptors_.push_back(bi);
+          sel_.conditional_acceptors_.push_back(bi);
         }
       } else if (exception_spec) {
         for (unsigned int t = 0; t != matches.size(); ++t) {
           BitInfo bi(distance(triggernames.begin(),matches[t]), true);
-          exception_acceptors_.push_back(bi);
+          sel_.exception_acceptors_.push_back(bi);
         }
       } else if (negative_criterion && !noex_demanded) {
         if (matches.empty()) {
@@ -235,7 +247,7 @@ namespace art {
 
         } else if (matches.size() == 1) {
           BitInfo bi(distance(triggernames.begin(),matches[0]), false);
-          absolute_acceptors_.push_back(bi);
+          sel_.absolute_acceptors_.push_back(bi);
         } else {
           Bits mustfail;
           for (unsigned int t = 0; t != matches.size(); ++t) {
@@ -243,7 +255,7 @@ namespace art {
             // We set this to false because that will demand bits are Fail.
             mustfail.push_back(bi);
           }
-          all_must_fail_.push_back(mustfail);
+          sel_.all_must_fail_.push_back(mustfail);
         }
       } else if (negative_criterion && noex_demanded) {
         if (matches.empty()) {
@@ -254,27 +266,80 @@ namespace art {
 
         } else if (matches.size() == 1) {
           BitInfo bi(distance(triggernames.begin(),matches[0]), false);
-          conditional_acceptors_.push_back(bi);
+          sel_.conditional_acceptors_.push_back(bi);
         } else {
           Bits mustfail;
           for (unsigned int t = 0; t != matches.size(); ++t) {
             BitInfo bi(distance(triggernames.begin(),matches[t]), false);
             mustfail.push_back(bi);
           }
-          all_must_fail_noex_.push_back(mustfail);
+          sel_.all_must_fail_noex_.push_back(mustfail);
         }
       }
     } // end of the for loop on i(paths.begin()), end(paths.end())
 
-    if (unrestricted_star && negated_star && exception_star) accept_all_ = true;
+    if (unrestricted_star && negated_star && exception_star) sel_.accept_all_ = true;
+
+    sel_.compile();
 
     // cerr << "### init exited\n";
 
   } // EventSelector::init
 
+  EventSelector::Selection::Selection():
+    accept_all_(false),
+    absolute_acceptors_(),
+    conditional_acceptors_(),
+    exception_acceptors_(),
+    all_must_fail_(),
+    all_must_fail_noex_(),
+    nTriggerNames_(0),
+    pass_(),
+    fail_(),
+    exception_(),
+    conditional_pass_(),
+    conditional_fail_(),
+    must_fail_(),
+    must_fail_noex_()
+  {
+  }
+
+  void
+  EventSelector::Selection::compile()
+  {
+    std::size_t const nWords = (nTriggerNames_ + 31) / 32;
+    auto set = [](Mask& m, unsigned int const pos) {
+      m[pos / 32] |= std::uint64_t(1) << (2 * (pos % 32));
+    };
+    auto compileBits = [nWords, &set](Bits const& bits, Mask& pass, Mask& fail) {
+      pass.assign(nWords, 0);
+      fail.assign(nWords, 0);
+      for (auto const& bi : bits) {
+        set(bi.accept_state_ ? pass : fail, bi.pos_);
+      }
+    };
+    compileBits(absolute_acceptors_, pass_, fail_);
+    compileBits(conditional_acceptors_, conditional_pass_, conditional_fail_);
+    exception_.assign(nWords, 0);
+    for (auto const& bi : exception_acceptors_) {
+      set(exception_, bi.pos_);
+    }
+    auto compileMustFail = [nWords, &set](std::vector<Bits> const& lists,
+                                          std::vector<Mask>& masks) {
+      masks.assign(lists.size(), Mask(nWords, 0));
+      for (std::size_t i = 0; i != lists.size(); ++i) {
+        for (auto const& bi : lists[i]) {
+          set(masks[i], bi.pos_);
+        }
+      }
+    };
+    compileMustFail(all_must_fail_, must_fail_);
+    compileMustFail(all_must_fail_noex_, must_fail_noex_);
+  } // EventSelector::Selection::compile
+
   bool EventSelector::acceptEvent(TriggerResults const& tr)
   {
-    if (accept_all_) return true;
+    if (sel_.accept_all_) return true;
 
     // For the current process we already initialized in the constructor,
     // The trigger names will not change so we can skip initialization.
@@ -289,29 +354,45 @@ namespace art {
       // then the names have not changed and we can skip this initialization.
       if (!(psetID_initialized_ && psetID_ == tr.parameterSetID())) {
 
-        Strings triggernames;
-        ServiceHandle<TriggerNamesService> tns;
-        if (tns->getTrigPaths(tr, triggernames)) {
-          init(paths_, triggernames);
-          psetID_ = tr.parameterSetID();
-          psetID_initialized_ = true;
+        // Put the current selection aside, and take the one for these
+        // names if we have met them before.
+        if (psetID_initialized_) {
+          std::swap(sel_, selections_[psetID_]);
+        }
+        auto const cached = selections_.find(tr.parameterSetID());
+        if (cached != selections_.end()) {
+          std::swap(sel_, cached->second);
         }
-        // This should never happen
         else {
-          throw art::Exception(errors::Unknown)
-            << "EventSelector::acceptEvent cannot find the trigger names for\n"
-               "a process for which the configuration has requested that the\n"
-               "OutputModule use TriggerResults to select events from.  This should\n"
-               "be impossible, please send information to reproduce this problem to\n"
-               "the ART developers.\n";
+          Strings triggernames;
+          ServiceHandle<TriggerNamesService> tns;
+          if (!tns->getTrigPaths(tr, triggernames)) {
+            // This should never happen
+            throw art::Exception(errors::Unknown)
+              << "EventSelector::acceptEvent cannot find the trigger names for\n"
+                 "a process for which the configuration has requested that the\n"
+                 "OutputModule use TriggerResults to select events from.  This should\n"
+                 "be impossible, please send information to reproduce this problem to\n"
+                 "the ART developers.\n";
+          }
+          init(paths_, triggernames);
         }
+        psetID_ = tr.parameterSetID();
+        psetID_initialized_ = true;
       }
     }
 
     // Now make the decision, based on the supplied TriggerResults tr,
-    // which of course can be treated as an HLTGlobalStatus by inheritance
+    // packed in the layout of the compiled masks.
 
-    return selectionDecision(tr);
+    std::size_t const nWords = (tr.size() + 31) / 32;
+    packed_.assign(nWords, 0);
+    for (unsigned int i = 0, e = tr.size(); i != e; ++i) {
+      packed_[i / 32] |= std::uint64_t(tr[i].state()) << (2 * (i % 32));
+    }
+    return selectionDecision([this](std::size_t const k) {
+        return packed_[k];
+      }, nWords);
 
   } // acceptEvent(TriggerResults const& tr)
 
@@ -330,58 +411,79 @@ namespace art {
         << "will not work and ought to be impossible\n";
     }
 
-    if (accept_all_) return true;
-
-    // Form HLTGlobalStatus object to represent the array_of_trigger_results
-    HLTGlobalStatus tr(number_of_trigger_paths);
-    int byteIndex = 0;
-    int subIndex  = 0;
-    for (int pathIndex = 0; pathIndex < number_of_trigger_paths; ++pathIndex)
-    {
-      int state = array_of_trigger_results[byteIndex] >> (subIndex * 2);
-      state &= 0x3;
-      HLTPathStatus pathStatus(static_cast<hlt::HLTState>(state));
-      tr[pathIndex] = pathStatus;
-      ++subIndex;
-      if (subIndex == 4)
-      { ++byteIndex;
-        subIndex = 0;
+    if (sel_.accept_all_) return true;
+
+    // The array already holds the path states in the layout of the
+    // compiled masks: read it a word at a time.
+    std::size_t const nPaths = std::max(number_of_trigger_paths, 0);
+    std::size_t const nBytes = (nPaths + 3) / 4;
+    std::size_t const nWords = (nPaths + 31) / 32;
+    // Any bits past the last path are not states.
+    std::uint64_t const lastWordMask = (nPaths % 32 == 0) ?
+      ~std::uint64_t(0) :
+      (std::uint64_t(1) << (2 * (nPaths % 32))) - 1;
+    auto word = [=](std::size_t const k) {
+      std::uint64_t result = 0;
+      for (std::size_t b = 8 * k, e = std::min(nBytes, 8 * k + 8); b != e; ++b) {
+        result |= std::uint64_t(array_of_trigger_results[b]) << (8 * (b - 8 * k));
       }
-    }
+      return (k + 1 == nWords) ? (result & lastWordMask) : result;
+    };
 
-    // Now make the decision, based on the HLTGlobalStatus tr,
-    // which we have created from the supplied array of results
+    // Now make the decision, based on the supplied array of results
 
-    return selectionDecision(tr);
+    return selectionDecision(word, nWords);
 
   } // acceptEvent(array_of_trigger_results, number_of_trigger_paths)
 
+  template <typename WORD>
   bool
-  EventSelector::selectionDecision(HLTGlobalStatus const& tr) const
+  EventSelector::selectionDecision(WORD const& word,
+                                   std::size_t const nWords) const
   {
-    if (accept_all_) return true;
+    if (sel_.accept_all_) return true;
+
+    std::size_t const nMaskWords = sel_.pass_.size();
+    std::uint64_t accepted = 0;
+    std::uint64_t conditionallyAccepted = 0;
+    for (std::size_t k = 0; k != nMaskWords; ++k) {
+      std::uint64_t const w = (k < nWords) ? word(k) : 0;
+      std::uint64_t const p = passed(w);
+      std::uint64_t const f = failed(w);
+      accepted |= (p & sel_.pass_[k]) | (f & sel_.fail_[k]) |
+                  (excepted(w) & sel_.exception_[k]);
+      conditionallyAccepted |= (p & sel_.conditional_pass_[k]) |
+                               (f & sel_.conditional_fail_[k]);
+    }
+    if (accepted) return true;
 
     bool exceptionPresent = false;
     bool exceptionsLookedFor = false;
-
-    if (acceptOneBit(absolute_acceptors_, tr)) return true;
-    if (acceptOneBit(conditional_acceptors_, tr)) {
-      exceptionPresent = containsExceptions(tr);
+    auto containsExceptions = [&word, nWords]() {
+      for (std::size_t k = 0; k != nWords; ++k) {
+        if (excepted(word(k))) return true;
+      }
+      return false;
+    };
+    if (conditionallyAccepted) {
+      exceptionPresent = containsExceptions();
       if (!exceptionPresent) return true;
       exceptionsLookedFor = true;
     }
-    if (acceptOneBit(exception_acceptors_, tr, hlt::Exception)) return true;
 
-    for (vector<Bits>::const_iterator f =  all_must_fail_.begin();
-                                           f != all_must_fail_.end(); ++f)
-    {
-      if (acceptAllBits(*f, tr)) return true;
+    auto allFailed = [&word, nWords, nMaskWords](Mask const& m) {
+      for (std::size_t k = 0; k != nMaskWords; ++k) {
+        std::uint64_t const w = (k < nWords) ? word(k) : 0;
+        if ((failed(w) & m[k]) != m[k]) return false;
+      }
+      return true;
+    };
+    for (auto const& m : sel_.must_fail_) {
+      if (allFailed(m)) return true;
     }
-    for (vector<Bits>::const_iterator fn =  all_must_fail_noex_.begin();
-                                           fn != all_must_fail_noex_.end(); ++fn)
-    {
-      if (acceptAllBits(*fn, tr)) {
-        if (!exceptionsLookedFor) exceptionPresent = containsExceptions(tr);
+    for (auto const& m : sel_.must_fail_noex_) {
+      if (allFailed(m)) {
+        if (!exceptionsLookedFor) exceptionPresent = containsExceptions();
         return (!exceptionPresent);
       }
     }
@@ -402,42 +504,6 @@ namespace art {
             ((pathStatus.state()==hlt::Exception)));
   }
 
-  // Indicate if any bit in the trigger results matches the desired value
-  // at that position, based on the Bits array.  If s is Exception, this
-  // looks for a Exceptionmatch; otherwise, true-->Pass, false-->Fail.
-  bool
-  EventSelector::acceptOneBit(Bits const& b,
-                               HLTGlobalStatus const& tr,
-                               hlt::HLTState const& s) const
-  {
-    bool lookForException = (s == hlt::Exception);
-    Bits::const_iterator i(b.begin());
-    Bits::const_iterator e(b.end());
-    for(;i!=e;++i) {
-      hlt::HLTState bstate =
-          lookForException ? hlt::Exception
-                           : i->accept_state_ ? hlt::Pass
-                                              : hlt::Fail;
-      if (tr[i->pos_].state() == bstate) return true;
-    }
-    return false;
-  } // acceptOneBit
-
-  // Indicate if *every* bit in the trigger results matches the desired value
-  // at that position, based on the Bits array: true-->Pass, false-->Fail.
-  bool
-  EventSelector::acceptAllBits(Bits const& b,
-                                HLTGlobalStatus const& tr) const
-  {
-    Bits::const_iterator i(b.begin());
-    Bits::const_iterator e(b.end());
-    for(;i!=e;++i) {
-      hlt::HLTState bstate = i->accept_state_ ? hlt::Pass : hlt::Fail;
-      if (tr[i->pos_].state() != bstate) return false;
-    }
-    return true;
-  } // acceptAllBits
-
   /**
    * Applies a trigger selection mask to a specified trigger result object.
    * Within the trigger result object, each path status is left unchanged
@@ -458,7 +524,7 @@ namespace art {
   EventSelector::maskTriggerResults(TriggerResults const& inputResults)
   {
     // fetch and validate the total number of paths
-    unsigned int fullTriggerCount = nTriggerNames_;
+    unsigned int fullTriggerCount = sel_.nTriggerNames_;
     unsigned int N = fullTriggerCount;
     if (fullTriggerCount != inputResults.size())
     {
@@ -473,9 +539,9 @@ namespace art {
     HLTGlobalStatus mask(fullTriggerCount);
 
     // Deal with must_fail acceptors that would cause selection
-    for (unsigned int m = 0; m < this->all_must_fail_.size(); ++m) {
+    for (unsigned int m = 0; m < this->sel_.all_must_fail_.size(); ++m) {
       vector<bool>
-        f = expandDecisionList(this->all_must_fail_[m],false,N);
+        f = expandDecisionList(this->sel_.all_must_fail_[m],false,N);
       bool all_fail = true;
       for (unsigned int ipath = 0; ipath < N; ++ipath) {
         if  ((f[ipath]) && (inputResults [ipath].state() != hlt::Fail)) {
@@ -491,9 +557,9 @@ namespace art {
         }
       }
     }
-    for (unsigned int m = 0; m < this->all_must_fail_noex_.size(); ++m) {
+    for (unsigned int m = 0; m < this->sel_.all_must_fail_noex_.size(); ++m) {
       vector<bool>
-        f = expandDecisionList(this->all_must_fail_noex_[m],false,N);
+        f = expandDecisionList(this->sel_.all_must_fail_noex_[m],false,N);
       bool all_fail = true;
       for (unsigned int ipath = 0; ipath < N; ++ipath) {
         if ((f[ipath]) && (inputResults [ipath].state() != hlt::Fail)) {
@@ -512,15 +578,15 @@ namespace art {
 
     // Deal with normal acceptors that would cause selection
     vector<bool>
-      aPassAbs = expandDecisionList(this->absolute_acceptors_,true,N);
+      aPassAbs = expandDecisionList(this->sel_.absolute_acceptors_,true,N);
     vector<bool>
-      aPassCon = expandDecisionList(this->conditional_acceptors_,true,N);
+      aPassCon = expandDecisionList(this->sel_.conditional_acceptors_,true,N);
     vector<bool>
-      aFailAbs = expandDecisionList(this->absolute_acceptors_,false,N);
+      aFailAbs = expandDecisionList(this->sel_.absolute_acceptors_,false,N);
     vector<bool>
-      aFailCon = expandDecisionList(this->conditional_acceptors_,false,N);
+      aFailCon = expandDecisionList(this->sel_.conditional_acceptors_,false,N);
     vector<bool>
-      aExc = expandDecisionList(this->exception_acceptors_,true,N);
+      aExc = expandDecisionList(this->sel_.exception_acceptors_,true,N);
     for (unsigned int ipath = 0; ipath < N; ++ipath) {
       hlt::HLTState s = inputResults [ipath].state();
       if (((aPassAbs[ipath]) && (s == hlt::Pass))
@@ -578,15 +644,6 @@ namespace art {
     return selection;
   }
 
-  bool EventSelector::containsExceptions(HLTGlobalStatus const& tr) const
-  {
-    unsigned int e = tr.size();
-    for (unsigned int i = 0; i < e; ++i) {
-      if (tr[i].state() == hlt::Exception) return true;
-    }
-    return false;
-  }
-
   // The following routines are helpers for testSelectionOverlap
 
   bool
@@ -606,40 +663,40 @@ namespace art {
                            unsigned int N)
   {
         // create the expanded masks for the various decision lists in a and b
-    if (!identical(expandDecisionList(a.absolute_acceptors_,true,N),
-                   expandDecisionList(b.absolute_acceptors_,true,N)))
+    if (!identical(expandDecisionList(a.sel_.absolute_acceptors_,true,N),
+                   expandDecisionList(b.sel_.absolute_acceptors_,true,N)))
                    return false;
-    if (!identical(expandDecisionList(a.conditional_acceptors_,true,N),
-                   expandDecisionList(b.conditional_acceptors_,true,N)))
+    if (!identical(expandDecisionList(a.sel_.conditional_acceptors_,true,N),
+                   expandDecisionList(b.sel_.conditional_acceptors_,true,N)))
                    return false;
-    if (!identical(expandDecisionList(a.absolute_acceptors_,false,N),
-                   expandDecisionList(b.absolute_acceptors_,false,N)))
+    if (!identical(expandDecisionList(a.sel_.absolute_acceptors_,false,N),
+                   expandDecisionList(b.sel_.absolute_acceptors_,false,N)))
                    return false;
-    if (!identical(expandDecisionList(a.conditional_acceptors_,false,N),
-                   expandDecisionList(b.conditional_acceptors_,false,N)))
+    if (!identical(expandDecisionList(a.sel_.conditional_acceptors_,false,N),
+                   expandDecisionList(b.sel_.conditional_acceptors_,false,N)))
                    return false;
-    if (!identical(expandDecisionList(a.exception_acceptors_,true,N),
-                   expandDecisionList(b.exception_acceptors_,true,N)))
+    if (!identical(expandDecisionList(a.sel_.exception_acceptors_,true,N),
+                   expandDecisionList(b.sel_.exception_acceptors_,true,N)))
                    return false;
-    if (a.all_must_fail_.size() != b.all_must_fail_.size()) return false;
+    if (a.sel_.all_must_fail_.size() != b.sel_.all_must_fail_.size()) return false;
 
     vector< vector<bool> > aMustFail;
-    for (unsigned int m = 0; m != a.all_must_fail_.size(); ++m) {
-      aMustFail.push_back(expandDecisionList(a.all_must_fail_[m],false,N));
+    for (unsigned int m = 0; m != a.sel_.all_must_fail_.size(); ++m) {
+      aMustFail.push_back(expandDecisionList(a.sel_.all_must_fail_[m],false,N));
     }
     vector< vector<bool> > aMustFailNoex;
-    for (unsigned int m = 0; m != a.all_must_fail_noex_.size(); ++m) {
+    for (unsigned int m = 0; m != a.sel_.all_must_fail_noex_.size(); ++m) {
       aMustFailNoex.push_back
-              (expandDecisionList(a.all_must_fail_noex_[m],false,N));
+              (expandDecisionList(a.sel_.all_must_fail_noex_[m],false,N));
     }
     vector< vector<bool> > bMustFail;
-    for (unsigned int m = 0; m != b.all_must_fail_.size(); ++m) {
-      bMustFail.push_back(expandDecisionList(b.all_must_fail_[m],false,N));
+    for (unsigned int m = 0; m != b.sel_.all_must_fail_.size(); ++m) {
+      bMustFail.push_back(expandDecisionList(b.sel_.all_must_fail_[m],false,N));
     }
     vector< vector<bool> > bMustFailNoex;
-    for (unsigned int m = 0; m != b.all_must_fail_noex_.size(); ++m) {
+    for (unsigned int m = 0; m != b.sel_.all_must_fail_noex_.size(); ++m) {
       bMustFailNoex.push_back
-              (expandDecisionList(b.all_must_fail_noex_[m],false,N));
+              (expandDecisionList(b.sel_.all_must_fail_noex_[m],false,N));
     }
 
     for (unsigned int m = 0; m != aMustFail.size(); ++m) {
@@ -5,6 +5,11 @@
 //
 // EventSelector
 //
+// The selection is compiled to bit masks over the packed path states,
+// so that deciding on an event takes a few word-wide operations per 32
+// paths.  A selector for the results of an earlier process keeps one
+// compiled selection per trigger-names ParameterSetID it meets.
+//
 // ======================================================================
 
 #include "art/Persistency/Common/HLTPathStatus.h"
@@ -12,6 +17,8 @@
 #include "cpp0x/memory"
 #include "fhiclcpp/ParameterSet.h"
 #include "fhiclcpp/ParameterSetID.h"
+#include <cstdint>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -44,7 +51,7 @@ namespace art {
     EventSelector(fhicl::ParameterSet const& pset,
                   Strings const& triggernames);
 
-    bool wantAll() const { return accept_all_; }
+    bool wantAll() const { return sel_.accept_all_; }
     bool acceptEvent(TriggerResults const&);
     bool acceptEvent(unsigned char const*, int) const;
 
@@ -69,33 +76,59 @@ namespace art {
 
     typedef std::vector<BitInfo> Bits;
 
-    bool accept_all_;
-    Bits absolute_acceptors_;
-    Bits conditional_acceptors_;
-    Bits exception_acceptors_;
-    std::vector<Bits> all_must_fail_;
-    std::vector<Bits> all_must_fail_noex_;
+    // Path states are evaluated packed two bits per path, 32 paths to
+    // a word, in the layout of the byte arrays taken by acceptEvent().
+    // A mask has the low bit of the field of each path it covers set.
+    typedef std::vector<std::uint64_t> Mask;
+
+    // Everything that depends on the trigger names.
+    struct Selection
+    {
+      Selection();
+
+      bool accept_all_;
+      Bits absolute_acceptors_;
+      Bits conditional_acceptors_;
+      Bits exception_acceptors_;
+      std::vector<Bits> all_must_fail_;
+      std::vector<Bits> all_must_fail_noex_;
+      int nTriggerNames_;
+
+      // The acceptors above, compiled by compile().
+      Mask pass_;
+      Mask fail_;
+      Mask exception_;
+      Mask conditional_pass_;
+      Mask conditional_fail_;
+      std::vector<Mask> must_fail_;
+      std::vector<Mask> must_fail_noex_;
+
+      void compile();
+    };
+
+    Selection sel_;
 
     bool results_from_current_process_;
     bool psetID_initialized_;
     fhicl::ParameterSetID psetID_;
 
+    // The selections for the trigger names of the other ParameterSetIDs
+    // met, so that going back to one does not mean matching the path
+    // specifications against the names again.
+    std::map<fhicl::ParameterSetID, Selection> selections_;
+
+    // The states of the last TriggerResults, packed.
+    Mask packed_;
+
     Strings paths_;
 
-    int nTriggerNames_;
     bool notStarPresent_;
 
     bool acceptTriggerPath(HLTPathStatus const&, BitInfo const&) const;
 
-    bool acceptOneBit (Bits const & b,
-                       HLTGlobalStatus const & tr,
-                       hlt::HLTState const & s = hlt::Ready) const;
-    bool acceptAllBits (Bits const & b,
-                        HLTGlobalStatus const & tr) const;
-
-    bool containsExceptions(HLTGlobalStatus const & tr) const;
-
-    bool selectionDecision(HLTGlobalStatus const & tr) const;
+    // word(k) returns the kth word of packed states, for k < nWords.
+    template <typename WORD>
+    bool selectionDecision(WORD const& word, std::size_t nWords) const;
 
     static std::vector< Strings::const_iterator >
       matching_triggers(Strings const& trigs, std::string const& s);
@@ -31,7 +31,8 @@ namespace art {
       runMetaTree_(0),
       fastCopyable_(false),
       fileName_(),
-      branchChildren_(new BranchChildren)
+      branchChildren_(new BranchChildren),
+      openLatency_(0.0)
     {}
 
     FileBlock(FileFormatVersion const& version,
@@ -45,7 +46,8 @@ namespace art {
       runMetaTree_(0),
       fastCopyable_(false),
       fileName_(fileName),
-      branchChildren_(new BranchChildren)
+      branchChildren_(new BranchChildren),
+      openLatency_(0.0)
     {}
 
     FileBlock(FileFormatVersion const& version,
@@ -54,7 +56,8 @@ namespace art {
               TTree const* run, TTree const* runMeta,
               bool fastCopy,
               std::string const& fileName,
-              std::shared_ptr<BranchChildren> branchChildren) :
+              std::shared_ptr<BranchChildren> branchChildren,
+              double openLatency = 0.0) :
       fileFormatVersion_(version),
       tree_(const_cast<TTree *>(ev)),
       metaTree_(const_cast<TTree *>(meta)),
@@ -64,7 +67,8 @@ namespace art {
       runMetaTree_(const_cast<TTree *>(runMeta)),
       fastCopyable_(fastCopy),
       fileName_(fileName),
-      branchChildren_(branchChildren) {}
+      branchChildren_(branchChildren),
+      openLatency_(openLatency) {}
 
     // use compiler-generated copy c'tor, copy assignment, and d'tor
 
@@ -81,6 +85,8 @@ namespace art {
 
     void setNotFastCopyable() {fastCopyable_ = false;}
     BranchChildren const& branchChildren() const { return *branchChildren_; }
+    // Real time in seconds taken by the source to open the file.
+    double openLatency() const { return openLatency_; }
 
   private:
     FileFormatVersion fileFormatVersion_;
@@ -94,6 +100,7 @@ namespace art {
     bool fastCopyable_;
     std::string fileName_;
     std::shared_ptr<BranchChildren> branchChildren_;
+    double openLatency_;
   };
 }
 #endif /* art_Framework_Core_FileBlock_h */
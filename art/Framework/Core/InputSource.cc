@@ -1,5 +1,7 @@
 #include "art/Framework/Core/InputSource.h"
 
+#include "art/Framework/Principal/EventPrincipal.h"
+
 art::InputSource::~InputSource() { }
 
 std::unique_ptr<art::EventPrincipal>
@@ -29,6 +31,12 @@ art::InputSource::rewind()
     << "to use an input source that supports random access (e.g. RootInput)\n";
 }
 
+void
+art::InputSource::recycleEvent(std::unique_ptr<EventPrincipal>&& ep)
+{
+  ep.reset();
+}
+
 void
 art::InputSource::doBeginJob()
 { }
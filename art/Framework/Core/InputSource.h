@@ -77,6 +77,11 @@ namespace art
     virtual std::shared_ptr<SubRunPrincipal> readSubRun(std::shared_ptr<RunPrincipal> rp) = 0;
     virtual std::unique_ptr<EventPrincipal> readEvent(std::shared_ptr<SubRunPrincipal> srp) = 0;
 
+    // Give back an EventPrincipal from readEvent() that is no longer
+    // needed, which the source may reuse for an event it reads later.
+    // The default implementation destroys it.
+    virtual void recycleEvent(std::unique_ptr<EventPrincipal>&& ep);
+
     // Temporary workaround for broken design.
     virtual void storeMPRforBrokenRandomAccess(MasterProductRegistry&);
   };
@@ -20,8 +20,12 @@
 
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 
+thread_local mf::service::MessageLogger::EnabledState
+art::MFStatusUpdater::savedEnabledState_;
+
 art::MFStatusUpdater::MFStatusUpdater(ActivityRegistry &areg) :
   areg_(areg),
+  mutex_(),
   programStatus_(),
   workFlowStatus_(),
   md_(*mf::MessageDrop::instance()),
@@ -79,28 +83,43 @@ art::MFStatusUpdater::MFStatusUpdater(ActivityRegistry &areg) :
   MFSU_WATCH_UPDATER(PostModuleEndSubRun);
 }
 
+std::string art::MFStatusUpdater::programStatus() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return programStatus_;
+}
+
+std::string art::MFStatusUpdater::workFlowSatus() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return workFlowStatus_;
+}
+
 void art::MFStatusUpdater::setContext(std::string const &ps) {
+  std::lock_guard<std::mutex> lock(mutex_);
   programStatus_ = ps;
   savedEnabledState_ = mls_.setContext(ps);
 }
 
 void art::MFStatusUpdater::setMinimalContext(std::string const &ps) {
+  std::lock_guard<std::mutex> lock(mutex_);
   programStatus_ = ps;
   mls_.setMinimalContext(ps);
 }
 
 void art::MFStatusUpdater::setContext(art::ModuleDescription const &desc) {
+  std::lock_guard<std::mutex> lock(mutex_);
   programStatus_ = moduleIDString(desc);
   savedEnabledState_ = mls_.setContext(programStatus_, desc.moduleLabel());
 }
 
 void art::MFStatusUpdater::setContext(art::ModuleDescription const &desc,
                                       std::string const &phase) {
+  std::lock_guard<std::mutex> lock(mutex_);
   programStatus_ = moduleIDString(desc, phase);
   savedEnabledState_ = mls_.setContext(programStatus_, desc.moduleLabel());
 }
 
 void art::MFStatusUpdater::restoreContext(art::ModuleDescription const &desc) {
+  std::lock_guard<std::mutex> lock(mutex_);
   programStatus_ = moduleIDString(desc);
   if (savedEnabledState_.isValid()) {
     mls_.setContext(programStatus_, savedEnabledState_);
@@ -114,6 +133,7 @@ void art::MFStatusUpdater::restoreContext(art::ModuleDescription const &desc) {
 
 void art::MFStatusUpdater::restoreContext(art::ModuleDescription const &desc,
                                           std::string const &phase) {
+  std::lock_guard<std::mutex> lock(mutex_);
   programStatus_ = moduleIDString(desc, phase);
   if (savedEnabledState_.isValid()) {
     mls_.setContext(programStatus_, savedEnabledState_);
@@ -126,6 +146,7 @@ void art::MFStatusUpdater::restoreContext(art::ModuleDescription const &desc,
 }
 
 void art::MFStatusUpdater::restoreContext(std::string const &ps) {
+  std::lock_guard<std::mutex> lock(mutex_);
   programStatus_ = ps;
   if (savedEnabledState_.isValid()) {
     mls_.setContext(ps, savedEnabledState_);
@@ -138,6 +159,7 @@ void art::MFStatusUpdater::restoreContext(std::string const &ps) {
 }
 
 void art::MFStatusUpdater::setWorkFlowStatus(std::string wfs) {
+  std::lock_guard<std::mutex> lock(mutex_);
   workFlowStatus_ = wfs;
   md_.runEvent = wfs;
 }
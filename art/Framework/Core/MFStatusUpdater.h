@@ -5,6 +5,7 @@
 #include "messagefacility/MessageLogger/MessageDrop.h"
 #include "messagefacility/MessageService/MessageLogger.h"
 
+#include <mutex>
 #include <string>
 
 #define MFSU_0_ARG_UPDATER_DECL(stateTag)                   \
@@ -36,6 +37,13 @@ namespace art {
   class MFStatusUpdater;
 }
 
+// Module and path signals may arrive from several threads at once
+// (concurrent trigger paths, multiple schedules, parallel output).
+// The status strings and the message logger context are therefore
+// updated under a lock, and the enabled state saved by a Pre signal
+// for its Post signal is kept per thread: both signals of a module or
+// path invocation are emitted on the same thread.
+
 class art::MFStatusUpdater {
 public:
   MFStatusUpdater(MFStatusUpdater const&) = delete;
@@ -43,9 +51,10 @@ public:
 
   MFStatusUpdater(ActivityRegistry &areg);
 
-  // Public interface to get state information.
-  std::string const &programStatus() const { return programStatus_; }
-  std::string const &workFlowSatus() const { return workFlowStatus_; }
+  // Public interface to get state information: the status last set,
+  // by any thread.
+  std::string programStatus() const;
+  std::string workFlowSatus() const;
 
 private:
   MFSU_0_ARG_UPDATER_DECL(PostBeginJob);
@@ -115,12 +124,13 @@ private:
 
   ActivityRegistry &areg_;
 
+  mutable std::mutex mutex_;
   std::string programStatus_;
   std::string workFlowStatus_;
 
   mf::MessageDrop& md_;
   mf::service::MessageLogger& mls_;
-  mf::service::MessageLogger::EnabledState savedEnabledState_;
+  static thread_local mf::service::MessageLogger::EnabledState savedEnabledState_;
 };
 
 #undef MFSU_0_ARG_UPDATER_DECL
@@ -22,11 +22,21 @@
 #include "cpp0x/utility"
 #include "rapidjson/document.h"
 #include "rapidjson/error/en.h"
+#include <mutex>
 
 using fhicl::ParameterSet;
 using std::vector;
 using std::string;
 
+namespace {
+  std::mutex &
+  catalogMutex()
+  {
+    static std::mutex m;
+    return m;
+  }
+}
+
 
 art::OutputModule::
 OutputModule(ParameterSet const & pset)
@@ -164,9 +174,14 @@ doEvent(EventPrincipal const & ep,
     trRef(trHandle.isValid() ?
           static_cast<HLTGlobalStatus>(*trHandle) :
           HLTGlobalStatus());
-    ci_->eventSelected(moduleDescription_.moduleLabel(),
-                       ep.id(),
-                       trRef);
+    {
+      // The catalog interface is shared by all output modules, which
+      // may be run concurrently.
+      std::lock_guard<std::mutex> lock(catalogMutex());
+      ci_->eventSelected(moduleDescription_.moduleLabel(),
+                         ep.id(),
+                         trRef);
+    }
     // ... and invoke the plugins:
     cet::for_all(plugins_, [&e](auto& p){ p->doCollectMetadata(e); });
     // Finish.
@@ -329,6 +344,7 @@ void
 art::OutputModule::
 updateBranchParents(EventPrincipal const & ep)
 {
+  auto const groupsLock = ep.lockGroups();
   for (EventPrincipal::const_iterator i = ep.begin(), iEnd = ep.end(); i != iEnd;
        ++i) {
     if (i->second->productProvenancePtr()) {
@@ -1,5 +1,8 @@
 #include "art/Framework/Core/Path.h"
 
+#include "art/Framework/Core/EDProducer.h"
+#include "art/Framework/Core/OutputWorker.h"
+#include "art/Framework/Core/WorkerT.h"
 #include "art/Framework/Principal/Actions.h"
 #include "cetlib/container_algorithms.h"
 #include <algorithm>
@@ -31,8 +34,67 @@ namespace art {
     actReg_(areg),
     act_table_(&actions),
     workers_(std::move(workers)),
-    isEndPath_(isEndPath)
+    isEndPath_(isEndPath),
+    isOutput_(),
+    parallelOutput_(false),
+    producerRuns_()
   {
+    isOutput_.reserve(workers_.size());
+    for (auto const& wip : workers_) {
+      isOutput_.push_back(dynamic_cast<OutputWorker const*>(wip.getWorker()) != nullptr);
+    }
+  }
+
+  // Number of consecutive output workers starting at idx.
+  Path::size_type
+  Path::outputRunLength(size_type idx) const {
+    size_type n = 0;
+    while ((idx + n) < isOutput_.size() && isOutput_[idx + n]) {
+      ++n;
+    }
+    return n;
+  }
+
+  // Greedily group adjacent producers into runs of mutually
+  // independent modules. Filters are left out: a filter which rejects
+  // the event must stop the modules after it from running. A producer
+  // which declared nothing of what it consumes may depend on any
+  // other, so runs alone.
+  void
+  Path::setConcurrentProducers(detail::ModuleGraph const& graph) {
+    producerRuns_.assign(workers_.size(), 0);
+    auto isProducer = [this](size_type i) {
+      return dynamic_cast<WorkerT<EDProducer> const*>(workers_[i].getWorker()) != nullptr;
+    };
+    size_type idx = 0;
+    while (idx < workers_.size()) {
+      size_type n = 0;
+      while (idx + n < workers_.size() && isProducer(idx + n)) {
+        auto const& label = workers_[idx + n].label();
+        if (!graph.declared(label)) {
+          break;
+        }
+        bool independent = true;
+        for (size_type j = idx; j != idx + n && independent; ++j) {
+          independent = !graph.dependsOn(label, workers_[j].label()) &&
+                        !graph.dependsOn(workers_[j].label(), label);
+        }
+        if (!independent) {
+          break;
+        }
+        ++n;
+      }
+      producerRuns_[idx] = n;
+      idx += std::max(n, size_type(1));
+    }
+  }
+
+  Path::size_type
+  Path::concurrentRunLength(size_type idx) const {
+    if (parallelOutput_) {
+      return outputRunLength(idx);
+    }
+    return producerRuns_.empty() ? 0 : producerRuns_[idx];
   }
 
   bool
@@ -14,11 +14,15 @@
 #include "art/Framework/Principal/RunStopwatch.h"
 #include "art/Framework/Principal/Worker.h"
 #include "art/Framework/Core/WorkerInPath.h"
+#include "art/Framework/Core/detail/ModuleGraph.h"
+#include "art/Framework/Core/detail/ScheduleTask.h"
 #include "art/Persistency/Common/HLTenums.h"
 #include "art/Persistency/Common/TriggerResults.h"
 #include "cpp0x/memory"
 #include "cpp0x/utility"
 #include "fhiclcpp/ParameterSet.h"
+#include "tbb/task_group.h"
+#include <exception>
 #include <string>
 #include <vector>
 
@@ -48,6 +52,16 @@ public:
   template <typename T>
   void processOneOccurrence(typename T::MyPrincipal&);
 
+  // Run adjacent output modules of this path concurrently when
+  // processing events. Their module signals (sPreModule, sPostModule)
+  // are then emitted from several threads at once, and the services
+  // watching them must be safe to call concurrently.
+  void setParallelOutput(bool parallel) { parallelOutput_ = parallel; }
+
+  // Run adjacent producers of this path concurrently when processing
+  // events, if none of them depends on another according to the graph.
+  void setConcurrentProducers(detail::ModuleGraph const& graph);
+
   int bitPosition() const { return bitpos_; }
   std::string const& name() const { return name_; }
 
@@ -100,12 +114,26 @@ private:
 
   bool isEndPath_;
 
+  // Whether each worker is an output worker.
+  std::vector<unsigned char> isOutput_;
+  bool parallelOutput_;
+  // The number of producers to be run concurrently starting at each
+  // worker, if more than one; empty unless concurrent producers are
+  // configured.
+  std::vector<size_type> producerRuns_;
+
   // Helper functions
   // nwrwue = numWorkersRunWithoutUnhandledException (really!)
   bool handleWorkerFailure(cet::exception const& e, int nwrwue, bool isEvent);
   void recordUnknownException(int nwrwue, bool isEvent);
   void recordStatus(int nwrwue, bool isEvent);
   void updateCounters(bool succeed, bool isEvent);
+  size_type outputRunLength(size_type idx) const;
+  size_type concurrentRunLength(size_type idx) const;
+  template <typename T>
+  bool runWorkersConcurrently(typename T::MyPrincipal&,
+                              CurrentProcessingContext const&,
+                              size_type idx, size_type n, int& nwrwue);
 };
 
 namespace art {
@@ -136,6 +164,10 @@ namespace art {
 template <typename T>
 void art::Path::processOneOccurrence(typename T::MyPrincipal& ep)
 {
+  // Make this path current for the services watching its signals
+  // and those of its modules.
+  detail::ScheduleScope scope(detail::ScheduleScope::scheduleID(), &name_);
+
   //Create the PathSignalSentry before the RunStopwatch so that
   // we only record the time spent in the path not from the signal
   int nwrwue = -1;
@@ -159,6 +191,15 @@ void art::Path::processOneOccurrence(typename T::MyPrincipal& ep)
   for (WorkersInPath::iterator i = workers_.begin(), end = workers_.end();
        i != end && should_continue;
        ++i, ++idx) {
+    if (T::isEvent_) {
+      auto const n = concurrentRunLength(idx);
+      if (n > 1) {
+        should_continue = runWorkersConcurrently<T>(ep, cpc, idx, n, nwrwue);
+        i += n - 1;
+        idx += n - 1;
+        continue;
+      }
+    }
     ++nwrwue;
     assert (static_cast<int>(idx) == nwrwue);
     try {
@@ -178,6 +219,57 @@ void art::Path::processOneOccurrence(typename T::MyPrincipal& ep)
   recordStatus(nwrwue, T::isEvent_);
 }
 
+// Run the n workers starting at idx as concurrent tasks, each with its
+// own copy of the processing context. Once all have finished, their
+// results and any exceptions are dealt with in path order, as though
+// they had been run one after the other.
+template <typename T>
+bool art::Path::runWorkersConcurrently(typename T::MyPrincipal& ep,
+                                       CurrentProcessingContext const& cpc,
+                                       size_type idx, size_type n, int& nwrwue)
+{
+  std::vector<CurrentProcessingContext> cpcs(n, cpc);
+  std::vector<unsigned char> results(n, true);
+  std::vector<std::exception_ptr> errors(n);
+  auto const sid = detail::ScheduleScope::scheduleID();
+  tbb::task_group group;
+  for (size_type j = 0; j != n; ++j) {
+    group.run([this, &ep, &cpcs, &results, &errors, sid, idx, j]() {
+        detail::ScheduleScope scope(sid, &name_);
+        auto& wip = workers_[idx + j];
+        try {
+          cpcs[j].activate(idx + j, wip.getWorker()->descPtr());
+          results[j] = wip.runWorker<T>(ep, &cpcs[j]);
+        }
+        catch (...) {
+          errors[j] = std::current_exception();
+        }
+      });
+  }
+  group.wait();
+  bool should_continue = true;
+  for (size_type j = 0; j != n && should_continue; ++j) {
+    ++nwrwue;
+    assert (static_cast<int>(idx + j) == nwrwue);
+    if (!errors[j]) {
+      should_continue = results[j];
+      continue;
+    }
+    try {
+      std::rethrow_exception(errors[j]);
+    }
+    catch(cet::exception& e) {
+      // handleWorkerFailure may throw a new exception.
+      should_continue = handleWorkerFailure(e, nwrwue, T::isEvent_);
+    }
+    catch(...) {
+      recordUnknownException(nwrwue, T::isEvent_);
+      throw;
+    }
+  }
+  return should_continue;
+}
+
 // ======================================================================
 
 #endif /* art_Framework_Core_Path_h */
@@ -9,6 +9,7 @@
 using fhicl::ParameterSet;
 
 
+#include <fstream>
 #include <map>
 #include <set>
 #include <sstream>
@@ -89,6 +90,16 @@ PathManager(ParameterSet const & procPS,
   areg_(areg),
   allowUnscheduled_(procPS_.get<bool>("services.scheduler.allowUnscheduled",
                                       false)),
+  nSchedules_(procPS_.get<ScheduleID::size_type>("services.scheduler.num_schedules",
+                                                 1)),
+  parallelOutput_(procPS_.get<bool>("services.scheduler.parallelOutput",
+                                    false)),
+  concurrentTriggerPaths_(procPS_.get<bool>("services.scheduler.concurrentTriggerPaths",
+                                            false)),
+  concurrentProducers_(procPS_.get<bool>("services.scheduler.concurrentProducers",
+                                         false)),
+  dumpModuleGraph_(procPS_.get<std::string>("services.scheduler.dumpModuleGraph",
+                                            "")),
   trigger_paths_config_(findLegacyConfig(procPS_, "physics.trigger_paths")),
   end_paths_config_(findLegacyConfig(procPS_, "physics.end_paths")),
   fact_(),
@@ -97,7 +108,8 @@ PathManager(ParameterSet const & procPS,
   protoEndPathInfo_(),
   triggerPathNames_(processPathConfigs_()),
   endPathInfo_(),
-  triggerPathsInfo_()
+  triggerPathsInfo_(),
+  moduleGraph_()
 {
 }
 
@@ -109,11 +121,13 @@ endPathInfo()
       endPathInfo_.pathPtrs().empty()) {
     // Need to create path from proto information.
     endPathInfo_.pathPtrs().emplace_back
-      (fillWorkers_(0,
+      (fillWorkers_(ScheduleID::first(),
+                    0,
                     "end_path",
                     protoEndPathInfo_,
                     nullptr, // End path, no trigger results needed.
                     endPathInfo_.workers()));
+    endPathInfo_.pathPtrs().back()->setParallelOutput(parallelOutput_);
   }
   return endPathInfo_;
 }
@@ -134,7 +148,8 @@ triggerPathsInfo(ScheduleID sID)
       cet::for_all(protoTrigPathMap_,
                    [this, sID, it, &bitpos](typename decltype(protoTrigPathMap_)::value_type const & val)
                    {
-                     it->second.pathPtrs().emplace_back(fillWorkers_(bitpos,
+                     it->second.pathPtrs().emplace_back(fillWorkers_(sID,
+                                                                     bitpos,
                                                                      val.first,
                                                                      val.second,
                                                                      Path::TrigResPtr(&it->second.pathResults()),
@@ -157,7 +172,8 @@ onDemandWorkers()
   if (allowUnscheduled()) {
     for (auto const & val : allModules_) {
       if (is_modifier(val.second.moduleType())) {
-        result.push_back(makeWorker_(val.second,
+        result.push_back(makeWorker_(ScheduleID::first(),
+                                     val.second,
                                      triggerPathsInfo(ScheduleID::first()).workers()));
       }
     }
@@ -165,6 +181,100 @@ onDemandWorkers()
   return std::move(result);
 }
 
+art::detail::ModuleGraph const &
+art::PathManager::
+moduleGraph()
+{
+  if (moduleGraph_) {
+    return *moduleGraph_;
+  }
+  auto const & processName =
+    art::ServiceHandle<art::TriggerNamesService>()->getProcessName();
+  std::vector<detail::ModuleGraph::Module> modules;
+  std::map<std::string, std::size_t> index;
+  for (auto const & val : triggerPathsInfo(ScheduleID::first()).workers()) {
+    index[val.first] = modules.size();
+    modules.push_back({val.first,
+                       {},
+                       val.second->consumedProducts(),
+                       val.second->declaresConsumes()});
+  }
+  for (auto const & val : preg_.productList()) {
+    auto const & bd = val.second;
+    if (bd.branchType() != InEvent || bd.processName() != processName) {
+      continue;
+    }
+    auto const it = index.find(bd.moduleLabel());
+    if (it != index.cend()) {
+      modules[it->second].produced.push_back({bd.friendlyClassName(),
+                                              bd.productInstanceName()});
+    }
+  }
+  moduleGraph_.reset(new detail::ModuleGraph(modules, processName));
+  if (!moduleGraph_->unresolved().empty()) {
+    mf::LogWarning w("ModuleGraph");
+    w << "The following consumed products are made by no module of this process:\n";
+    for (auto const & desc : moduleGraph_->unresolved()) {
+      w << "  " << desc << "\n";
+    }
+  }
+  if (!dumpModuleGraph_.empty()) {
+    std::ofstream dot(dumpModuleGraph_);
+    if (!dot) {
+      throw Exception(errors::Configuration)
+        << "Unable to open "
+        << dumpModuleGraph_
+        << " to write the module graph (services.scheduler.dumpModuleGraph).\n";
+    }
+    moduleGraph_->writeDot(dot);
+    mf::LogInfo("ModuleGraph")
+      << "The data dependencies of "
+      << moduleGraph_->size()
+      << " modules have been written to "
+      << dumpModuleGraph_
+      << ".\n";
+  }
+  if (concurrentTriggerPaths_) {
+    checkPathOrder_(*moduleGraph_);
+  }
+  return *moduleGraph_;
+}
+
+// With concurrent trigger paths, a product is certain to be available
+// to a module only if it is made earlier on the same path.
+void
+art::PathManager::
+checkPathOrder_(detail::ModuleGraph const & graph) const
+{
+  std::ostringstream error_stream;
+  for (auto const & val : protoTrigPathMap_) {
+    std::set<std::string> earlier;
+    for (auto const & mipi : val.second) {
+      auto const & label = mipi.moduleConfigInfo().label();
+      for (auto const & dep : graph.directDependencies(label)) {
+        if (earlier.find(dep) == earlier.cend()) {
+          error_stream
+            << "  ERROR: Module "
+            << label
+            << " in path "
+            << val.first
+            << " consumes a product of module "
+            << dep
+            << ", which does not precede it in that path.\n";
+        }
+      }
+      earlier.insert(label);
+    }
+  }
+  auto error_messages = error_stream.str();
+  if (!error_messages.empty()) {
+    throw Exception(errors::Configuration)
+      << "The following were encountered while checking the module order "
+      << "for concurrent trigger paths:\n"
+      << error_messages;
+  }
+}
+
 
 art::detail::ModuleConfigInfoMap
 art::PathManager::
@@ -231,16 +341,32 @@ art::PathManager::
 processPathConfigs_()
 {
   vstring trigger_path_names;
-  auto services = procPS_.get<ParameterSet>("services",
-                                            ParameterSet());
-  auto opts(services.get<ParameterSet>("scheduler", ParameterSet()));
-  auto nSchedules = opts.get<size_t>("num_schedules", 1);
   // Check we're not being asked to do something we can't.
-  if (allowUnscheduled_ && nSchedules > 1) {
+  if (nSchedules_ < 1) {
+    throw Exception(errors::Configuration)
+        << "services.scheduler.num_schedules must be at least 1.\n";
+  }
+  if (allowUnscheduled_ && nSchedules_ > 1) {
     throw Exception(errors::UnimplementedFeature)
         << "Multi-schedule operation is not possible with on-demand "
         << "module execution.\n";
   }
+  // The random number service keeps a single engine, state snapshot
+  // and saved state for each module label; the clones of a module on
+  // other schedules would share them.
+  auto const services = procPS_.get<ParameterSet>("services", {});
+  if (nSchedules_ > 1 &&
+      (services.has_key("RandomNumberGenerator") ||
+       services.get<ParameterSet>("user", {}).has_key("RandomNumberGenerator"))) {
+    throw Exception(errors::UnimplementedFeature)
+        << "Multi-schedule operation is not possible with the "
+        << "RandomNumberGenerator service.\n";
+  }
+  if (allowUnscheduled_ && (concurrentTriggerPaths_ || concurrentProducers_)) {
+    throw Exception(errors::UnimplementedFeature)
+        << "Concurrent trigger paths or producers are not possible with "
+        << "on-demand module execution.\n";
+  }
   // Identify and process paths.
   std::set<std::string> known_pars {
     "analyzers",
@@ -426,17 +552,19 @@ processOnePathConfig_(std::string const & path_name,
 
 void
 art::PathManager::
-makeWorker_(detail::ModuleInPathInfo const & mipi,
+makeWorker_(ScheduleID sID,
+            detail::ModuleInPathInfo const & mipi,
             WorkerMap & workers,
             std::vector<WorkerInPath> & pathWorkers)
 {
-  auto w = makeWorker_(mipi.moduleConfigInfo(), workers);
+  auto w = makeWorker_(sID, mipi.moduleConfigInfo(), workers);
   pathWorkers.emplace_back(w, mipi.filterAction());
 }
 
 art::Worker *
 art::PathManager::
-makeWorker_(detail::ModuleConfigInfo const & mci,
+makeWorker_(ScheduleID sID,
+            detail::ModuleConfigInfo const & mci,
             WorkerMap & workers)
 {
   auto it = workers.find(mci.label());
@@ -446,7 +574,8 @@ makeWorker_(detail::ModuleConfigInfo const & mci,
                    moduleConfig,
                    preg_,
                    exceptActions_,
-                   art::ServiceHandle<art::TriggerNamesService>()->getProcessName());
+                   art::ServiceHandle<art::TriggerNamesService>()->getProcessName(),
+                   sID);
     ModuleDescription md(moduleConfig.id(),
                          p.pset_.get<std::string>("module_type"),
                          p.pset_.get<std::string>("module_label"),
@@ -461,6 +590,15 @@ makeWorker_(detail::ModuleConfigInfo const & mci,
          emplace(mci.label(),
                  std::move(worker)).first;
     it->second->setActivityRegistry(&areg_);
+    // Modules which are not thread-safe may opt in to having all their
+    // per-schedule clones executed one at a time.
+    if (nSchedules_ > 1 && moduleConfig.get<bool>("serialize", false)) {
+      auto & serializer = serializers_[mci.label()];
+      if (!serializer) {
+        serializer = std::make_shared<std::mutex>();
+      }
+      it->second->setSerializer(serializer);
+    }
   }
   return it->second.get();
 }
@@ -468,7 +606,8 @@ makeWorker_(detail::ModuleConfigInfo const & mci,
 // Precondition: !modInfos.empty();
 std::unique_ptr<art::Path>
 art::PathManager::
-fillWorkers_(int bitpos,
+fillWorkers_(ScheduleID sID,
+             int bitpos,
              std::string const & pathName,
              ModInfos const & modInfos,
              Path::TrigResPtr pathResults,
@@ -477,7 +616,7 @@ fillWorkers_(int bitpos,
   assert(!modInfos.empty());
   std::vector<WorkerInPath> pathWorkers;
   for (auto const & mci : modInfos) {
-    makeWorker_(mci, workers, pathWorkers);
+    makeWorker_(sID, mci, workers, pathWorkers);
   }
   return std::unique_ptr<art::Path>
     (new art::Path(bitpos,
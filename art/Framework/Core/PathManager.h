@@ -16,6 +16,7 @@
 #include "art/Framework/Core/PathsInfo.h"
 #include "art/Framework/Core/detail/ModuleConfigInfo.h"
 #include "art/Framework/Core/detail/ModuleFactory.h"
+#include "art/Framework/Core/detail/ModuleGraph.h"
 #include "art/Framework/Core/detail/ModuleInPathInfo.h"
 #include "art/Framework/Principal/Actions.h"
 #include "art/Framework/Services/Registry/ActivityRegistry.h"
@@ -25,7 +26,9 @@
 #include "fhiclcpp/ParameterSet.h"
 
 #include <iosfwd>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -51,11 +54,29 @@ public:
 
   bool allowUnscheduled() const;
 
+  // Number of independent schedules (services.scheduler.num_schedules).
+  ScheduleID::size_type numSchedules() const;
+
+  // Whether the trigger paths of an event are run concurrently
+  // (services.scheduler.concurrentTriggerPaths).
+  bool concurrentTriggerPaths() const;
+
+  // Whether adjacent producers with no data dependency between them
+  // are run concurrently (services.scheduler.concurrentProducers).
+  bool concurrentProducers() const;
+
   // These methods may trigger module construction.
   PathsInfo & endPathInfo();
   PathsInfo & triggerPathsInfo(ScheduleID sID);
   Workers onDemandWorkers();
 
+  // The data dependencies among the modules of the first schedule's
+  // trigger paths, and any on-demand modules. Built and checked on
+  // the first call, which must follow the construction of those
+  // modules; if services.scheduler.dumpModuleGraph names a file, the
+  // graph is written there in DOT format.
+  detail::ModuleGraph const & moduleGraph();
+
   void resetAll(); // Reset trigger results ready for next event.
 
 private:
@@ -69,13 +90,17 @@ private:
                              vstring & trigger_path_names,
                              std::ostream & error_stream);
   void
-  makeWorker_(detail::ModuleInPathInfo const & mipi,
+  makeWorker_(ScheduleID sID,
+              detail::ModuleInPathInfo const & mipi,
               WorkerMap & workers,
               std::vector<WorkerInPath> & pathWorkers);
   Worker *
-  makeWorker_(detail::ModuleConfigInfo const & mci,
+  makeWorker_(ScheduleID sID,
+              detail::ModuleConfigInfo const & mci,
               WorkerMap & workers);
-  std::unique_ptr<Path> fillWorkers_(int bitpos,
+  void checkPathOrder_(detail::ModuleGraph const & graph) const;
+  std::unique_ptr<Path> fillWorkers_(ScheduleID sID,
+                                     int bitpos,
                                      std::string const & pathName,
                                      ModInfos const & modInfos,
                                      Path::TrigResPtr pathResults,
@@ -88,6 +113,11 @@ private:
 
   // Cached parameters.
   bool const allowUnscheduled_;
+  ScheduleID::size_type const nSchedules_;
+  bool const parallelOutput_;
+  bool const concurrentTriggerPaths_;
+  bool const concurrentProducers_;
+  std::string const dumpModuleGraph_;
   // Backwards compatibility cached parameters.
   std::unique_ptr<std::set<std::string> > trigger_paths_config_;
   std::unique_ptr<std::set<std::string> > end_paths_config_;
@@ -99,6 +129,9 @@ private:
   vstring triggerPathNames_;
   PathsInfo endPathInfo_;
   std::map<ScheduleID, PathsInfo> triggerPathsInfo_; // Per-schedule.
+  std::unique_ptr<detail::ModuleGraph> moduleGraph_;
+  // Shared by all clones of a module configured with "serialize: true".
+  std::map<std::string, std::shared_ptr<std::mutex> > serializers_;
 };
 
 inline
@@ -115,6 +148,27 @@ allowUnscheduled() const
 {
   return allowUnscheduled_;
 }
+inline
+art::ScheduleID::size_type
+art::PathManager::
+numSchedules() const
+{
+  return nSchedules_;
+}
+inline
+bool
+art::PathManager::
+concurrentTriggerPaths() const
+{
+  return concurrentTriggerPaths_;
+}
+inline
+bool
+art::PathManager::
+concurrentProducers() const
+{
+  return concurrentProducers_;
+}
 #endif /* art_Framework_Core_PathManager_h */
 
 // Local Variables:
@@ -10,6 +10,8 @@ EDProducts into an Event.
 
 #include "art/Framework/Principal/fwd.h"
 #include "art/Framework/Core/ProductRegistryHelper.h"
+#include "art/Framework/Principal/ConsumedProduct.h"
+#include "art/Framework/Principal/ProductToken.h"
 #include "art/Framework/Core/get_BranchDescription.h"
 #include "art/Persistency/Provenance/ModuleDescription.h"
 #include "art/Persistency/Provenance/ProductID.h"
@@ -31,12 +33,39 @@ namespace art {
 
     bool modifiesEvent() const { return true; }
 
+    // Declare, in the module constructor, that the module reads the
+    // event product of type PROD with the given tag; the returned
+    // token may be used to get it. The declarations order modules by
+    // their data dependencies (see detail/ModuleGraph.h).
+    template <typename PROD>
+    ProductToken<PROD> consumes(InputTag const& tag);
+
+    // Declare, in the module constructor, that the module reads no
+    // event products. A module which calls neither this nor consumes()
+    // is assumed to read anything.
+    void consumesNothing() { declaresConsumes_ = true; }
+
+    ConsumedProducts const& consumedProducts() const { return consumed_; }
+    bool declaresConsumes() const { return declaresConsumes_; }
+
     template <typename PROD, BranchType B, typename TRANS>
     ProductID getProductID(TRANS const &translator,
                            ModuleDescription const &moduleDescription,
                            std::string const& instanceName) const;
+
+  private:
+    ConsumedProducts consumed_;
+    bool declaresConsumes_ {false};
   };
 
+  template <typename PROD>
+  ProductToken<PROD>
+  ProducerBase::consumes(InputTag const& tag) {
+    consumed_.push_back(ConsumedProduct { TypeID(typeid(PROD)), tag });
+    declaresConsumes_ = true;
+    return ProductToken<PROD>(tag);
+  }
+
   template <typename PROD, BranchType B, typename TRANS>
   ProductID
   ProducerBase::getProductID(TRANS const &translator,
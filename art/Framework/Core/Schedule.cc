@@ -42,10 +42,19 @@ Schedule(ScheduleID sID, PathManager& pm, ParameterSet const& proc_pset,
   , processName_(tns.getProcessName())
   , triggerPathsInfo_(pm.triggerPathsInfo(sID_))
   , pathsEnabled_(triggerPathsInfo_.pathPtrs().size(), true)
+  , concurrentPaths_(pm.concurrentTriggerPaths())
   , results_inserter_()
   , demand_branches_(catalogOnDemandBranches_(pm.onDemandWorkers(),
                                               mpr.productList()))
 {
+  // Checks the declared data dependencies of the modules, once they
+  // have all been constructed.
+  auto const & graph = pm.moduleGraph();
+  if (pm.concurrentProducers()) {
+    for (auto const & path : triggerPathsInfo_.pathPtrs()) {
+      path->setConcurrentProducers(graph);
+    }
+  }
   if (!triggerPathsInfo_.pathPtrs().empty()) {
     makeTriggerResultsInserter_(tns.getTriggerPSet(), mpr, areg);
   }
@@ -189,7 +198,7 @@ makeTriggerResultsInserter_(fhicl::ParameterSet const & trig_pset,
                             ActivityRegistry & areg)
 {
   WorkerParams work_args(process_pset_, trig_pset, mpr, *act_table_,
-                         processName_);
+                         processName_, sID_);
   ModuleDescription md(trig_pset.id(),
                        "TriggerResultInserter",
                        "TriggerResults",
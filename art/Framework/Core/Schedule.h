@@ -22,10 +22,34 @@
 // Paths. The scheduler performs the reset() on each of the workers
 // independent of the Path objects.
 //
+// With services.scheduler.concurrentTriggerPaths, the trigger paths of
+// an event are run as concurrent tasks. A module on several paths is
+// still run only once (see Worker), and each path records its own
+// bit, so the TriggerResults are those of serial execution. If paths
+// throw, the exception of the first such path in configuration order
+// is propagated, as it would have been had the paths been run in turn.
+//
+// The paths are not ordered with respect to one another, however. A
+// module reading a product made by a module that is only on another
+// path always finds it in serial execution if that path comes first,
+// and never if it comes later; with concurrent paths, whether it finds
+// the product depends on timing. Such configurations are not
+// detected: a producer whose product is read on a path should be on
+// that path, ahead of the reader. Module and path signals are emitted
+// from several threads at once, so services watching them must be
+// safe to call concurrently (MFStatusUpdater is).
+//
+// With services.scheduler.concurrentProducers, adjacent producers on a
+// trigger path which, according to the consumes() declarations of the
+// modules (see detail/ModuleGraph.h), do not depend on one another are
+// also run as concurrent tasks. A producer which declares neither
+// consumes() nor consumesNothing() is always run alone.
+//
 
 #include "art/Framework/Core/Frameworkfwd.h"
 #include "art/Framework/Core/Path.h"
 #include "art/Framework/Core/PathManager.h"
+#include "art/Framework/Core/detail/ScheduleTask.h"
 #include "art/Framework/Principal/Actions.h"
 #include "art/Framework/Principal/EventPrincipal.h"
 #include "art/Framework/Principal/OccurrenceTraits.h"
@@ -49,6 +73,8 @@
 #include "cpp0x/utility"
 #include "fhiclcpp/ParameterSet.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
+#include "tbb/task_group.h"
+#include <exception>
 #include <map>
 #include <set>
 #include <string>
@@ -104,6 +130,9 @@ private:
   template<typename T>
   bool runTriggerPaths_(typename T::MyPrincipal&);
 
+  template<typename T>
+  void runTriggerPathsConcurrently_(typename T::MyPrincipal&);
+
   template<class F> void doForAllWorkers_(F functor);
 
   template<class F> void doForAllEnabledPaths_(F functor);
@@ -115,6 +144,7 @@ private:
   std::string processName_;
   PathsInfo& triggerPathsInfo_;
   std::vector<unsigned char> pathsEnabled_;
+  bool const concurrentPaths_;
   std::shared_ptr<Worker> results_inserter_;
   OnDemandBranches demand_branches_;
 };
@@ -173,12 +203,46 @@ inline
 bool
 Schedule::runTriggerPaths_(typename T::MyPrincipal& ep)
 {
-  doForAllEnabledPaths_([&ep](auto p) {
-    p->processOneOccurrence<T>(ep);
-  });
+  if (T::isEvent_ && concurrentPaths_) {
+    runTriggerPathsConcurrently_<T>(ep);
+  }
+  else {
+    doForAllEnabledPaths_([&ep](auto p) {
+      p->processOneOccurrence<T>(ep);
+    });
+  }
   return triggerPathsInfo_.pathResults().accept();
 }
 
+template<typename T>
+void
+Schedule::runTriggerPathsConcurrently_(typename T::MyPrincipal& ep)
+{
+  std::vector<std::exception_ptr> errors;
+  errors.reserve(pathsEnabled_.size());
+  auto const sid = detail::ScheduleScope::scheduleID();
+  tbb::task_group group;
+  doForAllEnabledPaths_([&ep, &errors, &group, sid](auto p) {
+    errors.emplace_back();
+    auto& error = errors.back();
+    group.run([&ep, &error, sid, p]() {
+      detail::ScheduleScope scope(sid, nullptr);
+      try {
+        p->template processOneOccurrence<T>(ep);
+      }
+      catch (...) {
+        error = std::current_exception();
+      }
+    });
+  });
+  group.wait();
+  for (auto const& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
 template<class F>
 void
 Schedule::
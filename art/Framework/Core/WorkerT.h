@@ -35,6 +35,12 @@ namespace art {
 
     virtual bool modifiesEvent() const { return module_->modifiesEvent(); }
 
+    virtual ConsumedProducts const& consumedProducts() const {
+      return module_->consumedProducts(); }
+
+    virtual bool declaresConsumes() const {
+      return module_->declaresConsumes(); }
+
   template <typename ModType>
   static std::unique_ptr<T> makeModule(ModuleDescription const& md,
                                      fhicl::ParameterSet const& pset) {
@@ -79,7 +85,10 @@ namespace art {
     Worker(md, wp),
     module_(ed.release()) {
     module_->setModuleDescription(md);
-    module_->registerProducts(wp.reg_, md);
+    // Products are registered once, by the first schedule's clone.
+    if (wp.scheduleID_ == ScheduleID::first()) {
+      module_->registerProducts(wp.reg_, md);
+    }
   }
 
   template <typename T>
@@ -14,7 +14,6 @@
 #include "art/Utilities/pointersEqual.h"
 
 #include <type_traits>
-#include <unordered_map>
 
 namespace art {
   namespace detail {
@@ -56,6 +55,21 @@ namespace art {
       InputTag const & assnsTag_;
     };
 
+    // Call f(i, j) for each item i of aColl and each association j in
+    // assns of which it is the left item. The last argument says
+    // whether aColl is a collection of Ptrs, to be looked up by
+    // ProductID and key rather than by address.
+    template <typename ASSNS, typename Acoll, typename F>
+    void forEachAssociated(ASSNS const & assns,
+                           Acoll const & aColl,
+                           F f,
+                           std::true_type);
+    template <typename ASSNS, typename Acoll, typename F>
+    void forEachAssociated(ASSNS const & assns,
+                           Acoll const & aColl,
+                           F f,
+                           std::false_type);
+
     // Note that the template parameter Bcoll is determined by the
     // IPRHelper's use by the FindOne and FindMany classes, and is not
     // as free-ranging as one might naively imagine.
@@ -152,32 +166,20 @@ operator()(Acoll const & aColl, Bcoll & bColl) const
 ////////////////////////////////////////////////////////////////////////
 // Implementation notes.
 //
-// The current implementation does not verify the that ProductID of the
-// item in the association collection matches that of the item in the
-// reference collection before attempting to dereference its Ptr
-// (although it does verify ptr.isAvailable()). This means that in the
-// case where an association collection refers to multiple vailable
-// AProd collections, all of those collections will be read from file
-// even if the reference collection does not include items from one or
-// more of those AProd collections.
-//
-// If one were to provide an implementation that did this, one would
-// change the unordered_multimap to key on the full ptr instead of the
-// pointer. This would involve defining a hashing function, something
-// along the lines of:
+// The associations are found through the index kept by the Assns
+// product (see art/Persistency/Common/detail/AssnsIndex.h), which is
+// built on first use in each event and shared by all later queries on
+// the same Assns.
 //
-// auto hasher = [](typename Acoll::value_type::const_pointer const & ptr)
-//               { return std::hash((ptr.key() && 0xffffffff) +
-//                                  (ptr.id().productIndex() << 32) +
-//                                  (ptr.id().processIndex() << 48)); };
+// When the reference collection is a collection of Ptrs, the lookup is
+// by ProductID and key: the Ptrs in the association collection are
+// not dereferenced, so AProd collections not referred to by the
+// reference collection are not read, and an association matches only
+// if it refers to the same product as the reference item.
 //
-// However, it would be problematic to do the lookup if the reference
-// item was not in fact a Ptr. Maybe it would be relatively efficient if
-// one were able to do a lookup in the table against an entity not a Ptr
-// for which I could write a comparison function that compared the
-// ProductID and only if they matched, the pointer with suitable get().
-//
-// For now however, no-one has requested this,
+// Otherwise, the lookup is by the address of the reference item, and
+// the index is made by dereferencing every available left Ptr in the
+// association collection.
 ////////////////////////////////////////////////////////////////////////
 template <typename ProdA, typename ProdB, typename Data, typename DATACOLL>
 template <typename Acoll, typename Bcoll>
@@ -195,36 +197,59 @@ operator()(Acoll const & aColl, Bcoll & bColl, dataColl_t & dColl) const
   }
   bh.init(aColl.size(), bColl);
   dh.init(aColl.size(), dColl);
-  // Answer cache.
-  std::unordered_multimap<typename Ptr<ProdA>::const_pointer,
-    std::pair<Ptr<ProdB>, ptrdiff_t> > lookupCache;
-  ptrdiff_t counter { 0 };
-  for (auto const & apair : *assnsHandle) {
-    if (apair.first.isAvailable()) {
-      lookupCache.emplace(apair.first.get(),
-                          typename decltype(lookupCache)::mapped_type(apair.second, counter));
+  auto const & assns = *assnsHandle;
+  detail::forEachAssociated(assns, aColl,
+                            [&bh, &dh, &bColl, &dColl, &assns]
+                            (size_t bIndex, size_t assnsIndex)
+                            {
+                              bh.fill(bIndex, assns[assnsIndex].second, bColl);
+                              dh.fill(assnsIndex, assns, bIndex, dColl);
+                            },
+                            std::is_same<typename Acoll::value_type,
+                                         Ptr<ProdA> >());
+  return shared_exception_t();
+}
+
+template <typename ASSNS, typename Acoll, typename F>
+void
+art::detail::forEachAssociated(ASSNS const & assns,
+                               Acoll const & aColl,
+                               F f,
+                               std::true_type)
+{
+  auto const & index = assns.leftIndex().byPtr(assns);
+  size_t bIndex { 0 };
+  for (auto const & ptr : aColl) {
+    auto const found =
+      index.find(AssnsIndex::ptr_key_type(ptr.id(), ptr.key()));
+    for (auto i = found.first; i != found.second; ++i) {
+      f(bIndex, *i);
     }
-    ++counter;
+    ++bIndex;
   }
-  // Now use the cache.
+}
+
+template <typename ASSNS, typename Acoll, typename F>
+void
+art::detail::forEachAssociated(ASSNS const & assns,
+                               Acoll const & aColl,
+                               F f,
+                               std::false_type)
+{
+  typedef typename ASSNS::left_t ProdA;
+  auto const & index = assns.leftIndex().byAddress(assns);
   size_t bIndex { 0 };
   for (typename Acoll::const_iterator
-         i = aColl.begin(),
+         it = aColl.begin(),
          e = aColl.end();
-       i != e;
-       ++i, ++bIndex) {
-    auto foundItems = lookupCache.equal_range(ensurePointer<typename Ptr<ProdA>::const_pointer>(i));
-    if (foundItems.first != lookupCache.cend()) {
-      std::for_each(foundItems.first, foundItems.second,
-                    [&bh, &dh, &bColl, bIndex, &assnsHandle, &dColl]
-                    (typename decltype(lookupCache)::const_reference itemPair)
-                    {
-                      bh.fill(bIndex, itemPair.second.first, bColl);
-                      dh.fill(itemPair.second.second, *assnsHandle, bIndex, dColl);
-                    });
+       it != e;
+       ++it, ++bIndex) {
+    auto const found =
+      index.find(ensurePointer<typename Ptr<ProdA>::const_pointer>(it));
+    for (auto i = found.first; i != found.second; ++i) {
+      f(bIndex, *i);
     }
   }
-  return shared_exception_t();
 }
 
 template <typename DATA>
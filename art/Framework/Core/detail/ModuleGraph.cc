@@ -0,0 +1,221 @@
+#include "art/Framework/Core/detail/ModuleGraph.h"
+
+#include "art/Utilities/Exception.h"
+
+#include <algorithm>
+#include <functional>
+#include <ostream>
+#include <set>
+#include <utility>
+
+namespace {
+  std::string
+  productName(std::string const & friendlyClassName,
+              std::string const & instance)
+  {
+    return instance.empty() ?
+      friendlyClassName :
+      friendlyClassName + ':' + instance;
+  }
+}
+
+art::detail::ModuleGraph::
+ModuleGraph(std::vector<Module> const & modules,
+            std::string const & processName)
+  :
+  labels_(),
+  indices_(),
+  edges_(),
+  declared_(),
+  unresolved_(),
+  parents_(modules.size()),
+  ancestors_()
+{
+  labels_.reserve(modules.size());
+  for (auto const & mod : modules) {
+    if (!indices_.emplace(mod.label, labels_.size()).second) {
+      throw Exception(errors::LogicError)
+        << "ModuleGraph: module label "
+        << mod.label
+        << " was given more than once.\n";
+    }
+    labels_.push_back(mod.label);
+    declared_.push_back(mod.declared);
+  }
+  for (std::size_t consumer = 0; consumer != modules.size(); ++consumer) {
+    std::set<std::pair<std::size_t, std::string> > seen;
+    for (auto const & cp : modules[consumer].consumed) {
+      auto const & tag = cp.tag;
+      if (!tag.process().empty() && tag.process() != processName) {
+        continue;
+      }
+      auto const fcn = cp.type.friendlyClassName();
+      auto const producer = index_(tag.label());
+      if (producer == labels_.size()) {
+        if (!tag.process().empty()) {
+          unresolved_.push_back(labels_[consumer] + " consumes " +
+                                fcn + ':' + tag.encode());
+        }
+        continue;
+      }
+      auto const & produced = modules[producer].produced;
+      auto const made =
+        std::any_of(produced.cbegin(),
+                    produced.cend(),
+                    [&fcn, &tag](ProductName const & pn) {
+                      return pn.friendlyClassName == fcn &&
+                        pn.productInstanceName == tag.instance();
+                    });
+      if (!made) {
+        unresolved_.push_back(labels_[consumer] + " consumes " +
+                              fcn + ':' + tag.encode());
+        continue;
+      }
+      auto product = productName(fcn, tag.instance());
+      if (seen.emplace(producer, product).second) {
+        edges_.push_back(Edge { producer, consumer, std::move(product) });
+        parents_[consumer].push_back(producer);
+      }
+    }
+    auto & parents = parents_[consumer];
+    std::sort(parents.begin(), parents.end());
+    parents.erase(std::unique(parents.begin(), parents.end()), parents.end());
+  }
+  checkForCycles_();
+  fillAncestors_();
+}
+
+std::size_t
+art::detail::ModuleGraph::
+index_(std::string const & label) const
+{
+  auto const it = indices_.find(label);
+  return it == indices_.cend() ? labels_.size() : it->second;
+}
+
+std::vector<std::string>
+art::detail::ModuleGraph::
+directDependencies(std::string const & label) const
+{
+  std::vector<std::string> result;
+  auto const i = index_(label);
+  if (i == labels_.size()) {
+    return result;
+  }
+  for (auto const p : parents_[i]) {
+    result.push_back(labels_[p]);
+  }
+  return result;
+}
+
+bool
+art::detail::ModuleGraph::
+dependsOn(std::string const & consumer,
+          std::string const & producer) const
+{
+  auto const c = index_(consumer);
+  auto const p = index_(producer);
+  if (c == labels_.size() || p == labels_.size()) {
+    return false;
+  }
+  return ancestors_[c][p];
+}
+
+// Depth-first search over the dependencies; meeting a module whose
+// dependencies are still being visited closes a cycle.
+void
+art::detail::ModuleGraph::
+checkForCycles_() const
+{
+  enum class Mark { NEW, ACTIVE, DONE };
+  std::vector<Mark> marks(labels_.size(), Mark::NEW);
+  std::vector<std::size_t> stack;
+  std::function<void (std::size_t)> visit = [&](std::size_t const i) {
+    marks[i] = Mark::ACTIVE;
+    stack.push_back(i);
+    for (auto const p : parents_[i]) {
+      if (marks[p] == Mark::ACTIVE) {
+        Exception e(errors::Configuration);
+        e << "The following modules have a cycle of data dependencies:\n  ";
+        for (auto it = std::find(stack.cbegin(), stack.cend(), p);
+             it != stack.cend();
+             ++it) {
+          e << labels_[*it] << " <- ";
+        }
+        e << labels_[p] << "\n";
+        throw e;
+      }
+      if (marks[p] == Mark::NEW) {
+        visit(p);
+      }
+    }
+    stack.pop_back();
+    marks[i] = Mark::DONE;
+  };
+  for (std::size_t i = 0; i != labels_.size(); ++i) {
+    if (marks[i] == Mark::NEW) {
+      visit(i);
+    }
+  }
+}
+
+// With no cycles, every module can be visited after all those it
+// depends on (Kahn's algorithm).
+void
+art::detail::ModuleGraph::
+fillAncestors_()
+{
+  auto const n = labels_.size();
+  ancestors_.assign(n, std::vector<bool>(n, false));
+  std::vector<std::vector<std::size_t> > children(n);
+  std::vector<std::size_t> nParents(n);
+  for (std::size_t i = 0; i != n; ++i) {
+    nParents[i] = parents_[i].size();
+    for (auto const p : parents_[i]) {
+      children[p].push_back(i);
+    }
+  }
+  std::vector<std::size_t> ready;
+  for (std::size_t i = 0; i != n; ++i) {
+    if (nParents[i] == 0) {
+      ready.push_back(i);
+    }
+  }
+  while (!ready.empty()) {
+    auto const i = ready.back();
+    ready.pop_back();
+    for (auto const p : parents_[i]) {
+      ancestors_[i][p] = true;
+      for (std::size_t j = 0; j != n; ++j) {
+        if (ancestors_[p][j]) {
+          ancestors_[i][j] = true;
+        }
+      }
+    }
+    for (auto const c : children[i]) {
+      if (--nParents[c] == 0) {
+        ready.push_back(c);
+      }
+    }
+  }
+}
+
+void
+art::detail::ModuleGraph::
+writeDot(std::ostream & os) const
+{
+  os << "digraph modules {\n";
+  for (auto const & label : labels_) {
+    os << "  \"" << label << "\";\n";
+  }
+  for (auto const & edge : edges_) {
+    os << "  \""
+       << labels_[edge.producer]
+       << "\" -> \""
+       << labels_[edge.consumer]
+       << "\" [label=\""
+       << edge.product
+       << "\"];\n";
+  }
+  os << "}\n";
+}
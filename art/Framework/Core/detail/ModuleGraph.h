@@ -0,0 +1,145 @@
+#ifndef art_Framework_Core_detail_ModuleGraph_h
+#define art_Framework_Core_detail_ModuleGraph_h
+////////////////////////////////////////////////////////////////////////
+// ModuleGraph
+//
+// The data dependencies among a set of modules, as declared by them:
+// module B depends on module A if B consumes() a product of the
+// current process which A produces(). Consumed products of other
+// processes come from the input, and make no dependency. A module
+// which declared nothing (see ProducerBase::consumesNothing()) may
+// read anything; the graph cannot order it, and users of the graph
+// must treat it as depending on, and depended on by, every module.
+//
+// A consumed product naming a module of the graph which does not
+// produce it, or naming the current process but no module of the
+// graph, can be neither read nor ordered; such products are listed by
+// unresolved(), for the owner of the graph to report.
+//
+// A cycle of dependencies is a configuration error, reported by the
+// constructor. Once constructed, the graph answers whether one module
+// depends on another, directly or through others, and can be written
+// out in the DOT language of Graphviz for inspection.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "art/Framework/Principal/ConsumedProduct.h"
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace art {
+  namespace detail {
+    class ModuleGraph;
+  }
+}
+
+class art::detail::ModuleGraph {
+public:
+  struct ProductName {
+    std::string friendlyClassName;
+    std::string productInstanceName;
+  };
+
+  struct Module {
+    std::string label;
+    std::vector<ProductName> produced;
+    ConsumedProducts consumed;
+    bool declared;
+  };
+
+  ModuleGraph(std::vector<Module> const & modules,
+              std::string const & processName);
+
+  std::size_t size() const;
+  std::vector<std::string> const & labels() const;
+
+  bool contains(std::string const & label) const;
+
+  // The labels of the modules on which the named module depends
+  // directly, in the order given to the constructor.
+  std::vector<std::string> directDependencies(std::string const & label) const;
+
+  // True if the module 'consumer' depends on the module 'producer',
+  // directly or not. Unknown labels depend on nothing.
+  bool dependsOn(std::string const & consumer,
+                 std::string const & producer) const;
+
+  // True if the named module declared what it consumes.
+  bool declared(std::string const & label) const;
+
+  // Consumed products which no module of the graph produces, each
+  // described as "<consumer> consumes <type>:<tag>".
+  std::vector<std::string> const & unresolved() const;
+
+  void writeDot(std::ostream & os) const;
+
+private:
+  struct Edge {
+    std::size_t producer;
+    std::size_t consumer;
+    std::string product;
+  };
+
+  std::size_t index_(std::string const & label) const;
+  void checkForCycles_() const;
+  void fillAncestors_();
+
+  std::vector<std::string> labels_;
+  std::map<std::string, std::size_t> indices_;
+  std::vector<Edge> edges_;
+  std::vector<bool> declared_;
+  std::vector<std::string> unresolved_;
+  // Direct dependencies of each module, by index.
+  std::vector<std::vector<std::size_t> > parents_;
+  // ancestors_[i][j]: module i depends on module j.
+  std::vector<std::vector<bool> > ancestors_;
+};
+
+inline
+std::size_t
+art::detail::ModuleGraph::
+size() const
+{
+  return labels_.size();
+}
+
+inline
+std::vector<std::string> const &
+art::detail::ModuleGraph::
+labels() const
+{
+  return labels_;
+}
+
+inline
+bool
+art::detail::ModuleGraph::
+contains(std::string const & label) const
+{
+  return index_(label) != labels_.size();
+}
+
+inline
+bool
+art::detail::ModuleGraph::
+declared(std::string const & label) const
+{
+  auto const i = index_(label);
+  return i != labels_.size() && declared_[i];
+}
+
+inline
+std::vector<std::string> const &
+art::detail::ModuleGraph::
+unresolved() const
+{
+  return unresolved_;
+}
+#endif /* art_Framework_Core_detail_ModuleGraph_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -1,8 +1,18 @@
 #include "art/Framework/Core/detail/ScheduleTask.h"
 
+thread_local art::ScheduleID
+art::detail::ScheduleScope::currentID_;
+
+thread_local std::string const *
+art::detail::ScheduleScope::currentPathName_ = nullptr;
+
 tbb::task *
 art::detail::ScheduleTask::
 execute()
 {
+  ScheduleScope scope(id_, nullptr);
+  if (work_) {
+    work_();
+  }
   return NULL;
 }
@@ -3,7 +3,20 @@
 ////////////////////////////////////////////////////////////////////////
 // ScheduleTask
 //
-// Top level schedule task for processing events.
+// Top level schedule task for processing events. The task executes the
+// (optional) work function it was given; any task spawned while that
+// work is running can find its schedule via ScheduleContext.
+//
+// ScheduleScope
+//
+// Makes a schedule, and optionally a path, current for the calling
+// thread until it goes out of scope, when the previous ones are
+// restored. ScheduleTask makes its schedule current while it runs;
+// the framework tasks that run part of a schedule's work on other
+// threads (concurrent paths, producers and output modules) make
+// current the schedule and path that were current where they were
+// created. Services watching module signals use this to tell whose
+// module it is.
 //
 ////////////////////////////////////////////////////////////////////////
 
@@ -11,15 +24,20 @@
 
 #include "tbb/task.h"
 
+#include <functional>
+#include <string>
+
 namespace art {
   namespace detail {
     class ScheduleTask;
+    class ScheduleScope;
   }
 }
 
 class art::detail::ScheduleTask : public tbb::task {
 public:
   ScheduleTask(ScheduleID sid);
+  ScheduleTask(ScheduleID sid, std::function<void ()> work);
 
   ScheduleID scheduleID() const;
 
@@ -27,13 +45,46 @@ public:
 
 private:
   ScheduleID id_;
+  std::function<void ()> work_;
+};
+
+class art::detail::ScheduleScope {
+public:
+  explicit ScheduleScope(ScheduleID sid,
+                         std::string const * path = pathName());
+  ~ScheduleScope();
+
+  ScheduleScope(ScheduleScope const &) = delete;
+  ScheduleScope & operator = (ScheduleScope const &) = delete;
+
+  // The current schedule (invalid if none) and path (null if none) of
+  // the calling thread.
+  static ScheduleID scheduleID();
+  static std::string const * pathName();
+
+private:
+  ScheduleID savedID_;
+  std::string const * savedPathName_;
+
+  static thread_local ScheduleID currentID_;
+  static thread_local std::string const * currentPathName_;
 };
 
 inline
 art::detail::ScheduleTask::
 ScheduleTask(ScheduleID sid)
     :
-    id_(sid)
+    id_(sid),
+    work_()
+{
+}
+
+inline
+art::detail::ScheduleTask::
+ScheduleTask(ScheduleID sid, std::function<void ()> work)
+    :
+    id_(sid),
+    work_(std::move(work))
 {
 }
 
@@ -44,6 +95,41 @@ scheduleID() const
 {
   return id_;
 }
+
+inline
+art::detail::ScheduleScope::
+ScheduleScope(ScheduleID sid, std::string const * path)
+    :
+    savedID_(currentID_),
+    savedPathName_(currentPathName_)
+{
+  currentID_ = sid;
+  currentPathName_ = path;
+}
+
+inline
+art::detail::ScheduleScope::
+~ScheduleScope()
+{
+  currentID_ = savedID_;
+  currentPathName_ = savedPathName_;
+}
+
+inline
+art::ScheduleID
+art::detail::ScheduleScope::
+scheduleID()
+{
+  return currentID_;
+}
+
+inline
+std::string const *
+art::detail::ScheduleScope::
+pathName()
+{
+  return currentPathName_;
+}
 #endif /* art_Framework_Core_detail_ScheduleTask_h */
 
 // Local Variables:
@@ -6,6 +6,7 @@
 #include "art/Framework/Core/InputSource.h"
 #include "art/Framework/Core/InputSourceDescription.h"
 #include "art/Framework/Core/InputSourceFactory.h"
+#include "art/Framework/Core/detail/ScheduleTask.h"
 #include "art/Framework/EventProcessor/EPStates.h"
 #include "art/Framework/EventProcessor/detail/writeSummary.h"
 #include "art/Framework/Principal/EventPrincipal.h"
@@ -15,12 +16,14 @@
 #include "art/Framework/Services/Optional/RandomNumberGenerator.h"
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "art/Framework/Services/Registry/ServiceRegistry.h"
+#include "art/Framework/Services/Registry/detail/ServiceCacheEntry.h"
 #include "art/Framework/Services/System/CurrentModule.h"
 #include "art/Framework/Services/System/FileCatalogMetadata.h"
 #include "art/Framework/Services/System/FloatingPointControl.h"
 #include "art/Framework/Services/System/PathSelection.h"
 #include "art/Framework/Services/System/ScheduleContext.h"
 #include "art/Framework/Services/System/TriggerNamesService.h"
+#include "art/Framework/Services/System/detail/ScheduleContextSetter.h"
 #include "art/Persistency/Provenance/BranchIDListHelper.h"
 #include "art/Persistency/Provenance/BranchType.h"
 #include "art/Persistency/Provenance/ProcessConfiguration.h"
@@ -35,6 +38,7 @@
 #include "cetlib/container_algorithms.h"
 #include "cpp0x/utility"
 #include "messagefacility/MessageLogger/MessageLogger.h"
+#include "tbb/task.h"
 
 #include <exception>
 #include <iomanip>
@@ -138,12 +142,13 @@ art::EventProcessor::EventProcessor(ParameterSet const & pset)
   serviceDirector_(initServices_(pset, actReg_, serviceToken_)),
   destructorOperate_(),
   input_(),
-  schedule_(),
+  schedules_(),
   endPathExecutor_(),
   fb_(),
   machine_(),
   principalCache_(),
   sm_evp_(),
+  pendingEvents_(),
   shouldWeStop_(false),
   stateMachineWasInErrorState_(false),
   fileMode_(helper_.schedulerPS().get<std::string>("fileMode", "")),
@@ -156,6 +161,14 @@ art::EventProcessor::EventProcessor(ParameterSet const & pset)
 {
   std::string const processName = pset.get<std::string>("process_name");
 
+  // Arenas of the event principals.
+  auto const arenaPS =
+    helper_.schedulerPS().get<ParameterSet>("eventArena", ParameterSet());
+  EventPrincipal::setArenaOptions({
+      arenaPS.get<bool>("enabled", true),
+      arenaPS.get<std::size_t>("blockSize", MonotonicArena::defaultBlockSize),
+      arenaPS.get<bool>("streamedProducts", false) });
+
   // Services
   ServiceRegistry::Operate operate(serviceToken_); // Make usable.
   serviceToken_.forceCreation();
@@ -224,7 +237,9 @@ art::EventProcessor::beginJob()
                              " processing the beginJob of the 'source'\n";
     throw;
   }
-  schedule_->beginJob();
+  for (auto const & schedule : schedules_) {
+    schedule->beginJob();
+  }
   endPathExecutor_->beginJob();
   actReg_.sPostBeginJob.invoke();
 
@@ -239,7 +254,9 @@ art::EventProcessor::endJob()
   // Make the services available
   ServiceRegistry::Operate operate(serviceToken_);
   c.call([this](){ this->terminateMachine_(); });
-  c.call([this](){ schedule_.get()->endJob(); });
+  for (auto const & schedule : schedules_) {
+    c.call([&schedule](){ schedule->endJob(); });
+  }
   c.call([this](){ endPathExecutor_.get()->endJob(); });
   bool summarize = ServiceHandle<TriggerNamesService>()->wantSummary();
   c.call([this,summarize](){ detail::writeSummary(pathManager_, summarize); });
@@ -297,6 +314,9 @@ initServices_(ParameterSet const & top_pset,
   auto pathSelection = services.get<ParameterSet>("PathSelection", {});
   services.erase("PathSelection");
 
+  // Per-schedule services need one instance for each schedule.
+  detail::ServiceCacheEntry::setNSchedules(pathManager_.numSchedules());
+
   // Create the service director and all user-configured services.
   ServiceDirector director(std::move(services), areg, token);
 
@@ -323,15 +343,20 @@ initSchedules_(ParameterSet const & pset)
                                   tbb::task_scheduler_init::default_num_threads());
   tbbManager_.initialize(num_threads);
 
-  schedule_ =
-    std::unique_ptr<Schedule>
-    (new Schedule(ScheduleID::first(),
-                  pathManager_,
-                  pset,
-                  ServiceRegistry::instance().get<TriggerNamesService>(),
-                  preg_,
-                  act_table_,
-                  actReg_));
+  // One schedule, with its own clones of the trigger path modules, per
+  // event processed concurrently.
+  auto const nSchedules = pathManager_.numSchedules();
+  schedules_.reserve(nSchedules);
+  for (ScheduleID::size_type i = 0; i < nSchedules; ++i) {
+    schedules_.emplace_back(new Schedule(ScheduleID(i),
+                                         pathManager_,
+                                         pset,
+                                         ServiceRegistry::instance().get<TriggerNamesService>(),
+                                         preg_,
+                                         act_table_,
+                                         actReg_));
+  }
+  pendingEvents_.reserve(nSchedules);
 }
 
 void
@@ -341,13 +366,16 @@ invokePostBeginJobWorkers_()
   // Need to convert multiple lists of workers into a long list that the
   // postBeginJobWorkers callbacks can understand.
   std::vector<Worker *> allWorkers;
-  allWorkers.reserve(pathManager_.triggerPathsInfo(ScheduleID::first()).workers().size() +
+  allWorkers.reserve(schedules_.size() *
+                     pathManager_.triggerPathsInfo(ScheduleID::first()).workers().size() +
                      pathManager_.endPathInfo().workers().size());
   auto workerStripper = [&allWorkers](WorkerMap::value_type const & val) {
     allWorkers.emplace_back(val.second.get());
   };
-  cet::for_all(pathManager_.triggerPathsInfo(ScheduleID::first()).workers(),
-               workerStripper);
+  for (ScheduleID::size_type i = 0; i < schedules_.size(); ++i) {
+    cet::for_all(pathManager_.triggerPathsInfo(ScheduleID(i)).workers(),
+                 workerStripper);
+  }
   cet::for_all(pathManager_.endPathInfo().workers(),
                 workerStripper);
   actReg_.sPostBeginJobWorkers.invoke(input_.get(), allWorkers);
@@ -402,11 +430,17 @@ art::EventProcessor::runCommon_()
     while (true) {
       itemType = input_->nextItemType();
       FDEBUG(1) << "itemType = " << itemType << "\n";
+      // Run, SubRun and file transitions are serialized: every event
+      // already read must be finished first.
+      if (itemType != input::IsEvent) {
+        processPendingEvents_();
+      }
       // Look for a shutdown signal
       {
         boost::mutex::scoped_lock sl(usr2_lock);
         if (art::shutdown_flag > 0) {
           //changeState(mShutdownSignal);
+          processPendingEvents_();
           returnCode = epSignal;
           machine_->process_event(statemachine::Stop());
           break;
@@ -589,7 +623,9 @@ art::EventProcessor::closeOutputFiles()
 void
 art::EventProcessor::respondToOpenInputFile()
 {
-  schedule_->respondToOpenInputFile(*fb_);
+  for (auto const & schedule : schedules_) {
+    schedule->respondToOpenInputFile(*fb_);
+  }
   endPathExecutor_->respondToOpenInputFile(*fb_);
   FDEBUG(1) << "\trespondToOpenInputFile\n";
 }
@@ -597,7 +633,9 @@ art::EventProcessor::respondToOpenInputFile()
 void
 art::EventProcessor::respondToCloseInputFile()
 {
-  schedule_->respondToCloseInputFile(*fb_);
+  for (auto const & schedule : schedules_) {
+    schedule->respondToCloseInputFile(*fb_);
+  }
   endPathExecutor_->respondToCloseInputFile(*fb_);
   FDEBUG(1) << "\trespondToCloseInputFile\n";
 }
@@ -605,7 +643,9 @@ art::EventProcessor::respondToCloseInputFile()
 void
 art::EventProcessor::respondToOpenOutputFiles()
 {
-  schedule_->respondToOpenOutputFiles(*fb_);
+  for (auto const & schedule : schedules_) {
+    schedule->respondToOpenOutputFiles(*fb_);
+  }
   endPathExecutor_->respondToOpenOutputFiles(*fb_);
   FDEBUG(1) << "\trespondToOpenOutputFiles\n";
 }
@@ -613,7 +653,9 @@ art::EventProcessor::respondToOpenOutputFiles()
 void
 art::EventProcessor::respondToCloseOutputFiles()
 {
-  schedule_->respondToCloseOutputFiles(*fb_);
+  for (auto const & schedule : schedules_) {
+    schedule->respondToCloseOutputFiles(*fb_);
+  }
   endPathExecutor_->respondToCloseOutputFiles(*fb_);
   FDEBUG(1) << "\trespondToCloseOutputFiles\n";
 }
@@ -813,6 +855,9 @@ void
 art::EventProcessor::readEvent()
 {
   SignalSentry sourceSentry(actReg_.sPreSource, actReg_.sPostSource);
+  if (sm_evp_) {
+    input_->recycleEvent(std::move(sm_evp_));
+  }
   sm_evp_ = input_->readEvent(principalCache_.subRunPrincipalPtr());
   FDEBUG(1) << "\treadEvent\n";
 }
@@ -821,12 +866,93 @@ void
 art::EventProcessor::processEvent()
 {
   if (!sm_evp_->id().isFlush()) {
-    processOneOccurrence_<OccurrenceTraits<EventPrincipal, BranchActionBegin> >
-      (*sm_evp_);
+    if (schedules_.size() == 1) {
+      processOneOccurrence_<OccurrenceTraits<EventPrincipal, BranchActionBegin> >
+        (*sm_evp_);
+    }
+    else {
+      pendingEvents_.emplace_back(std::move(sm_evp_));
+      if (pendingEvents_.size() == schedules_.size()) {
+        processPendingEvents_();
+      }
+    }
     FDEBUG(1) << "\tprocessEvent\n";
   }
 }
 
+void
+art::EventProcessor::processPendingEvents_()
+{
+  if (pendingEvents_.empty()) {
+    return;
+  }
+  typedef OccurrenceTraits<EventPrincipal, BranchActionBegin> Traits;
+  std::vector<std::unique_ptr<EventPrincipal> > events;
+  events.swap(pendingEvents_);
+  auto const nEvents = events.size();
+  std::vector<std::exception_ptr> failures(nEvents);
+  auto & actReg = actReg_;
+  {
+    detail::ScheduleContextSetter contextSetter;
+    contextSetter.setContext();
+    tbb::empty_task & root = *new(tbb::task::allocate_root()) tbb::empty_task;
+    root.set_ref_count(nEvents + 1);
+    for (size_t i = 0; i != nEvents; ++i) {
+      auto & ep = *events[i];
+      auto & schedule = *schedules_[i];
+      auto & failure = failures[i];
+      tbb::task::spawn(*new(root.allocate_child())
+                       detail::ScheduleTask(ScheduleID(i),
+                                            [&actReg, &ep, &schedule, &failure]() {
+                                              try {
+                                                detail::PrincipalSignalSentry<Traits> sentry(actReg, ep);
+                                                schedule.processOneOccurrence<Traits>(ep);
+                                              }
+                                              catch (...) {
+                                                failure = std::current_exception();
+                                              }
+                                            }));
+    }
+    root.wait_for_all();
+    tbb::task::destroy(root);
+    contextSetter.resetContext();
+  }
+  // The end path (output) sees the events in the order they were read.
+  for (size_t i = 0; i != nEvents; ++i) {
+    auto & ep = *events[i];
+    // The services see the end path modules as those of the schedule
+    // that processed the event.
+    detail::ScheduleScope scope(ScheduleID(i));
+    try {
+      if (failures[i]) {
+        std::rethrow_exception(failures[i]);
+      }
+      if (!shouldWeStop_) {
+        endPathExecutor_->processOneOccurrence<Traits>(ep);
+        shouldWeStop_ = endPathExecutor_->terminate();
+      }
+    }
+    catch (cet::exception & ex) {
+      if (act_table_.find(ex.root_cause()) != actions::IgnoreCompletely) {
+        throw art::Exception(errors::EventProcessorFailure)
+          << "An exception occurred during current event processing\n"
+          << ex;
+      }
+      mf::LogWarning(ex.category())
+        << "exception being ignored for current event:\n"
+        << cet::trim_right_copy(ex.what(), " \n");
+    }
+    catch (...) {
+      mf::LogError("PassingThrough")
+        << "an exception occurred during current event processing\n";
+      throw;
+    }
+  }
+  for (auto & ep : events) {
+    input_->recycleEvent(std::move(ep));
+  }
+}
+
 bool
 art::EventProcessor::shouldWeStop() const
 {
@@ -863,7 +989,11 @@ bool
 art::EventProcessor::
 setTriggerPathEnabled(std::string const & name, bool enable)
 {
-  return schedule_->setTriggerPathEnabled(name, enable);
+  bool result = schedules_.front()->setTriggerPathEnabled(name, enable);
+  for (auto I = schedules_.cbegin() + 1, E = schedules_.cend(); I != E; ++I) {
+    (*I)->setTriggerPathEnabled(name, enable);
+  }
+  return result;
 }
 
 bool
@@ -894,6 +1024,7 @@ void
 art::EventProcessor::terminateAbnormally_() try
 {
   alreadyHandlingException_ = true;
+  pendingEvents_.clear();
   if (ServiceRegistry::instance().isAvailable<RandomNumberGenerator>()) {
     ServiceHandle<RandomNumberGenerator>()->saveToFile_();
   }
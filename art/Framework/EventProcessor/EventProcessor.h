@@ -147,6 +147,15 @@ private:
   template <typename T>
   void
   processOneOccurrence_(typename T::MyPrincipal & p);
+  // Run the trigger paths of the pending events concurrently (one
+  // event per schedule), then their end path in the order read.
+  //
+  // The pre- and postProcessEvent signals of each event bracket its
+  // trigger paths, on the thread running them; the end path follows,
+  // serially. Module signals (pre- and postModule, etc.) of the
+  // clones of a module are emitted concurrently from several threads:
+  // services watching them must be thread-safe.
+  void processPendingEvents_();
 
   ServiceToken getToken_();
 
@@ -173,7 +182,7 @@ private:
   // destructorOperate_ should be populated in destructor only!
   std::unique_ptr<ServiceRegistry::Operate> destructorOperate_;
   std::unique_ptr<InputSource> input_;
-  std::unique_ptr<Schedule> schedule_;
+  std::vector<std::unique_ptr<Schedule> > schedules_;
   std::unique_ptr<EndPathExecutor> endPathExecutor_;
 
   std::shared_ptr<FileBlock> fb_;
@@ -181,6 +190,8 @@ private:
   std::unique_ptr<statemachine::Machine> machine_;
   PrincipalCache principalCache_;
   std::unique_ptr<EventPrincipal> sm_evp_;
+  // Events read but not yet processed (multi-schedule only).
+  std::vector<std::unique_ptr<EventPrincipal> > pendingEvents_;
   bool shouldWeStop_;
   bool stateMachineWasInErrorState_;
   std::string fileMode_;
@@ -233,7 +244,15 @@ void
 art::EventProcessor::processOneOccurrence_(typename T::MyPrincipal & p)
 try {
   detail::PrincipalSignalSentry<T> sentry(actReg_, p);
-  schedule_->processOneOccurrence<T>(p);
+  if (T::isEvent_) {
+    schedules_.front()->processOneOccurrence<T>(p);
+  }
+  else {
+    // Run and SubRun transitions are seen by every schedule's modules.
+    for (auto const & schedule : schedules_) {
+      schedule->processOneOccurrence<T>(p);
+    }
+  }
   endPathExecutor_->processOneOccurrence<T>(p);
 }
 catch (cet::exception & ex) {
@@ -1,10 +1,13 @@
 #include "art/Framework/EventProcessor/detail/writeSummary.h"
 
 #include "art/Framework/Core/PathManager.h"
-#include "cetlib/container_algorithms.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
+#include <algorithm>
 #include <iomanip>
+#include <map>
+#include <string>
+#include <vector>
 
 using mf::LogAbsolute;
 using std::right;
@@ -12,21 +15,119 @@ using std::setw;
 using std::setprecision;
 using std::fixed;
 
+namespace {
+
+  // Counts and times of a path, or of a module, summed over schedules.
+  struct Counts {
+    int visited {0};
+    int run {0};
+    int passed {0};
+    int failed {0};
+    int except {0};
+    std::pair<double, double> time {0.0, 0.0};
+  };
+
+  struct PathCounts {
+    std::string name;
+    int bitPosition {0};
+    Counts counts;
+    std::vector<std::string> labels;
+    std::vector<Counts> modules;
+  };
+
+  void add(std::pair<double, double> & sum,
+           std::pair<double, double> const & t)
+  {
+    sum.first += t.first;
+    sum.second += t.second;
+  }
+
+  // Each schedule has the same paths, of the same modules, in the same
+  // order.
+  std::vector<PathCounts>
+  sumPaths(std::vector<art::PathsInfo const *> const & infos)
+  {
+    std::vector<PathCounts> result;
+    for (auto const info : infos) {
+      auto const & paths = info->pathPtrs();
+      result.resize(paths.size());
+      for (std::size_t p = 0; p != paths.size(); ++p) {
+        auto const & path = *paths[p];
+        auto & sum = result[p];
+        if (sum.labels.empty()) {
+          sum.name = path.name();
+          sum.bitPosition = path.bitPosition();
+          for (unsigned int i = 0; i < path.size(); ++i) {
+            sum.labels.push_back(path.getWorker(i)->description().moduleLabel());
+          }
+          sum.modules.resize(path.size());
+        }
+        sum.counts.run += path.timesRun();
+        sum.counts.passed += path.timesPassed();
+        sum.counts.failed += path.timesFailed();
+        sum.counts.except += path.timesExcept();
+        add(sum.counts.time, path.timeCpuReal());
+        for (unsigned int i = 0; i < path.size(); ++i) {
+          auto & module = sum.modules[i];
+          module.visited += path.timesVisited(i);
+          module.passed += path.timesPassed(i);
+          module.failed += path.timesFailed(i);
+          module.except += path.timesExcept(i);
+          add(module.time, path.timeCpuReal(i));
+        }
+      }
+    }
+    return result;
+  }
+
+  std::map<std::string, Counts>
+  sumWorkers(std::vector<art::PathsInfo const *> const & infos)
+  {
+    std::map<std::string, Counts> result;
+    for (auto const info : infos) {
+      for (auto const & val : info->workers()) {
+        auto & sum = result[val.first];
+        sum.visited += val.second->timesVisited();
+        sum.run += val.second->timesRun();
+        sum.passed += val.second->timesPassed();
+        sum.failed += val.second->timesFailed();
+        sum.except += val.second->timesExcept();
+        add(sum.time, val.second->timeCpuReal());
+      }
+    }
+    return result;
+  }
+}
+
 void
 art::detail::writeSummary(PathManager & pm, bool wantSummary)
 {
-  // Still only assuming one schedule. Will need to loop when we get around to it.
+  // The trigger paths and their modules are summed over all schedules.
   auto const & epi = pm.endPathInfo();
-  auto const & tpi = pm.triggerPathsInfo(ScheduleID::first());
+  std::vector<PathsInfo const *> tpis;
+  std::size_t totalEvents {0}, passedEvents {0}, failedEvents {0};
+  std::pair<double, double> triggerTime {0.0, 0.0};
+  for (ScheduleID::size_type i = 0; i < pm.numSchedules(); ++i) {
+    auto const & spi = pm.triggerPathsInfo(ScheduleID(i));
+    tpis.push_back(&spi);
+    totalEvents += spi.totalEvents();
+    passedEvents += spi.passedEvents();
+    failedEvents += spi.failedEvents();
+    add(triggerTime, spi.timeCpuReal());
+  }
+  auto const triggerPaths = sumPaths(tpis);
+  auto const triggerWorkers = sumWorkers(tpis);
+  auto const endPaths = sumPaths({&epi});
+  auto const endPathWorkers = sumWorkers({&epi});
 
   // The trigger report (pass/fail etc.):
   // Printed even if summary not requested, per issue #1864.
   LogAbsolute("ArtSummary") << "";
   LogAbsolute("ArtSummary") << "TrigReport " << "---------- Event  Summary ------------";
   LogAbsolute("ArtSummary") << "TrigReport"
-                            << " Events total = " << tpi.totalEvents()
-                            << " passed = " << tpi.passedEvents()
-                            << " failed = " << tpi.failedEvents()
+                            << " Events total = " << totalEvents
+                            << " passed = " << passedEvents
+                            << " failed = " << failedEvents
                             << "";
   if (wantSummary) {
     LogAbsolute("ArtSummary") << "";
@@ -38,15 +139,15 @@ art::detail::writeSummary(PathManager & pm, bool wantSummary)
                               << right << setw(10) << "Failed" << " "
                               << right << setw(10) << "Error" << " "
                               << "Name" << "";
-    for (auto const & path : tpi.pathPtrs()) {
+    for (auto const & path : triggerPaths) {
       LogAbsolute("ArtSummary") << "TrigReport "
                                 << right << setw(5) << 1
-                                << right << setw(5) << path->bitPosition() << " "
-                                << right << setw(10) << path->timesRun() << " "
-                                << right << setw(10) << path->timesPassed() << " "
-                                << right << setw(10) << path->timesFailed() << " "
-                                << right << setw(10) << path->timesExcept() << " "
-                                << path->name() << "";
+                                << right << setw(5) << path.bitPosition << " "
+                                << right << setw(10) << path.counts.run << " "
+                                << right << setw(10) << path.counts.passed << " "
+                                << right << setw(10) << path.counts.failed << " "
+                                << right << setw(10) << path.counts.except << " "
+                                << path.name << "";
     }
     LogAbsolute("ArtSummary") << "";
     LogAbsolute("ArtSummary") << "TrigReport " << "-------End-Path   Summary ------------";
@@ -57,19 +158,19 @@ art::detail::writeSummary(PathManager & pm, bool wantSummary)
                               << right << setw(10) << "Failed" << " "
                               << right << setw(10) << "Error" << " "
                               << "Name" << "";
-    for (auto const & path : epi.pathPtrs()) {
+    for (auto const & path : endPaths) {
       LogAbsolute("ArtSummary") << "TrigReport "
                                 << right << setw(5) << 0
-                                << right << setw(5) << path->bitPosition() << " "
-                                << right << setw(10) << path->timesRun() << " "
-                                << right << setw(10) << path->timesPassed() << " "
-                                << right << setw(10) << path->timesFailed() << " "
-                                << right << setw(10) << path->timesExcept() << " "
-                                << path->name() << "";
+                                << right << setw(5) << path.bitPosition << " "
+                                << right << setw(10) << path.counts.run << " "
+                                << right << setw(10) << path.counts.passed << " "
+                                << right << setw(10) << path.counts.failed << " "
+                                << right << setw(10) << path.counts.except << " "
+                                << path.name << "";
     }
-    for (auto const & path : tpi.pathPtrs()) {
+    for (auto const & path : triggerPaths) {
       LogAbsolute("ArtSummary") << "";
-      LogAbsolute("ArtSummary") << "TrigReport " << "---------- Modules in Path: " << path->name() << " ------------";
+      LogAbsolute("ArtSummary") << "TrigReport " << "---------- Modules in Path: " << path.name << " ------------";
       LogAbsolute("ArtSummary") << "TrigReport "
                                 << right << setw(10) << "Trig Bit#" << " "
                                 << right << setw(10) << "Visited" << " "
@@ -77,22 +178,22 @@ art::detail::writeSummary(PathManager & pm, bool wantSummary)
                                 << right << setw(10) << "Failed" << " "
                                 << right << setw(10) << "Error" << " "
                                 << "Name" << "";
-      for (unsigned int i = 0; i < path->size(); ++i) {
+      for (std::size_t i = 0; i < path.modules.size(); ++i) {
         LogAbsolute("ArtSummary") << "TrigReport "
                                   << right << setw(5) << 1
-                                  << right << setw(5) << path->bitPosition() << " "
-                                  << right << setw(10) << path->timesVisited(i) << " "
-                                  << right << setw(10) << path->timesPassed(i) << " "
-                                  << right << setw(10) << path->timesFailed(i) << " "
-                                  << right << setw(10) << path->timesExcept(i) << " "
-                                  << path->getWorker(i)->description().moduleLabel() << "";
+                                  << right << setw(5) << path.bitPosition << " "
+                                  << right << setw(10) << path.modules[i].visited << " "
+                                  << right << setw(10) << path.modules[i].passed << " "
+                                  << right << setw(10) << path.modules[i].failed << " "
+                                  << right << setw(10) << path.modules[i].except << " "
+                                  << path.labels[i] << "";
       }
     }
   }
   // Printed even if summary not requested, per issue #1864.
-  for (auto const & path : epi.pathPtrs()) {
+  for (auto const & path : endPaths) {
     LogAbsolute("ArtSummary") << "";
-    LogAbsolute("ArtSummary") << "TrigReport " << "------ Modules in End-Path: " << path->name() << " ------------";
+    LogAbsolute("ArtSummary") << "TrigReport " << "------ Modules in End-Path: " << path.name << " ------------";
     LogAbsolute("ArtSummary") << "TrigReport "
                               << right << setw(10) << "Trig Bit#" << " "
                               << right << setw(10) << "Visited" << " "
@@ -100,15 +201,15 @@ art::detail::writeSummary(PathManager & pm, bool wantSummary)
                               << right << setw(10) << "Failed" << " "
                               << right << setw(10) << "Error" << " "
                               << "Name" << "";
-    for (unsigned int i = 0; i < path->size(); ++i) {
+    for (std::size_t i = 0; i < path.modules.size(); ++i) {
       LogAbsolute("ArtSummary") << "TrigReport "
                                 << right << setw(5) << 0
-                                << right << setw(5) << path->bitPosition() << " "
-                                << right << setw(10) << path->timesVisited(i) << " "
-                                << right << setw(10) << path->timesPassed(i) << " "
-                                << right << setw(10) << path->timesFailed(i) << " "
-                                << right << setw(10) << path->timesExcept(i) << " "
-                                << path->getWorker(i)->description().moduleLabel() << "";
+                                << right << setw(5) << path.bitPosition << " "
+                                << right << setw(10) << path.modules[i].visited << " "
+                                << right << setw(10) << path.modules[i].passed << " "
+                                << right << setw(10) << path.modules[i].failed << " "
+                                << right << setw(10) << path.modules[i].except << " "
+                                << path.labels[i] << "";
     }
   }
   if (wantSummary) {
@@ -121,33 +222,39 @@ art::detail::writeSummary(PathManager & pm, bool wantSummary)
                               << right << setw(10) << "Failed" << " "
                               << right << setw(10) << "Error" << " "
                               << "Name" << "";
-    auto workerstats = [](WorkerMap::value_type const & val) {
+    auto workerstats = [](std::pair<std::string const, Counts> const & val) {
       LogAbsolute("ArtSummary") << "TrigReport "
-      << right << setw(10) << val.second->timesVisited() << " "
-      << right << setw(10) << val.second->timesRun() << " "
-      << right << setw(10) << val.second->timesPassed() << " "
-      << right << setw(10) << val.second->timesFailed() << " "
-      << right << setw(10) << val.second->timesExcept() << " "
+      << right << setw(10) << val.second.visited << " "
+      << right << setw(10) << val.second.run << " "
+      << right << setw(10) << val.second.passed << " "
+      << right << setw(10) << val.second.failed << " "
+      << right << setw(10) << val.second.except << " "
       << val.first << "";
     };
-    cet::for_all(tpi.workers(), workerstats);
-    cet::for_all(epi.workers(), workerstats);
+    for (auto const & val : triggerWorkers) {
+      workerstats(val);
+    }
+    for (auto const & val : endPathWorkers) {
+      workerstats(val);
+    }
   }
   LogAbsolute("ArtSummary") << "";
   // The timing report (CPU and Real Time):
+  auto const nTriggerEvents = std::max(1ul, totalEvents);
+  auto const nEndPathEvents = std::max(1ul, epi.totalEvents());
   LogAbsolute("ArtSummary") << "TimeReport " << "---------- Time  Summary ---[sec]----";
   LogAbsolute("ArtSummary") << "TimeReport"
                             << setprecision(6) << fixed
-                            << " CPU = " << tpi.timeCpuReal().first + epi.timeCpuReal().first
-                            << " Real = " << tpi.timeCpuReal().second + epi.timeCpuReal().second
+                            << " CPU = " << triggerTime.first + epi.timeCpuReal().first
+                            << " Real = " << triggerTime.second + epi.timeCpuReal().second
                             << "";
   LogAbsolute("ArtSummary") << "";
   if (wantSummary) {
     LogAbsolute("ArtSummary") << "TimeReport " << "---------- Event  Summary ---[sec]----";
     LogAbsolute("ArtSummary") << "TimeReport"
                               << setprecision(6) << fixed
-                              << " CPU/event = " << (tpi.timeCpuReal().first + epi.timeCpuReal().first) / std::max(1ul, tpi.totalEvents())
-                              << " Real/event = " << (tpi.timeCpuReal().second + epi.timeCpuReal().second) / std::max(1ul, tpi.totalEvents())
+                              << " CPU/event = " << (triggerTime.first + epi.timeCpuReal().first) / nTriggerEvents
+                              << " Real/event = " << (triggerTime.second + epi.timeCpuReal().second) / nTriggerEvents
                               << "";
     LogAbsolute("ArtSummary") << "";
     LogAbsolute("ArtSummary") << "TimeReport " << "---------- Path   Summary ---[sec]----";
@@ -161,14 +268,14 @@ art::detail::writeSummary(PathManager & pm, bool wantSummary)
                               << right << setw(10) << "CPU" << " "
                               << right << setw(10) << "Real" << " "
                               << "Name" << "";
-    for (auto const & path : tpi.pathPtrs()) {
+    for (auto const & path : triggerPaths) {
       LogAbsolute("ArtSummary") << "TimeReport "
                                 << setprecision(6) << fixed
-                                << right << setw(10) << path->timeCpuReal().first / std::max(1ul, tpi.totalEvents()) << " "
-                                << right << setw(10) << path->timeCpuReal().second / std::max(1ul, tpi.totalEvents()) << " "
-                                << right << setw(10) << path->timeCpuReal().first / std::max(1, path->timesRun()) << " "
-                                << right << setw(10) << path->timeCpuReal().second / std::max(1, path->timesRun()) << " "
-                                << path->name() << "";
+                                << right << setw(10) << path.counts.time.first / nTriggerEvents << " "
+                                << right << setw(10) << path.counts.time.second / nTriggerEvents << " "
+                                << right << setw(10) << path.counts.time.first / std::max(1, path.counts.run) << " "
+                                << right << setw(10) << path.counts.time.second / std::max(1, path.counts.run) << " "
+                                << path.name << "";
     }
     LogAbsolute("ArtSummary") << "TimeReport "
                               << right << setw(10) << "CPU" << " "
@@ -192,14 +299,14 @@ art::detail::writeSummary(PathManager & pm, bool wantSummary)
                               << right << setw(10) << "CPU" << " "
                               << right << setw(10) << "Real" << " "
                               << "Name" << "";
-    for (auto const & path : epi.pathPtrs()) {
+    for (auto const & path : endPaths) {
       LogAbsolute("ArtSummary") << "TimeReport "
                                 << setprecision(6) << fixed
-                                << right << setw(10) << path->timeCpuReal().first / std::max(1ul, epi.totalEvents()) << " "
-                                << right << setw(10) << path->timeCpuReal().second / std::max(1ul, epi.totalEvents()) << " "
-                                << right << setw(10) << path->timeCpuReal().first / std::max(1, path->timesRun()) << " "
-                                << right << setw(10) << path->timeCpuReal().second / std::max(1, path->timesRun()) << " "
-                                << path->name() << "";
+                                << right << setw(10) << path.counts.time.first / nEndPathEvents << " "
+                                << right << setw(10) << path.counts.time.second / nEndPathEvents << " "
+                                << right << setw(10) << path.counts.time.first / std::max(1, path.counts.run) << " "
+                                << right << setw(10) << path.counts.time.second / std::max(1, path.counts.run) << " "
+                                << path.name << "";
     }
     LogAbsolute("ArtSummary") << "TimeReport "
                               << right << setw(10) << "CPU" << " "
@@ -211,9 +318,9 @@ art::detail::writeSummary(PathManager & pm, bool wantSummary)
                               << right << setw(22) << "per event "
                               << right << setw(22) << "per endpath-run "
                               << "";
-    for (auto const & path : tpi.pathPtrs()) {
+    for (auto const & path : triggerPaths) {
       LogAbsolute("ArtSummary") << "";
-      LogAbsolute("ArtSummary") << "TimeReport " << "---------- Modules in Path: " << path->name() << " ---[sec]----";
+      LogAbsolute("ArtSummary") << "TimeReport " << "---------- Modules in Path: " << path.name << " ---[sec]----";
       LogAbsolute("ArtSummary") << "TimeReport "
                                 << right << setw(22) << "per event "
                                 << right << setw(22) << "per module-visit "
@@ -224,14 +331,15 @@ art::detail::writeSummary(PathManager & pm, bool wantSummary)
                                 << right << setw(10) << "CPU" << " "
                                 << right << setw(10) << "Real" << " "
                                 << "Name" << "";
-      for (unsigned int i = 0; i < path->size(); ++i) {
+      for (std::size_t i = 0; i < path.modules.size(); ++i) {
+        auto const & module = path.modules[i];
         LogAbsolute("ArtSummary") << "TimeReport "
                                   << setprecision(6) << fixed
-                                  << right << setw(10) << path->timeCpuReal(i).first / std::max(1ul, tpi.totalEvents()) << " "
-                                  << right << setw(10) << path->timeCpuReal(i).second / std::max(1ul, tpi.totalEvents()) << " "
-                                  << right << setw(10) << path->timeCpuReal(i).first / std::max(1, path->timesVisited(i)) << " "
-                                  << right << setw(10) << path->timeCpuReal(i).second / std::max(1, path->timesVisited(i)) << " "
-                                  << path->getWorker(i)->description().moduleLabel() << "";
+                                  << right << setw(10) << module.time.first / nTriggerEvents << " "
+                                  << right << setw(10) << module.time.second / nTriggerEvents << " "
+                                  << right << setw(10) << module.time.first / std::max(1, module.visited) << " "
+                                  << right << setw(10) << module.time.second / std::max(1, module.visited) << " "
+                                  << path.labels[i] << "";
       }
     }
     LogAbsolute("ArtSummary") << "TimeReport "
@@ -244,9 +352,9 @@ art::detail::writeSummary(PathManager & pm, bool wantSummary)
                               << right << setw(22) << "per event "
                               << right << setw(22) << "per module-visit "
                               << "";
-    for (auto const & path : epi.pathPtrs()) {
+    for (auto const & path : endPaths) {
       LogAbsolute("ArtSummary") << "";
-      LogAbsolute("ArtSummary") << "TimeReport " << "------ Modules in End-Path: " << path->name() << " ---[sec]----";
+      LogAbsolute("ArtSummary") << "TimeReport " << "------ Modules in End-Path: " << path.name << " ---[sec]----";
       LogAbsolute("ArtSummary") << "TimeReport "
                                 << right << setw(22) << "per event "
                                 << right << setw(22) << "per module-visit "
@@ -257,14 +365,15 @@ art::detail::writeSummary(PathManager & pm, bool wantSummary)
                                 << right << setw(10) << "CPU" << " "
                                 << right << setw(10) << "Real" << " "
                                 << "Name" << "";
-      for (unsigned int i = 0; i < path->size(); ++i) {
+      for (std::size_t i = 0; i < path.modules.size(); ++i) {
+        auto const & module = path.modules[i];
         LogAbsolute("ArtSummary") << "TimeReport "
                                   << setprecision(6) << fixed
-                                  << right << setw(10) << path->timeCpuReal(i).first / std::max(1ul, epi.totalEvents()) << " "
-                                  << right << setw(10) << path->timeCpuReal(i).second / std::max(1ul, epi.totalEvents()) << " "
-                                  << right << setw(10) << path->timeCpuReal(i).first / std::max(1, path->timesVisited(i)) << " "
-                                  << right << setw(10) << path->timeCpuReal(i).second / std::max(1, path->timesVisited(i)) << " "
-                                  << path->getWorker(i)->description().moduleLabel() << "";
+                                  << right << setw(10) << module.time.first / nEndPathEvents << " "
+                                  << right << setw(10) << module.time.second / nEndPathEvents << " "
+                                  << right << setw(10) << module.time.first / std::max(1, module.visited) << " "
+                                  << right << setw(10) << module.time.second / std::max(1, module.visited) << " "
+                                  << path.labels[i] << "";
       }
     }
     LogAbsolute("ArtSummary") << "TimeReport "
@@ -292,19 +401,23 @@ art::detail::writeSummary(PathManager & pm, bool wantSummary)
                               << right << setw(10) << "CPU" << " "
                               << right << setw(10) << "Real" << " "
                               << "Name" << "";
-    auto workertimes = [&tpi](WorkerMap::value_type const & val) {
+    auto workertimes = [nTriggerEvents](std::pair<std::string const, Counts> const & val) {
       LogAbsolute("ArtSummary") << "TimeReport "
       << setprecision(6) << fixed
-      << right << setw(10) << val.second->timeCpuReal().first / std::max(1ul, tpi.totalEvents()) << " "
-      << right << setw(10) << val.second->timeCpuReal().second / std::max(1ul, tpi.totalEvents()) << " "
-      << right << setw(10) << val.second->timeCpuReal().first / std::max(1, val.second->timesRun()) << " "
-      << right << setw(10) << val.second->timeCpuReal().second / std::max(1, val.second->timesRun()) << " "
-      << right << setw(10) << val.second->timeCpuReal().first / std::max(1, val.second->timesVisited()) << " "
-      << right << setw(10) << val.second->timeCpuReal().second / std::max(1, val.second->timesVisited()) << " "
+      << right << setw(10) << val.second.time.first / nTriggerEvents << " "
+      << right << setw(10) << val.second.time.second / nTriggerEvents << " "
+      << right << setw(10) << val.second.time.first / std::max(1, val.second.run) << " "
+      << right << setw(10) << val.second.time.second / std::max(1, val.second.run) << " "
+      << right << setw(10) << val.second.time.first / std::max(1, val.second.visited) << " "
+      << right << setw(10) << val.second.time.second / std::max(1, val.second.visited) << " "
       << val.first << "";
     };
-    cet::for_all(tpi.workers(), workertimes);
-    cet::for_all(epi.workers(), workertimes);
+    for (auto const & val : triggerWorkers) {
+      workertimes(val);
+    }
+    for (auto const & val : endPathWorkers) {
+      workertimes(val);
+    }
     LogAbsolute("ArtSummary") << "TimeReport "
                               << right << setw(10) << "CPU" << " "
                               << right << setw(10) << "Real" << " "
@@ -323,4 +436,3 @@ art::detail::writeSummary(PathManager & pm, bool wantSummary)
     LogAbsolute("ArtSummary") << "";
   }
 }
-
@@ -19,6 +19,8 @@ FileStatsCollector(std::string const & moduleLabel,
   seqNo_(0ul),
   lastOpenedInputFile_(),
   inputFilesSeen_(),
+  lastOpenLatency_(0.0),
+  openLatencies_(),
   nEvents_(0ul),
   subRunsSeen_()
 {
@@ -31,18 +33,22 @@ recordFileOpen()
   reset_(); // Reset statistics.
   if (!inputFilesSeen_.empty()) {
     inputFilesSeen_.emplace_back(lastOpenedInputFile_);
+    openLatencies_.emplace_back(lastOpenLatency_);
   }
   fo_ = boost::posix_time::second_clock::universal_time();
 }
 
 void
 art::FileStatsCollector::
-recordInputFile(std::string const & inputFileName)
+recordInputFile(std::string const & inputFileName,
+                double const openLatency)
 {
   if (!inputFileName.empty()) {
     inputFilesSeen_.emplace_back(inputFileName);
+    openLatencies_.emplace_back(openLatency);
   }
   lastOpenedInputFile_ = inputFileName;
+  lastOpenLatency_ = openLatency;
 }
 
 void
@@ -132,6 +138,7 @@ reset_()
   lowestSubRun_ = SubRunID();
   highestSubRun_ = SubRunID();
   inputFilesSeen_.clear();
+  openLatencies_.clear();
   nEvents_ = 0ul;
   subRunsSeen_.clear();
 }
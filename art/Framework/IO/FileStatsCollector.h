@@ -18,7 +18,8 @@ public:
                      std::string const & processName);
 
   void recordFileOpen();
-  void recordInputFile(std::string const & inputFileName);
+  void recordInputFile(std::string const & inputFileName,
+                       double openLatency = 0.0);
   void recordEvent(EventID const & id);
   void recordRun(RunID const & id);
   void recordSubRun(SubRunID const & id);
@@ -34,6 +35,9 @@ public:
   EventID const & highestEventID() const;
   std::string const & lastOpenedInputFile() const;
   std::vector<std::string> parents(bool want_basename = true) const;
+  // Real time in seconds taken to open each input file, in the order
+  // of parents().
+  std::vector<double> const & inputFileOpenLatencies() const;
   size_t sequenceNum() const;
   size_t eventsThisFile() const;
   std::set<SubRunID> const & seenSubRuns() const;
@@ -52,6 +56,8 @@ private:
   size_t seqNo_;
   std::string lastOpenedInputFile_;
   std::vector<std::string> inputFilesSeen_;
+  double lastOpenLatency_;
+  std::vector<double> openLatencies_;
   size_t nEvents_;
   std::set<SubRunID> subRunsSeen_;
 };
@@ -128,6 +134,14 @@ lastOpenedInputFile() const
   return lastOpenedInputFile_;
 }
 
+inline
+std::vector<double> const &
+art::FileStatsCollector::
+inputFileOpenLatencies() const
+{
+  return openLatencies_;
+}
+
 inline
 size_t
 art::FileStatsCollector::
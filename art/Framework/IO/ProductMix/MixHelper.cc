@@ -1,6 +1,7 @@
 #include "art/Framework/IO/ProductMix/MixHelper.h"
 
 #include "art/Framework/IO/Root/GetFileFormatEra.h"
+#include "art/Framework/IO/Root/RootDelayedReader.h"
 #include "art/Framework/IO/Root/setFileIndexPointer.h"
 #include "art/Framework/IO/Root/rootNames.h"
 #include "art/Framework/Principal/Event.h"
@@ -14,13 +15,18 @@
 
 #include <algorithm>
 #include <cassert>
+#include <exception>
 #include <iterator>
 #include <limits>
+#include <mutex>
 #include <numeric>
 #include <regex>
 #include <unordered_set>
 
+#include "RVersion.h"
 #include "Rtypes.h"
+#include "TThread.h"
+#include "tbb/task_group.h"
 
 namespace {
   class EventIDIndexBuilder :
@@ -136,8 +142,37 @@ MixHelper(fhicl::ParameterSet const & pset,
   currentFile_(),
   currentMetaDataTree_(),
   currentEventTree_(),
-  dataBranches_()
+  dataBranches_(),
+  concurrentReads_(pset.get<bool>("concurrentReads", false)),
+  mixOpFiles_(),
+  readArena_(),
+  readBatchSize_(initReadBatchSize_(pset)),
+  batch_(),
+  batchNext_(0),
+  poolSize_(initPoolSize_(pset)),
+  poolReuse_(pset.get<double>("poolReuse", 1.0)),
+  poolMaxBytes_(pset.get<size_t>("poolMaxBytes", 0)),
+  pool_(),
+  poolDraws_(0),
+  poolDrawn_(),
+  poolRefill_()
 {
+  if (readBatchSize_ > 0 && poolSize_ > 0) {
+    throw Exception(errors::Configuration)
+      << "readBatchSize and poolSize may not both be non-zero.\n";
+  }
+  if (concurrentReads_ && poolSize_ > 0) {
+    throw Exception(errors::Configuration)
+      << "concurrentReads may not be set with a non-zero poolSize.\n";
+  }
+  if (poolSize_ > 0 || concurrentReads_) {
+    // Secondary products are read on other threads.
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+    ROOT::EnableThreadSafety();
+#else
+    TThread::Initialize();
+#endif
+  }
 }
 
 void
@@ -184,6 +219,14 @@ generateEventSequence(size_t nSecondaries,
     }
     break;
   case Mode::RANDOM_REPLACE:
+    if (poolSize_ > 0) {
+      drawFromPool_(nSecondaries, enSeq);
+      break;
+    }
+    if (readBatchSize_ > 0) {
+      drawFromBatch_(nSecondaries, enSeq);
+      break;
+    }
     std::generate_n(std::back_inserter(enSeq),
                     nSecondaries,
                     [this]() { return dist_.get()->fireInt(nEventsInFile_); });
@@ -191,6 +234,14 @@ generateEventSequence(size_t nSecondaries,
     break;
   case Mode::RANDOM_LIM_REPLACE:
   {
+    if (poolSize_ > 0) {
+      drawFromPool_(nSecondaries, enSeq);
+      break;
+    }
+    if (readBatchSize_ > 0) {
+      drawFromBatch_(nSecondaries, enSeq);
+      break;
+    }
     std::unordered_set<EntryNumberSequence::value_type> entries; // Guaranteed unique.
     while (entries.size() < nSecondaries) {
       std::generate_n(std::inserter(entries, entries.begin()),
@@ -209,6 +260,10 @@ generateEventSequence(size_t nSecondaries,
   break;
   case Mode::RANDOM_NO_REPLACE:
   {
+    if (readBatchSize_ > 0) {
+      drawFromBatch_(nSecondaries, enSeq);
+      break;
+    }
     auto i = shuffledSequence_.cbegin() + nEventsReadThisFile_;
     enSeq.assign(i, i + nSecondaries);
   }
@@ -232,9 +287,35 @@ art::MixHelper::mixAndPut(EntryNumberSequence const & enSeq,
 {
   // Populate the remapper in case we need to remap any Ptrs.
   ptpBuilder_.populateRemapper(ptrRemapper_, e);
-  // Do the branch-wise read, mix and put.
-  cet::for_all(mixOps_,
-               [&,this](auto const& op){ this->mixAndPutOne_(op, enSeq, e); });
+  if (poolSize_ > 0 || readBatchSize_ > 0) {
+    // Mix the products of the secondary events drawn from the pool or
+    // batch, already read.
+    assert(poolDrawn_.size() == enSeq.size());
+    std::vector<EDProduct const *> products;
+    products.reserve(poolDrawn_.size());
+    for (size_t i = 0, end = mixOps_.size(); i != end; ++i) {
+      products.clear();
+      for (auto const & poolEntry : poolDrawn_) {
+        products.push_back(poolEntry->products[i].get());
+      }
+      mixOps_[i]->readFromPool(products);
+      mixOps_[i]->mixAndPut(e, ptrRemapper_);
+    }
+  }
+  else if (concurrentReads_) {
+    forEachMixOp_([&enSeq, this](size_t i) {
+        mixOps_[i]->readFromFile(enSeq);
+      });
+    // Putting is not thread-safe.
+    for (auto const & op : mixOps_) {
+      op->mixAndPut(e, ptrRemapper_);
+    }
+  }
+  else {
+    // Do the branch-wise read, mix and put.
+    cet::for_all(mixOps_,
+                 [&,this](auto const& op){ this->mixAndPutOne_(op, enSeq, e); });
+  }
   nEventsReadThisFile_ += enSeq.size();
   totalEventsRead_ += enSeq.size();
 }
@@ -277,10 +358,40 @@ initReadMode_(std::string const & mode) const
     << "  randomNoReplace.\n";
 }
 
+size_t
+art::MixHelper::
+initPoolSize_(fhicl::ParameterSet const & pset) const
+{
+  auto const result = pset.get<size_t>("poolSize", 0);
+  if (result > 0 &&
+      readMode_ != Mode::RANDOM_REPLACE &&
+      readMode_ != Mode::RANDOM_LIM_REPLACE) {
+    throw Exception(errors::Configuration)
+      << "A pool of secondary events (poolSize > 0) may only be used with\n"
+      << "readMode randomReplace or randomLimReplace.\n";
+  }
+  return result;
+}
+
+size_t
+art::MixHelper::
+initReadBatchSize_(fhicl::ParameterSet const & pset) const
+{
+  auto const result = pset.get<size_t>("readBatchSize", 0);
+  if (result > 0 && readMode_ == Mode::SEQUENTIAL) {
+    throw Exception(errors::Configuration)
+      << "readBatchSize may only be used with a random readMode.\n";
+  }
+  return result;
+}
+
 void
 art::MixHelper::
 openAndReadMetaData_(std::string filename)
 {
+  // The pool (and any refill) is of the previous file.
+  dropPool_();
+  mixOpFiles_.clear();
   // Open file.
   try {
     currentFile_.reset(TFile::Open(filename.c_str()));
@@ -371,6 +482,9 @@ openAndReadMetaData_(std::string filename)
   ProdToProdMapBuilder::BranchIDTransMap transMap;
   buildBranchIDTransMap_(transMap);
   ptpBuilder_.prepareTranslationTables(transMap, branchIDLists, ehTree);
+  if (concurrentReads_) {
+    openMixOpFiles_(filename);
+  }
   if (readMode_ == Mode::RANDOM_NO_REPLACE) {
     // Prepare shuffled event sequence.
     shuffledSequence_.resize(static_cast<size_t>(nEventsInFile_));
@@ -462,3 +576,280 @@ buildBranchIDTransMap_(ProdToProdMapBuilder::BranchIDTransMap &
       (*i)->outgoingBranchID();
   }
 }
+
+void
+art::MixHelper::
+drawFromPool_(size_t nSecondaries, EntryNumberSequence & enSeq)
+{
+  // The pool is replaced after a fixed number of draws, not when a
+  // refill happens to be ready, so the events mixed do not depend on
+  // the timing of the background read.
+  if (pool_.empty() || poolDraws_ >= poolReuse_ * pool_.size()) {
+    if (!poolRefill_.valid()) {
+      startPoolRefill_();
+    }
+    pool_ = poolRefill_.get();
+    poolDraws_ = 0;
+    startPoolRefill_();
+  }
+  std::vector<size_t> indices;
+  indices.reserve(nSecondaries);
+  if (readMode_ == Mode::RANDOM_LIM_REPLACE) {
+    if (pool_.size() < nSecondaries) {
+      throw Exception(errors::Configuration)
+        << "Pool of "
+        << pool_.size()
+        << " secondary events is too small to draw "
+        << nSecondaries
+        << " unique events:\n"
+        << "increase poolSize (or poolMaxBytes).\n";
+    }
+    std::unordered_set<size_t> seen; // Guaranteed unique.
+    while (indices.size() < nSecondaries) {
+      size_t const index = dist_.get()->fireInt(pool_.size());
+      if (seen.insert(index).second) {
+        indices.push_back(index);
+      }
+    }
+  }
+  else {
+    std::generate_n(std::back_inserter(indices),
+                    nSecondaries,
+                    [this]() { return dist_.get()->fireInt(pool_.size()); });
+  }
+  // The pool is ordered by entry, so enSeq is too.
+  std::sort(indices.begin(), indices.end());
+  poolDrawn_.clear();
+  enSeq.reserve(nSecondaries);
+  for (auto const index : indices) {
+    poolDrawn_.push_back(pool_[index]);
+    enSeq.push_back(pool_[index]->entry);
+  }
+  poolDraws_ += nSecondaries;
+}
+
+void
+art::MixHelper::
+startPoolRefill_()
+{
+  // Entries are chosen here, so as to use the random engine on this
+  // thread only.
+  size_t const nEntries =
+    std::min(poolSize_, static_cast<size_t>(nEventsInFile_));
+  EntryNumberSequence entries;
+  entries.reserve(nEntries);
+  std::unordered_set<EntryNumberSequence::value_type> seen;
+  while (entries.size() < nEntries) {
+    auto const entry = dist_.get()->fireInt(nEventsInFile_);
+    if (seen.insert(entry).second) {
+      entries.push_back(entry);
+    }
+  }
+  poolRefill_ = std::async(std::launch::async,
+                           &MixHelper::readPool_,
+                           this,
+                           std::move(entries));
+}
+
+auto
+art::MixHelper::
+readPool_(EntryNumberSequence entries) const
+-> Pool
+{
+  // Half of poolMaxBytes_ each for the pool in use and its refill.
+  size_t const maxBytes = poolMaxBytes_ / 2;
+  size_t totalBytes {0};
+  Pool result;
+  result.reserve(entries.size());
+  // Entries are read in the order drawn, so that stopping short at
+  // maxBytes leaves an unbiased sample.
+  for (auto const entry : entries) {
+    if (maxBytes > 0 && totalBytes >= maxBytes && !result.empty()) {
+      break;
+    }
+    auto poolEntry = std::make_shared<PoolEntry>();
+    poolEntry->entry = entry;
+    poolEntry->products.reserve(mixOps_.size());
+    // Serialized with reads of the primary input.
+    std::lock_guard<std::recursive_mutex> lock(RootDelayedReader::inputMutex());
+    for (auto const & op : mixOps_) {
+      size_t bytes {0};
+      poolEntry->products.push_back(op->readEntry(entry, bytes));
+      totalBytes += bytes;
+    }
+    result.push_back(std::move(poolEntry));
+  }
+  std::sort(result.begin(), result.end(),
+            [](auto const & a, auto const & b) { return a->entry < b->entry; });
+  return result;
+}
+
+void
+art::MixHelper::
+dropPool_()
+{
+  // A refill in progress is abandoned, but its failure is not hidden.
+  if (poolRefill_.valid()) {
+    try {
+      poolRefill_.get();
+    }
+    catch (std::exception const & e) {
+      mf::LogWarning("MixingPool")
+        << "Reading a replacement pool of secondary events failed:\n"
+        << e.what();
+    }
+  }
+  pool_.clear();
+  poolDrawn_.clear();
+  poolDraws_ = 0;
+  batch_.clear();
+  batchNext_ = 0;
+}
+
+void
+art::MixHelper::
+openMixOpFiles_(std::string const & filename)
+{
+  // A TFile, with its trees and branches, may be used by only one
+  // thread at a time: give each MixOp its own.
+  mixOpFiles_.reserve(mixOps_.size());
+  for (auto const & op : mixOps_) {
+    std::unique_ptr<TFile> file(TFile::Open(filename.c_str()));
+    if (!file || file->IsZombie()) {
+      throw Exception(errors::FileOpenError)
+        << "Unable to re-open secondary event stream file "
+        << filename
+        << " for concurrent reading.\n";
+    }
+    TTree * eventTree =
+      dynamic_cast<TTree*>(file->Get(art::rootNames::eventTreeName().c_str()));
+    if (eventTree == 0) {
+      throw Exception(errors::FileReadError)
+        << "Unable to read event tree from secondary event stream file "
+        << filename
+        << ".\n";
+    }
+    op->initializeBranchInfo(RootBranchInfoList(eventTree));
+    mixOpFiles_.push_back(std::move(file));
+  }
+}
+
+void
+art::MixHelper::
+forEachMixOp_(std::function<void (size_t)> const & func)
+{
+  if (!concurrentReads_) {
+    for (size_t i = 0, end = mixOps_.size(); i != end; ++i) {
+      func(i);
+    }
+    return;
+  }
+  std::vector<std::exception_ptr> errors(mixOps_.size());
+  // The reads are spawned and waited for in readArena_: waiting in the
+  // framework's arena would let this thread, which still holds the
+  // worker of the module, steal the task of another path and run into
+  // that worker or this one.
+  auto readAll = [this, &func, &errors]() {
+    tbb::task_group group;
+    for (size_t i = 0, end = mixOps_.size(); i != end; ++i) {
+      auto & error = errors[i];
+      group.run([&func, &error, i]() {
+        try {
+          func(i);
+        }
+        catch (...) {
+          error = std::current_exception();
+        }
+      });
+    }
+    group.wait();
+  };
+  readArena_.execute(readAll);
+  for (auto const & error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+void
+art::MixHelper::
+drawFromBatch_(size_t nSecondaries, EntryNumberSequence & enSeq)
+{
+  // Taking the draws of successive primary events from one stream
+  // leaves their statistics as if drawn event by event; in
+  // RANDOM_LIM_REPLACE mode, repeats within the event are skipped.
+  bool const unique = (readMode_ == Mode::RANDOM_LIM_REPLACE);
+  std::unordered_set<FileIndex::EntryNumber_t> seen;
+  poolDrawn_.clear();
+  while (poolDrawn_.size() < nSecondaries) {
+    if (batchNext_ == batch_.size()) {
+      fillBatch_(nEventsReadThisFile_ + poolDrawn_.size());
+    }
+    auto const & draw = batch_[batchNext_++];
+    if (!unique || seen.insert(draw->entry).second) {
+      poolDrawn_.push_back(draw);
+    }
+  }
+  // The secondaries reach the mix functions in the order they would
+  // have without batching: by entry, except in RANDOM_NO_REPLACE mode,
+  // which keeps the order of the shuffled sequence.
+  if (readMode_ != Mode::RANDOM_NO_REPLACE) {
+    std::sort(poolDrawn_.begin(), poolDrawn_.end(),
+              [](auto const & a, auto const & b) { return a->entry < b->entry; });
+  }
+  enSeq.reserve(nSecondaries);
+  for (auto const & draw : poolDrawn_) {
+    enSeq.push_back(draw->entry);
+  }
+}
+
+void
+art::MixHelper::
+fillBatch_(size_t shuffledPos)
+{
+  EntryNumberSequence draws;
+  if (readMode_ == Mode::RANDOM_NO_REPLACE) {
+    auto const n = std::min(readBatchSize_,
+                            shuffledSequence_.size() - shuffledPos);
+    auto const i = shuffledSequence_.cbegin() + shuffledPos;
+    draws.assign(i, i + n);
+  }
+  else {
+    std::generate_n(std::back_inserter(draws),
+                    readBatchSize_,
+                    [this]() { return dist_.get()->fireInt(nEventsInFile_); });
+  }
+  if (draws.empty()) {
+    throw Exception(errors::LogicError)
+      << "MixHelper ran out of secondary events to draw from "
+      << "the current file.\n";
+  }
+  // Each entry is read once, in entry order: a basket holds a run of
+  // consecutive entries, so it is then decompressed only once.
+  EntryNumberSequence entries(draws);
+  std::sort(entries.begin(), entries.end());
+  entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+  std::vector<std::shared_ptr<PoolEntry> > read;
+  read.reserve(entries.size());
+  for (auto const entry : entries) {
+    auto poolEntry = std::make_shared<PoolEntry>();
+    poolEntry->entry = entry;
+    poolEntry->products.resize(mixOps_.size());
+    read.push_back(std::move(poolEntry));
+  }
+  forEachMixOp_([&read, this](size_t i) {
+      for (auto const & poolEntry : read) {
+        size_t bytes {0};
+        poolEntry->products[i] = mixOps_[i]->readEntry(poolEntry->entry, bytes);
+      }
+    });
+  // Back to the order drawn.
+  batch_.clear();
+  batch_.reserve(draws.size());
+  for (auto const draw : draws) {
+    auto const i = std::lower_bound(entries.cbegin(), entries.cend(), draw);
+    batch_.push_back(read[i - entries.cbegin()]);
+  }
+  batchNext_ = 0;
+}
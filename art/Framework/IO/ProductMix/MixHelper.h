@@ -47,6 +47,45 @@
 //   sequence of product pointers passed to the MixOp will be compacted
 //   to remove nullptrs.
 //
+// concurrentReads (default false).
+//
+//   Read the secondary products of each mix operation concurrently, on
+//   the TBB thread pool. Each mix operation then reads through its own
+//   handle on the secondary file, at the cost of opening the file once
+//   per mix operation. The reads run in a task arena of their own, so
+//   that the filter never waits on the framework's tasks while it holds
+//   its worker. Incompatible with poolSize.
+//
+// readBatchSize (default 0).
+//
+//   If non-zero, secondary events are drawn readBatchSize at a time
+//   rather than one primary event's worth at a time (random modes
+//   only). The distinct events of a batch are read in a single pass in
+//   entry order, so that each basket is decompressed once, and then
+//   handed to the primary events in the order drawn. The statistics of
+//   the draws are unchanged. The products of up to readBatchSize
+//   secondary events are held in memory. Incompatible with poolSize.
+//
+// poolSize (default 0).
+//
+//   Number of secondary events to hold, read and decoded, in a pool
+//   from which the secondary events of each primary event are drawn
+//   (randomReplace and randomLimReplace modes only). The pool is
+//   replaced by one read in the background from the current file once
+//   its events have been drawn poolReuse * poolSize times. 0 disables
+//   the pool: secondary events are read from the file for each primary
+//   event.
+//
+// poolReuse (default 1.0).
+//
+//   See poolSize.
+//
+// poolMaxBytes (default 0).
+//
+//   If non-zero, the bytes read for the pool and the one being read
+//   behind it are kept to this total, by reading fewer than poolSize
+//   events if need be.
+//
 ////////////////////////////////////////////////////////////////////////
 // readMode()
 //
@@ -212,12 +251,14 @@
 #include "cpp0x/memory"
 #include "fhiclcpp/ParameterSet.h"
 
+#include <future>
 #include <string>
 #include <vector>
 
 #include "Rtypes.h"
 #include "TFile.h"
 #include "TTree.h"
+#include "tbb/task_arena.h"
 
 namespace art {
   class MixHelper;
@@ -330,7 +371,17 @@ private:
   typedef std::vector<std::shared_ptr<MixOpBase> > MixOpList;
   typedef MixOpList::iterator MixOpIter;
 
+  // One secondary event of the pool: its products, by MixOp.
+  struct PoolEntry {
+    FileIndex::EntryNumber_t entry;
+    std::vector<std::unique_ptr<EDProduct> > products;
+  };
+  // Ordered by entry.
+  typedef std::vector<std::shared_ptr<PoolEntry const> > Pool;
+
   Mode initReadMode_(std::string const & mode) const;
+  size_t initPoolSize_(fhicl::ParameterSet const & pset) const;
+  size_t initReadBatchSize_(fhicl::ParameterSet const & pset) const;
 
   void openAndReadMetaData_(std::string fileName);
   void buildEventIDIndex_(FileIndex const & fileIndex);
@@ -339,6 +390,14 @@ private:
                      Event & e);
   bool openNextFile_();
   void buildBranchIDTransMap_(ProdToProdMapBuilder::BranchIDTransMap & transMap);
+  void openMixOpFiles_(std::string const & filename);
+  void forEachMixOp_(std::function<void (size_t)> const & func);
+  void drawFromBatch_(size_t nSecondaries, EntryNumberSequence & enSeq);
+  void fillBatch_(size_t shuffledPos);
+  void drawFromPool_(size_t nSecondaries, EntryNumberSequence & enSeq);
+  void startPoolRefill_();
+  Pool readPool_(EntryNumberSequence entries) const;
+  void dropPool_();
 
   ProducerBase & producesProvider_;
   std::vector<std::string> const filenames_;
@@ -365,6 +424,23 @@ private:
   cet::exempt_ptr<TTree> currentMetaDataTree_;
   cet::exempt_ptr<TTree> currentEventTree_;
   RootBranchInfoList dataBranches_;
+  // By MixOp, with concurrentReads_.
+  bool const concurrentReads_;
+  std::vector<std::unique_ptr<TFile> > mixOpFiles_;
+  tbb::task_arena readArena_;
+  size_t const readBatchSize_;
+  Pool batch_; // In the order drawn.
+  size_t batchNext_; // Next draw in batch_.
+
+  // Pool of secondary events. Last, so that a refill still in progress
+  // is waited for before anything it uses is destroyed.
+  size_t const poolSize_;
+  double const poolReuse_;
+  size_t const poolMaxBytes_;
+  Pool pool_;
+  size_t poolDraws_; // Events drawn from pool_.
+  Pool poolDrawn_; // For the current primary event.
+  std::future<Pool> poolRefill_;
 };
 
 inline
@@ -65,6 +65,14 @@ public:
   void
   readFromFile(EntryNumberSequence const & seq);
 
+  virtual
+  std::unique_ptr<EDProduct>
+  readEntry(FileIndex::EntryNumber_t entry, std::size_t & bytes);
+
+  virtual
+  void
+  readFromPool(std::vector<EDProduct const *> const & products);
+
 private:
   typedef std::vector<Wrapper<PROD> > SpecProdList;
 
@@ -75,6 +83,8 @@ private:
   std::string const outputInstanceLabel_;
   std::function<bool (std::vector<PROD const *> const &, PROD &, PtrRemapper const &)> const mixFunc_;
   SpecProdList inProducts_;
+  // The products to mix: in inProducts_, or in the pool.
+  std::vector<Wrapper<PROD> const *> inWrappers_;
   std::string const processName_;
   std::string const moduleLabel_;
   RootBranchInfo branchInfo_;
@@ -96,6 +106,7 @@ MixOp<PROD>::MixOp(InputTag const & inputTag,
   outputInstanceLabel_(outputInstanceLabel),
   mixFunc_(mixFunc),
   inProducts_(),
+  inWrappers_(),
   processName_(ServiceHandle<TriggerNamesService>()->getProcessName()),
   moduleLabel_(ServiceHandle<CurrentModule>()->label()),
   branchInfo_(),
@@ -135,14 +146,10 @@ mixAndPut(Event & e,
 {
   std::unique_ptr<PROD> rProd(new PROD()); // Parens necessary for native types.
   std::vector<PROD const *> inConverted;
-  inConverted.reserve(inProducts_.size());
+  inConverted.reserve(inWrappers_.size());
   try {
-    for (typename SpecProdList::const_iterator
-         i = inProducts_.begin(),
-         endIter = inProducts_.end();
-         i != endIter;
-         ++i) {
-      auto prod = i->product();
+    for (auto const wrapper : inWrappers_) {
+      auto prod = wrapper->product();
       if (prod || ! compactMissingProducts_) {
         inConverted.emplace_back(prod);
       }
@@ -237,6 +244,41 @@ readFromFile(EntryNumberSequence const & seq)
     branchInfo_.branch()->SetAddress(&wp);
     branchInfo_.branch()->GetEntry(*i);
   }
+  inWrappers_.clear();
+  for (auto const & wrapper : inProducts_) {
+    inWrappers_.push_back(&wrapper);
+  }
+}
+
+template <typename PROD>
+std::unique_ptr<art::EDProduct>
+art::MixOp<PROD>::
+readEntry(FileIndex::EntryNumber_t entry, std::size_t & bytes)
+{
+  if (branchInfo_.branch() == 0) {
+    throw Exception(errors::LogicError)
+        << "Branch not initialized for read.\n";
+  }
+  configureRefCoreStreamer();
+  std::unique_ptr<Wrapper<PROD> > result(new Wrapper<PROD>);
+  Wrapper<PROD> * wp = result.get();
+  branchInfo_.branch()->SetAddress(&wp);
+  Int_t const n = branchInfo_.branch()->GetEntry(entry);
+  bytes = (n > 0) ? n : 0;
+  return std::move(result);
+}
+
+template <typename PROD>
+void
+art::MixOp<PROD>::
+readFromPool(std::vector<EDProduct const *> const & products)
+{
+  inProducts_.clear();
+  inWrappers_.clear();
+  for (auto const prod : products) {
+    // Made by readEntry().
+    inWrappers_.push_back(static_cast<Wrapper<PROD> const *>(prod));
+  }
 }
 
 template <typename PROD>
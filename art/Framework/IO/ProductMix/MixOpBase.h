@@ -1,7 +1,10 @@
 #ifndef art_Framework_IO_ProductMix_MixOpBase_h
 #define art_Framework_IO_ProductMix_MixOpBase_h
 
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "art/Framework/IO/ProductMix/MixContainerTypes.h"
 #include "art/Framework/IO/Root/RootBranchInfoList.h"
@@ -47,6 +50,18 @@ public:
   virtual
   void
   readFromFile(EntryNumberSequence const & seq) = 0;
+
+  // Read the product of one secondary event, to be held in the pool of
+  // MixHelper; bytes is set to the number of bytes read.
+  virtual
+  std::unique_ptr<EDProduct>
+  readEntry(FileIndex::EntryNumber_t entry, std::size_t & bytes) = 0;
+
+  // Mix the given products, from readEntry(), rather than those read
+  // from the file.
+  virtual
+  void
+  readFromPool(std::vector<EDProduct const *> const & products) = 0;
 };
 #endif /* art_Framework_IO_ProductMix_MixOpBase_h */
 
@@ -64,6 +64,19 @@ namespace art {
     eventIDs_.clear();
   }
 
+  bool DuplicateChecker::isCheckActive() const
+  {
+    if (duplicateCheckMode_ == noDuplicateCheck) return false;
+    if (duplicateCheckMode_ == checkEachRealDataFile && dataType_ == isSimulation) return false;
+
+    if (duplicateCheckMode_ == checkEachFile ||
+        duplicateCheckMode_ == checkEachRealDataFile) {
+      // The data type is unknown only for a file without events.
+      if (dataType_ == unknown || itIsKnownTheFileHasNoDuplicates_) return false;
+    }
+    return true;
+  }
+
   bool DuplicateChecker::isDuplicateAndCheckActive(EventID const& eventID,
                                                    std::string const& fileName)
   {
@@ -40,6 +40,11 @@ namespace art {
     bool isDuplicateAndCheckActive(EventID const& eventID,
                                    std::string const& fileName);
 
+    // Whether events of the current file are being checked.
+    bool isCheckActive() const;
+
+    bool isCheckDisabled() const { return duplicateCheckMode_ == noDuplicateCheck; }
+
   private:
 
     enum DuplicateCheckMode { noDuplicateCheck, checkEachFile, checkEachRealDataFile, checkAllFilesOpened };
@@ -40,6 +40,50 @@ namespace art {
       TBranch * productBranch_;
     };  // BranchInfo
 
+    // Configuration of the read-ahead of event entries, see
+    // RootTree::setReadAhead().
+    struct ReadAheadConfig
+    {
+      ReadAheadConfig(unsigned int depth = 0,
+                      unsigned int maxBytes = 0,
+                      unsigned int learnEntries = 0)
+        : depth_(depth)
+        , maxBytes_(maxBytes)
+        , learnEntries_(learnEntries)
+      { }
+
+      // Number of entries to read ahead, zero disables read-ahead.
+      unsigned int depth_;
+      // Upper bound on the memory used for the read-ahead buffers.
+      unsigned int maxBytes_;
+      // Number of entries over which to learn which branches are
+      // read; if zero, all branches selected for input are read ahead.
+      unsigned int learnEntries_;
+    };  // ReadAheadConfig
+
+    // Configuration of the tree cache sized automatically from the
+    // branches read, when no cacheSize is given, see
+    // RootTree::setAutoCache().
+    struct AutoCacheConfig
+    {
+      AutoCacheConfig(unsigned int learnEntries = 0,
+                      unsigned int entries = 0,
+                      unsigned int maxBytes = 0)
+        : learnEntries_(learnEntries)
+        , entries_(entries)
+        , maxBytes_(maxBytes)
+      { }
+
+      // Number of entries over which to learn which branches are
+      // read, zero disables the automatic cache.
+      unsigned int learnEntries_;
+      // Number of entries of the branches read the cache should hold.
+      unsigned int entries_;
+      // Upper bound on the size of the cache, and its size while
+      // learning.
+      unsigned int maxBytes_;
+    };  // AutoCacheConfig
+
     typedef std::map<BranchKey const, BranchInfo> BranchMap;
     typedef Long64_t EntryNumber;
     Int_t getEntry(TBranch * branch, EntryNumber entryNumber);
@@ -29,6 +29,8 @@ namespace art {
     }
   }
 
+  // With ROOT thread safety enabled, GetStreamer() returns the copy
+  // belonging to the calling thread.
   void configureRefCoreStreamer(cet::exempt_ptr<EventPrincipal const> groupFinder) {
     static TClassRef cl("art::RefCore");
     RefCoreStreamer *st = static_cast<RefCoreStreamer *>(cl->GetStreamer());
@@ -17,12 +17,14 @@ namespace art {
                            cet::exempt_ptr<EventPrincipal const>());
 }
 
+// Products may be read on several threads at once, e.g. the secondary
+// products of MixHelper. ROOT then gives each thread its own copy of
+// the streamer, from Generate(), and so its own group finder.
 class art::RefCoreStreamer : public TClassStreamer {
 public:
   explicit RefCoreStreamer(cet::exempt_ptr<EventPrincipal const> groupFinder =
                            cet::exempt_ptr<EventPrincipal const>())
-    :
-    groupFinder_(groupFinder)
+    : groupFinder_(groupFinder)
   {}
 
   void setGroupFinder(cet::exempt_ptr<EventPrincipal const> groupFinder) {
@@ -30,6 +32,10 @@ public:
   }
   void operator() (TBuffer &R_b, void *objp);
 
+  TClassStreamer* Generate() const override {
+    return new RefCoreStreamer(*this);
+  }
+
 private:
   cet::exempt_ptr<EventPrincipal const> groupFinder_;
 };
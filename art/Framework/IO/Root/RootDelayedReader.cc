@@ -2,6 +2,7 @@
 // vim: sw=2:
 
 #include "art/Framework/IO/Root/RefCoreStreamer.h"
+#include "art/Framework/Principal/EventPrincipal.h"
 #include "art/Persistency/Provenance/BranchDescription.h"
 #include "art/Utilities/TypeID.h"
 #include "TBranch.h"
@@ -36,6 +37,15 @@ RootDelayedReader(input::EntryNumber const& entryNumber,
 {
 }
 
+// Recursive: a reader may defer to the next (secondary) reader.
+recursive_mutex &
+RootDelayedReader::
+inputMutex()
+{
+  static recursive_mutex s_mutex;
+  return s_mutex;
+}
+
 void
 RootDelayedReader::
 setGroupFinder_(cet::exempt_ptr<EventPrincipal const> groupFinder)
@@ -54,6 +64,7 @@ unique_ptr<EDProduct>
 RootDelayedReader::
 getProduct_(BranchKey const& bk, TypeID const& ty) const
 {
+  lock_guard<recursive_mutex> lock(inputMutex());
   auto iter = branches_->find(bk);
   if (iter == branches_->end()) {
     assert(nextReader_);
@@ -77,7 +88,15 @@ getProduct_(BranchKey const& bk, TypeID const& ty) const
     be->SetTargetClass(cl->GetName());
   }
 #endif
-  unique_ptr<EDProduct> p(static_cast<EDProduct*>(cl->New()));
+  // With services.scheduler.eventArena.streamedProducts, the product
+  // is made in the arena of its event; EDProduct::operator delete
+  // leaves the memory to the arena.
+  auto const arena = groupFinder_ ?
+    groupFinder_->productArena() :
+    cet::exempt_ptr<MonotonicArena>();
+  unique_ptr<EDProduct> p(static_cast<EDProduct*>(arena ?
+                                                  cl->New(arena->allocate(cl->Size())) :
+                                                  cl->New()));
   EDProduct* pp = p.get();
   br->SetAddress(&pp);
   auto const bytesRead = input::getEntry(br, entryNumber_);
@@ -9,6 +9,7 @@
 #include "art/Persistency/Provenance/BranchType.h"
 #include "cpp0x/memory"
 #include <map>
+#include <mutex>
 #include <string>
 
 class TFile;
@@ -34,6 +35,13 @@ public: // MEMBER FUNCTIONS
                     cet::exempt_ptr<RootInputFile> primaryFile,
                     BranchType branchType, EventID);
 
+  // Held while reading products, which the schedules do from the same
+  // files, and through the same RefCore streamer. Other code reading
+  // products through ROOT off the event loop's thread locks it too.
+  static
+  std::recursive_mutex &
+  inputMutex();
+
 private: // MEMBER FUNCTIONS
 
   virtual
@@ -77,6 +77,7 @@ private:
   virtual std::unique_ptr<EventPrincipal> readEvent_();
   std::unique_ptr<EventPrincipal>
     readEvent_(std::shared_ptr<SubRunPrincipal>);
+  virtual void recycleEvent(std::unique_ptr<EventPrincipal>&&);
   virtual std::shared_ptr<SubRunPrincipal>
     readSubRun(std::shared_ptr<RunPrincipal>);
   virtual std::shared_ptr<SubRunPrincipal> readSubRun_();
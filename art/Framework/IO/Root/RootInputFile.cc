@@ -35,7 +35,9 @@
 #include "Rtypes.h"
 #include "TClass.h"
 #include "TFile.h"
+#include "TLeaf.h"
 #include "TTree.h"
+#include <atomic>
 
 extern "C" {
 #include "sqlite3.h"
@@ -44,6 +46,11 @@ extern "C" {
 using namespace cet;
 using namespace std;
 
+namespace {
+  // For the groupsKey_ of each file.
+  std::atomic<std::uint64_t> lastGroupsKey {0};
+}
+
 namespace art {
 
 RootInputFile::
@@ -59,6 +66,7 @@ RootInputFile(string const& fileName,
               unsigned int treeCacheSize,
               int64_t treeMaxVirtualSize,
               int64_t saveMemoryObjectThreshold,
+              input::ReadAheadConfig const& readAhead,
               bool delayedReadSubRunProducts,
               bool delayedReadRunProducts,
               InputSource::ProcessingMode processingMode,
@@ -85,6 +93,8 @@ RootInputFile(string const& fileName,
   , fiBegin_(fileIndex_.begin())
   , fiEnd_(fiBegin_)
   , fiIter_(fiBegin_)
+  , eventHashIndexRead_(false)
+  , eventPositions_()
   , origEventID_(origEventID)
   , eventsToSkip_(eventsToSkip)
   , whichSubRunsToSkip_(whichSubRunsToSkip)
@@ -103,6 +113,7 @@ RootInputFile(string const& fileName,
   , forcedRunOffset_(forcedRunOffset)
   , eventHistoryTree_(0)
   , history_(new History)
+  , groupsKey_(++lastGroupsKey)
   , branchChildren_(new BranchChildren)
   , duplicateChecker_(duplicateChecker)
   , primaryFile_(primaryFile ? primaryFile : this)
@@ -115,6 +126,7 @@ RootInputFile(string const& fileName,
   , primarySRP_()
   , secondaryRPs_()
   , secondarySRPs_()
+  , openLatency_(0.0)
 {
   secondaryFiles_.resize(secondaryFileNames_.size());
   eventTree_.setCacheSize(treeCacheSize);
@@ -190,9 +202,14 @@ RootInputFile(string const& fileName,
             ("set to \"" + fileFormatVersion_.era_ + "\" "))
         << ".\n";
   }
-  // Merge into the hashed registries.
+  // Merge into the hashed registries. Their keys are hashes of the
+  // content, so anything an earlier file of the job registered is
+  // not parsed again.
   // Parameter Set
   for (auto I = psetMap.cbegin(), E = psetMap.cend(); I != E; ++I) {
+    if (fhicl::ParameterSetRegistry::has(I->first)) {
+      continue;
+    }
     fhicl::ParameterSet pset;
     fhicl::make_ParameterSet(I->second.pset_, pset);
     // Note ParameterSet::id() has the side effect of
@@ -200,7 +217,8 @@ RootInputFile(string const& fileName,
     pset.id();
     fhicl::ParameterSetRegistry::put(pset);
   }
-  // Also need to check MetaData DB if we have one.
+  // Also need to check MetaData DB if we have one. The registry keeps
+  // the imported sets as blobs, parsed only when first asked for.
   if (fileFormatVersion_.value_ >= 5) {
     // Open the DB.
     SQLite3Wrapper sqliteDB(filePtr_.get(), "RootFileDB");
@@ -218,7 +236,12 @@ RootInputFile(string const& fileName,
   fiIter_ = fileIndex_.begin();
   fiBegin_ = fileIndex_.begin();
   fiEnd_ = fileIndex_.end();
-  readEventHistoryTree();
+  // A file without the event history tree is reported as bad on
+  // opening; the tree itself is read only with the first event.
+  if (filePtr_->GetKey(rootNames::eventHistoryTreeName().c_str()) == nullptr) {
+    throw art::Exception(errors::DataCorruption)
+        << "Failed to find the event history tree.\n";
+  }
   // Update transient presence information to match input tree contents.
   auto& prodList = productListHolder_->productList_;
   for (auto I = prodList.begin(), E = prodList.end(); I != E; ++I) {
@@ -232,11 +255,61 @@ RootInputFile(string const& fileName,
     auto const& bd = I->second;
     treePointers_[bd.branchType()]->addBranch(I->first, bd, bd.branchName());
   }
+  eventTree_.setReadAhead(readAhead);
+  if ((treeCacheSize == 0) && (readAhead.depth_ == 0) && rifSequence_) {
+    eventTree_.setAutoCache(rifSequence_->autoCache(),
+                            rifSequence_->learnedCacheBranches());
+  }
   // Determine if this file is fast clonable.
   fastClonable_ = setIfFastClonable(fcip);
   reportOpened();
 }
 
+// Read the event hash index written by RootOutput (if any), for
+// constant-time lookup of events by ID. This is done only on the first
+// such lookup, so files read sequentially never pay for it.
+void
+RootInputFile::
+readEventHashIndex()
+{
+  eventHashIndexRead_ = true;
+  if (noEventSort_) {
+    // The index was written for the file index as sorted on output.
+    return;
+  }
+  auto tree = dynamic_cast<TTree*>(filePtr_->Get(
+                rootNames::eventHashIndexTreeName().c_str()));
+  if (!tree || !tree->GetLeaf("n") || !tree->GetLeaf("slots") ||
+      !tree->GetLeaf("indexSize") || !tree->GetLeaf("indexChecksum")) {
+    return;
+  }
+  Int_t n = 0;
+  vector<Long64_t> chunk(tree->GetLeaf("n")->GetMaximum());
+  Long64_t indexSize = -1;
+  ULong64_t indexChecksum = 0;
+  tree->SetBranchAddress("n", &n);
+  tree->SetBranchAddress("slots", chunk.data());
+  tree->SetBranchAddress("indexSize", &indexSize);
+  tree->SetBranchAddress("indexChecksum", &indexChecksum);
+  FileIndex::EventHashIndex slots;
+  for (Long64_t i = 0, sz = tree->GetEntries(); i != sz; ++i) {
+    input::getEntry(tree, i);
+    if (indexSize != static_cast<Long64_t>(fileIndex_.size())) {
+      // Not written for this file index: read no further.
+      break;
+    }
+    slots.insert(slots.end(), chunk.cbegin(), chunk.cbegin() + n);
+  }
+  tree->ResetBranchAddresses();
+  if (!fileIndex_.adoptEventHashIndex(slots, indexSize, indexChecksum)) {
+    mf::LogWarning("RootInputFile")
+      << "Rebuilding the event hash index of input file "
+      << file_
+      << ":\nthe one in the file does not match the file index as read.\n";
+    fileIndex_.buildEventHashIndex();
+  }
+}
+
 void
 RootInputFile::
 readParentageTree()
@@ -258,9 +331,24 @@ readParentageTree()
   auto pParentageBuffer = &parentageBuffer;
   parentageTree->SetBranchAddress(rootNames::parentageBranchName().c_str(),
                                   &pParentageBuffer);
+  auto idBranch =
+    parentageTree->GetBranch(rootNames::parentageIDBranchName().c_str());
+  auto parentageBranch =
+    parentageTree->GetBranch(rootNames::parentageBranchName().c_str());
+  if (!idBranch || !parentageBranch) {
+    throw art::Exception(errors::FileReadError)
+        << "Missing branch in the Parentage tree.\n";
+  }
+  auto const& registered = ParentageRegistry::get();
   for (Long64_t i = 0, numEntries = parentageTree->GetEntries(); i < numEntries;
        ++i) {
-    input::getEntry(parentageTree, i);
+    // Read the ID alone first: a Parentage registered from an earlier
+    // file need not be read again.
+    input::getEntry(idBranch, i);
+    if (registered.find(idBuffer) != registered.cend()) {
+      continue;
+    }
+    input::getEntry(parentageBranch, i);
     if (idBuffer != parentageBuffer.id()) {
       throw art::Exception(errors::DataCorruption)
           << "Corruption of Parentage tree detected.\n";
@@ -373,6 +461,7 @@ createFileBlock() const
              , fastClonable()
              , file_
              , branchChildren_
+             , openLatency_
            )
          );
 }
@@ -409,6 +498,9 @@ FileIndex::EntryType
 RootInputFile::
 getNextEntryTypeWanted()
 {
+  if ((eventsToSkip_ != 0) && canJumpOverSkippedEvents()) {
+    jumpOverSkippedEvents();
+  }
   auto entryType = getEntryTypeSkippingDups();
   if (entryType == FileIndex::kEnd) {
     return FileIndex::kEnd;
@@ -537,6 +629,9 @@ fillHistory()
   // We could consider doing delayed reading, but because we have to
   // store this History object in a different tree than the event
   // data tree, this is too hard to do in this first version.
+  if (!eventHistoryTree_) {
+    readEventHistoryTree();
+  }
   auto pHistory = history_.get();
   auto eventHistoryBranch = eventHistoryTree_->GetBranch(
                                   rootNames::eventHistoryBranchName().c_str());
@@ -564,27 +659,114 @@ fillRunAuxiliary()
   runTree_.fillAux<RunAuxiliary>(pRunAux);
 }
 
+vector<size_t> const&
+RootInputFile::
+eventPositions() const
+{
+  if (eventPositions_.empty()) {
+    for (auto it = fiBegin_; it != fiEnd_; ++it) {
+      if (it->getEntryType() == FileIndex::kEvent) {
+        eventPositions_.push_back(it - fiBegin_);
+      }
+    }
+  }
+  return eventPositions_;
+}
+
+// The ordinal number of the first event entry at or after it.
+size_t
+RootInputFile::
+eventOrdinal(FileIndex::const_iterator it) const
+{
+  auto const& positions = eventPositions();
+  return lower_bound_all(positions, static_cast<size_t>(it - fiBegin_)) -
+         positions.cbegin();
+}
+
+// Move offset events forward or back by position in the file index,
+// stopping at the first (or past the last) event. Returns the part of
+// offset which could not be used in this file.
 int
 RootInputFile::
 skipEvents(int offset)
 {
-  while ((offset > 0) && (fiIter_ != fiEnd_)) {
-    if (fiIter_->getEntryType() == FileIndex::kEvent) {
-      --offset;
-    }
-    nextEntry();
+  auto const& positions = eventPositions();
+  long const nEvents = positions.size();
+  long ordinal = eventOrdinal(fiIter_);
+  if (offset > 0) {
+    long const n = min<long>(offset, nEvents - ordinal);
+    ordinal += n;
+    offset -= n;
+  }
+  else if (offset < 0) {
+    long const n = min<long>(-offset, ordinal);
+    ordinal -= n;
+    offset += n;
+  }
+  fiIter_ = (ordinal == nEvents) ? fiEnd_ : fiBegin_ + positions[ordinal];
+  return offset;
+}
+
+// Whether the events still to be skipped may be counted purely by
+// position in the file index: nothing which the step-by-step skipping
+// in getNextEntryTypeWanted() would pass over without counting can lie
+// ahead.
+bool
+RootInputFile::
+canJumpOverSkippedEvents() const
+{
+  if ((fiIter_ == fiEnd_) ||
+      (processingMode_ != InputSource::RunsSubRunsAndEvents) ||
+      !whichSubRunsToSkip_.empty() ||
+      (duplicateChecker_.get() && duplicateChecker_->isCheckActive())) {
+    return false;
   }
-  while ((offset < 0) && (fiIter_ != fiBegin_)) {
-    previousEntry();
-    if (fiIter_->getEntryType() == FileIndex::kEvent) {
-      ++offset;
-    }
+  // Events before origEventID_ are not counted.
+  auto const& positions = eventPositions();
+  auto const first = eventOrdinal(fiIter_);
+  return (first == positions.size()) ||
+         !((fiBegin_ + positions[first])->eventID_ < origEventID_);
+}
+
+// Move towards the first event wanted after eventsToSkip_ events, so
+// that only the Run and SubRun entries of that event are read on the
+// way. The Run (or SubRun) entry of that event is the next entry if it
+// is not the current Run (or SubRun); eventsToSkip_ is reduced by the
+// number of events jumped over.
+void
+RootInputFile::
+jumpOverSkippedEvents()
+{
+  auto const& positions = eventPositions();
+  auto const first = eventOrdinal(fiIter_);
+  if (eventsToSkip_ >= positions.size() - first) {
+    eventsToSkip_ -= positions.size() - first;
+    fiIter_ = fiEnd_;
+    return;
   }
-  while ((fiIter_ != fiEnd_) &&
-         (fiIter_->getEntryType() != FileIndex::kEvent)) {
-    nextEntry();
+  auto const wanted = fiBegin_ + positions[first + eventsToSkip_];
+  auto const& wantedID = wanted->eventID_;
+  auto const entryType = fiIter_->getEntryType();
+  auto newIter = fiIter_;
+  if (wantedID.runID() != fiIter_->eventID_.runID()) {
+    newIter = fileIndex_.findRunPosition(wantedID.runID(), true);
   }
-  return offset;
+  else if (entryType == FileIndex::kRun) {
+    // The Run entry of the wanted event comes next.
+  }
+  else if (wantedID.subRunID() != fiIter_->eventID_.subRunID()) {
+    newIter = fileIndex_.findSubRunPosition(wantedID.subRunID(), true);
+  }
+  else if (entryType == FileIndex::kEvent) {
+    newIter = wanted;
+  }
+  if (newIter == fiEnd_ || newIter > wanted) {
+    // No Run or SubRun entry for the event; leave it to the
+    // step-by-step skipping.
+    return;
+  }
+  fiIter_ = newIter;
+  eventsToSkip_ = first + eventsToSkip_ - eventOrdinal(fiIter_);
 }
 
 // readEvent() is responsible for creating, and setting up, the
@@ -602,13 +784,13 @@ skipEvents(int offset)
 //
 unique_ptr<EventPrincipal>
 RootInputFile::
-readEvent()
+readEvent(unique_ptr<EventPrincipal>&& spare)
 {
   assert(fiIter_ != fiEnd_);
   assert(fiIter_->getEntryType() == FileIndex::kEvent);
   assert(fiIter_->eventID_.runID().isValid());
   setAtEventEntry(fiIter_->entry_);
-  auto ep = readCurrentEvent();
+  auto ep = readCurrentEvent(std::move(spare));
   assert(ep);
   assert(eventAux_.run() == fiIter_->eventID_.run() + forcedRunOffset_);
   assert(eventAux_.subRunID() == fiIter_->eventID_.subRunID());
@@ -620,7 +802,7 @@ readEvent()
 // Note: This function neither uses nor sets fiIter_.
 unique_ptr<EventPrincipal>
 RootInputFile::
-readCurrentEvent()
+readCurrentEvent(unique_ptr<EventPrincipal>&& spare)
 {
   unique_ptr<EventPrincipal> ep;
   if (!eventTree_.current()) {
@@ -632,12 +814,28 @@ readCurrentEvent()
   fillHistory();
   overrideRunNumber(const_cast<EventID&>(eventAux_.id()),
                     eventAux_.isRealData());
-  ep.reset(
-    new EventPrincipal(
-      eventAux_, processConfiguration_, history_,
-      eventTree_.makeBranchMapper(),
-      eventTree_.makeDelayedReader(InEvent, eventAux_.id()), 0, nullptr));
-  eventTree_.fillGroups(*ep);
+  // A spare principal keeps its Groups if it was last filled from
+  // this file, saving their construction.
+  if (spare) {
+    ep = std::move(spare);
+    bool const kept =
+      ep->reuse(eventAux_, history_, eventTree_.makeBranchMapper(),
+                eventTree_.makeDelayedReader(InEvent, eventAux_.id()),
+                groupsKey_);
+    if (!kept) {
+      eventTree_.fillGroups(*ep);
+      ep->keepGroupsOnReuse(groupsKey_);
+    }
+  }
+  else {
+    ep.reset(
+      new EventPrincipal(
+        eventAux_, processConfiguration_, history_,
+        eventTree_.makeBranchMapper(),
+        eventTree_.makeDelayedReader(InEvent, eventAux_.id()), 0, nullptr));
+    eventTree_.fillGroups(*ep);
+    ep->keepGroupsOnReuse(groupsKey_);
+  }
   ////////////////////////////////////
   // This code would be activated if one decided to open all secondary
   // files at the beginning of the job, instead of on demand as
@@ -1058,6 +1256,9 @@ bool
 RootInputFile::
 setEntryAtEvent(EventID const& eID, bool exact)
 {
+  if (!eventHashIndexRead_) {
+    readEventHashIndex();
+  }
   fiIter_ = fileIndex_.findEventPosition(eID, exact);
   if (fiIter_ == fiEnd_) {
     return false;
@@ -26,6 +26,7 @@
 #include "cetlib/exempt_ptr.h"
 #include "cpp0x/array"
 #include "cpp0x/memory"
+#include <cstdint>
 #include <map>
 #include <string>
 #include <vector>
@@ -62,6 +63,7 @@ public: // MEMBER FUNCTIONS
                 unsigned int treeCacheSize,
                 int64_t treeMaxVirtualSize,
                 int64_t saveMemoryObjectThreashold,
+                input::ReadAheadConfig const& readAhead,
                 bool delayedReadSubRunProducts,
                 bool delayedReadRunProducts,
                 InputSource::ProcessingMode processingMode,
@@ -82,11 +84,14 @@ public: // MEMBER FUNCTIONS
   void
   close(bool reallyClose);
 
+  // The spare principal, if any, is reused for the event.
   std::unique_ptr<EventPrincipal>
-  readEvent();
+  readEvent(std::unique_ptr<EventPrincipal>&& spare =
+              std::unique_ptr<EventPrincipal>());
 
   std::unique_ptr<EventPrincipal>
-  readCurrentEvent();
+  readCurrentEvent(std::unique_ptr<EventPrincipal>&& spare =
+                     std::unique_ptr<EventPrincipal>());
 
   bool
   readEventForSecondaryFile(EventID eID);
@@ -190,6 +195,14 @@ public: // MEMBER FUNCTIONS
   std::shared_ptr<FileBlock>
   createFileBlock() const;
 
+  // Real time in seconds taken to open the file, reported in its
+  // FileBlock.
+  void
+  setOpenLatency(double seconds)
+  {
+    openLatency_ = seconds;
+  }
+
   bool
   setEntryAtEvent(EventID const& eID, bool exact);
 
@@ -268,6 +281,13 @@ public: // MEMBER FUNCTIONS
   FileIndex::EntryType
   getNextEntryTypeWanted();
 
+  // Number of event entries in the file index.
+  std::size_t
+  eventCount() const
+  {
+    return eventPositions().size();
+  }
+
   std::shared_ptr<FileIndex>
   fileIndexSharedPtr() const
   {
@@ -328,6 +348,21 @@ private:
   void
   readParentageTree();
 
+  void
+  readEventHashIndex();
+
+  std::vector<std::size_t> const&
+  eventPositions() const;
+
+  std::size_t
+  eventOrdinal(FileIndex::const_iterator it) const;
+
+  bool
+  canJumpOverSkippedEvents() const;
+
+  void
+  jumpOverSkippedEvents();
+
   void
   readEventHistoryTree();
 
@@ -364,6 +399,10 @@ private:
   FileIndex::const_iterator fiBegin_;
   FileIndex::const_iterator fiEnd_;
   FileIndex::const_iterator fiIter_;
+  bool eventHashIndexRead_;
+  // Positions in the file index of the event entries, filled on first
+  // use.
+  mutable std::vector<std::size_t> eventPositions_;
   EventID origEventID_;
   EventNumber_t eventsToSkip_;
   std::vector<SubRunID> whichSubRunsToSkip_;
@@ -382,6 +421,8 @@ private:
   int forcedRunOffset_;
   TTree* eventHistoryTree_;
   std::shared_ptr<History> history_;
+  // Identifies the Groups made for the event products of this file.
+  std::uint64_t const groupsKey_;
   std::shared_ptr<BranchChildren> branchChildren_;
   std::shared_ptr<DuplicateChecker> duplicateChecker_;
   cet::exempt_ptr<RootInputFile> primaryFile_;
@@ -405,6 +446,7 @@ private:
   // never subjected to merging of their data products.
   std::vector<std::shared_ptr<Principal>> secondaryRPs_;
   std::vector<std::shared_ptr<Principal>> secondarySRPs_;
+  double openLatency_;
 
 };
 
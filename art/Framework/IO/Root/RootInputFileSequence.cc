@@ -7,14 +7,20 @@
 #include "art/Framework/IO/Root/DuplicateChecker.h"
 #include "art/Framework/IO/Root/RootInputFile.h"
 #include "art/Framework/IO/Root/RootTree.h"
+#include "art/Framework/IO/Root/rootNames.h"
 #include "art/Framework/Principal/EventPrincipal.h"
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "art/Persistency/Provenance/BranchIDListHelper.h"
 #include "art/Persistency/Provenance/MasterProductRegistry.h"
 #include "cetlib/container_algorithms.h"
+#include "cetlib/cpu_timer.h"
 #include "fhiclcpp/ParameterSet.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
+#include "TEnv.h"
 #include "TFile.h"
+#include "TTree.h"
+#include "TTreeCache.h"
+#include "TTreeCacheUnzip.h"
 #include <ctime>
 #include <map>
 #include <set>
@@ -54,6 +60,14 @@ RootInputFileSequence(fhicl::ParameterSet const& pset,
   , treeMaxVirtualSize_(pset.get<int64_t>("treeMaxVirtualSize", -1))
   , saveMemoryObjectThreshold_(pset.get<int64_t>("saveMemoryObjectThreshold",
                                -1))
+  , readAhead_(pset.get<unsigned int>("readAheadDepth", 0U),
+               pset.get<unsigned int>("readAheadMaxBytes", 0U),
+               pset.get<unsigned int>("readAheadLearnEntries", 0U))
+  , autoCache_(pset.get<unsigned int>("cacheLearnEntries", 10U),
+               pset.get<unsigned int>("cacheEntries", 100U),
+               pset.get<unsigned int>("cacheMaxBytes", 30000000U))
+  , learnedCacheBranches_()
+  , reportTreeCache_(pset.get<bool>("reportTreeCache", false))
   , delayedReadSubRunProducts_(pset.get<bool>("delayedReadSubRunProducts",
                                false))
   , delayedReadRunProducts_(pset.get<bool>("delayedReadRunProducts", false))
@@ -69,6 +83,8 @@ RootInputFileSequence(fhicl::ParameterSet const& pset,
   //                      vector<vector<string>>()))
   , secondaryFileNames_()
   , mpr_(mpr)
+  , recycleEvents_(pset.get<bool>("recycleEvents", true))
+  , spareEvents_()
 {
   auto const& primaryFileNames = catalog_.fileSources();
   auto items = pset.get<vector<fhicl::ParameterSet>>("secondaryFileNames",
@@ -162,6 +178,23 @@ RootInputFileSequence(fhicl::ParameterSet const& pset,
   if (matchMode == string("strict")) {
     matchMode_ = BranchDescription::Strict;
   }
+  if (readAhead_.depth_ > 0) {
+    // Have the tree caches fill from the file in a background thread,
+    // so that the event loop is not blocked on the network reads.
+    // Must be set before the files are opened.
+    gEnv->SetValue("TFile.AsyncPrefetching", 1);
+    // The tree cache settings below are static in ROOT: they apply to
+    // every tree cache of the process, so they are set once here
+    // rather than for each tree or entry.
+    TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+    TTreeCacheUnzip::SetUnzipRelBufferSize(1.0);
+    if (readAhead_.learnEntries_ > 0) {
+      TTreeCache::SetLearnEntries(readAhead_.learnEntries_);
+    }
+  }
+  else if ((treeCacheSize_ == 0) && (autoCache_.learnEntries_ > 0)) {
+    TTreeCache::SetLearnEntries(autoCache_.learnEntries_);
+  }
   while (catalog_.getNextFile()) {
     initFile(skipBadFiles_, /*initMPR=*/true);
     if (rootFile_) {
@@ -290,6 +323,10 @@ closeFile_()
   if (rootFile_) {
     // Account for events skipped in the file.
     eventsToSkip_ = rootFile_->eventsToSkip();
+    if (reportTreeCache_) {
+      rootFile_->eventTree().reportCacheUse(rootFile_->file());
+    }
+    rootFile_->eventTree().updateLearnedBranches(learnedCacheBranches_);
     {
       rootFile_->close(primary());
     }
@@ -308,6 +345,8 @@ initFile(bool skipBadFiles, bool initMPR/*=false*/)
   // close the currently open file, any, and delete the RootInputFile object.
   closeFile_();
   std::shared_ptr<TFile> filePtr;
+  cet::cpu_timer openTimer;
+  openTimer.start();
   try {
     logFileAction("  Initiating request to open file ",
                   catalog_.currentFile().fileName());
@@ -351,6 +390,7 @@ initFile(bool skipBadFiles, bool initMPR/*=false*/)
                 treeCacheSize_,
                 treeMaxVirtualSize_,
                 saveMemoryObjectThreshold_,
+                readAhead_,
                 delayedReadSubRunProducts_,
                 delayedReadRunProducts_,
                 processingMode_,
@@ -366,6 +406,8 @@ initFile(bool skipBadFiles, bool initMPR/*=false*/)
                 empty_vs :
                 secondaryFileNames_.at(catalog_.currentIndex()),
                 this);
+  openTimer.stop();
+  rootFile_->setOpenLatency(openTimer.realTime());
   assert(catalog_.currentIndex() != InputFileCatalog::indexEnd);
   if (catalog_.currentIndex() + 1 > fileIndexes_.size()) {
     fileIndexes_.resize(catalog_.currentIndex() + 1);
@@ -439,6 +481,7 @@ openSecondaryFile(int idx, string const& name,
      treeCacheSize_,
      treeMaxVirtualSize_,
      saveMemoryObjectThreshold_,
+     readAhead_,
      delayedReadSubRunProducts_,
      delayedReadRunProducts_,
      processingMode_,
@@ -469,10 +512,77 @@ nextFile()
     // no more files
     return false;
   }
+  if ((eventsToSkip_ != 0) && canPassOverFilesToSkip()) {
+    EntryNumber nEvents = eventsToSkip_;
+    passOverFiles(nEvents);
+    eventsToSkip_ = nEvents;
+  }
   initFile(skipBadFiles_);
   return true;
 }
 
+// The number of events in the current file of the catalog: from its
+// file index if it has been opened before, otherwise from the number of
+// entries of its Events tree. Returns -1 if the file cannot be read.
+RootInputFileSequence::EntryNumber
+RootInputFileSequence::
+currentFileEventCount()
+{
+  auto const idx = catalog_.currentIndex();
+  if (idx < fileIndexes_.size() && fileIndexes_[idx]) {
+    return count_if(fileIndexes_[idx]->cbegin(), fileIndexes_[idx]->cend(),
+                    [](FileIndex::Element const& el) {
+                      return el.getEntryType() == FileIndex::kEvent;
+                    });
+  }
+  EntryNumber result = -1;
+  try {
+    unique_ptr<TFile> filePtr(TFile::Open(catalog_.currentFile().fileName().c_str()));
+    if (filePtr && !filePtr->IsZombie()) {
+      auto tree = dynamic_cast<TTree*>(filePtr->Get(rootNames::eventTreeName().c_str()));
+      if (tree) {
+        result = tree->GetEntries();
+      }
+      filePtr->Close();
+    }
+  }
+  catch (cet::exception const&) {
+    // Leave it to initFile() to report.
+  }
+  return result;
+}
+
+// Starting with the current file of the catalog, pass over files
+// holding no more than nEvents events, reducing nEvents by the number
+// in each. The last file of the catalog is never passed over.
+void
+RootInputFileSequence::
+passOverFiles(EntryNumber& nEvents)
+{
+  while (catalog_.hasNextFile()) {
+    auto const nInFile = currentFileEventCount();
+    if ((nInFile < 0) || (nInFile > nEvents)) {
+      return;
+    }
+    nEvents -= nInFile;
+    logFileAction("  Skipping all events of file ",
+                  catalog_.currentFile().fileName());
+    catalog_.getNextFile();
+  }
+}
+
+// Whether events to skip may be counted a whole file at a time: no
+// event of a file not opened could have been passed over uncounted.
+bool
+RootInputFileSequence::
+canPassOverFilesToSkip() const
+{
+  return (processingMode_ == InputSource::RunsSubRunsAndEvents) &&
+         whichSubRunsToSkip_.empty() &&
+         (origEventID_ == EventID::firstEvent()) &&
+         (!duplicateChecker_.get() || duplicateChecker_->isCheckDisabled());
+}
+
 bool
 RootInputFileSequence::
 previousFile()
@@ -504,7 +614,7 @@ RootInputFileSequence::
 readCurrentEvent()
 {
   rootFileForLastReadEvent_ = rootFile_;
-  return rootFile_->readCurrentEvent();
+  return rootFile_->readCurrentEvent(takeSpareEvent_());
 }
 
 unique_ptr<EventPrincipal>
@@ -568,7 +678,29 @@ readEvent_()
   // Delayed Reader when it is asked to do so.
   //
   rootFileForLastReadEvent_ = rootFile_;
-  return rootFile_->readEvent();
+  return rootFile_->readEvent(takeSpareEvent_());
+}
+
+void
+RootInputFileSequence::
+recycleEvent(std::unique_ptr<EventPrincipal>&& ep)
+{
+  if (!recycleEvents_) {
+    return;
+  }
+  spareEvents_.emplace_back(std::move(ep));
+}
+
+unique_ptr<EventPrincipal>
+RootInputFileSequence::
+takeSpareEvent_()
+{
+  unique_ptr<EventPrincipal> result;
+  if (!spareEvents_.empty()) {
+    result = std::move(spareEvents_.back());
+    spareEvents_.pop_back();
+  }
+  return result;
 }
 
 std::shared_ptr<SubRunPrincipal>
@@ -744,8 +876,15 @@ skip(int offset)
 {
   while (offset != 0) {
     offset = rootFile_->skipEvents(offset);
-    if (offset > 0 && !nextFile()) {
-      return;
+    if (offset > 0) {
+      if (!catalog_.getNextFile()) {
+        return;
+      }
+      EntryNumber nEvents = offset;
+      passOverFiles(nEvents);
+      offset = nEvents;
+      initFile(skipBadFiles_);
+      continue;
     }
     if (offset < 0 && !previousFile()) {
       return;
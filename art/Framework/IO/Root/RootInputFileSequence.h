@@ -98,6 +98,11 @@ public: // MEMBER FUNCTIONS
   std::unique_ptr<EventPrincipal>
   readEvent_();
 
+  // Keep an event principal to be reused for a later event, unless
+  // disabled by the recycleEvents parameter (true by default).
+  void
+  recycleEvent(std::unique_ptr<EventPrincipal>&&);
+
   RootInputFileSharedPtr
   rootFileForLastReadEvent() const
   {
@@ -158,6 +163,25 @@ public: // MEMBER FUNCTIONS
     return saveMemoryObjectThreshold_;
   };
 
+  input::ReadAheadConfig const&
+  readAhead() const
+  {
+    return readAhead_;
+  }
+
+  input::AutoCacheConfig const&
+  autoCache() const
+  {
+    return autoCache_;
+  }
+
+  // The event branches read in the last file, for its tree cache.
+  std::vector<std::string> const&
+  learnedCacheBranches() const
+  {
+    return learnedCacheBranches_;
+  }
+
   bool
   delayedReadSubRunProducts() const
   {
@@ -187,12 +211,24 @@ private: // MEMBER FUNCTIONS
   bool
   previousFile();
 
+  EntryNumber
+  currentFileEventCount();
+
+  void
+  passOverFiles(EntryNumber& nEvents);
+
+  bool
+  canPassOverFilesToSkip() const;
+
   void
   rewindFile();
 
   std::unique_ptr<EventPrincipal>
   readCurrentEvent();
 
+  std::unique_ptr<EventPrincipal>
+  takeSpareEvent_();
+
   std::vector<FileCatalogItem> const&
   fileCatalogItems() const;
 
@@ -221,6 +257,10 @@ private: // MEMBER DATA
   unsigned int const treeCacheSize_;
   int64_t const treeMaxVirtualSize_;
   int64_t const saveMemoryObjectThreshold_;
+  input::ReadAheadConfig const readAhead_;
+  input::AutoCacheConfig const autoCache_;
+  std::vector<std::string> learnedCacheBranches_;
+  bool const reportTreeCache_;
   bool const delayedReadSubRunProducts_;
   bool const delayedReadRunProducts_;
   int forcedRunOffset_;
@@ -234,6 +274,9 @@ private: // MEMBER DATA
   ProcessConfiguration const& processConfiguration_;
   std::vector<std::vector<std::string>> secondaryFileNames_;
   MasterProductRegistry& mpr_;
+  // Principals of past events, from recycleEvent().
+  bool const recycleEvents_;
+  std::vector<std::unique_ptr<EventPrincipal>> spareEvents_;
 
 };
 
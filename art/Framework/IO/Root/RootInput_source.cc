@@ -259,6 +259,13 @@ readEvent_(std::shared_ptr<SubRunPrincipal> srp)
   }
 }
 
+void
+RootInput::
+recycleEvent(std::unique_ptr<EventPrincipal>&& ep)
+{
+  primaryFileSequence_->recycleEvent(std::move(ep));
+}
+
 std::unique_ptr<EventPrincipal>
 RootInput::
 readEvent_()
@@ -15,6 +15,7 @@
 #include "art/Framework/IO/FileStatsCollector.h"
 #include "boost/scoped_ptr.hpp"
 #include "fhiclcpp/ParameterSet.h"
+#include <cstddef>
 #include <string>
 
 class TTree;
@@ -100,6 +101,15 @@ private: // MEMBER FUNCTIONS
     return dropMetaDataForDroppedData_;
   }
 
+  bool const&
+  writeEventHashIndex() const
+  {
+    return writeEventHashIndex_;
+  }
+
+  void
+  endJob() override;
+
   void
   openFile(FileBlock const&) override;
 
@@ -182,6 +192,7 @@ private:
   bool dropAllSubRuns_;
   DropMetaData dropMetaData_;
   bool dropMetaDataForDroppedData_;
+  bool const writeEventHashIndex_;
   std::string const moduleLabel_;
   int inputFileCount_;
   boost::scoped_ptr<RootOutputFile> rootOutputFile_;
@@ -189,6 +200,9 @@ private:
   std::string const filePattern_;
   std::string tmpDir_;
   std::string lastClosedFileName_;
+  // Totals over all output files, for the end-of-job summary.
+  std::size_t dummyProductsCreated_;
+  std::size_t dummyProductsReused_;
 
 };
 
@@ -45,6 +45,7 @@
 #include "TTree.h"
 #include "TBranchElement.h"
 #include <iomanip>
+#include <mutex>
 #include <sstream>
 #include <utility>
 #include <vector>
@@ -68,6 +69,14 @@ insert_md_row(sqlite3_stmt* stmt, pair<string, string> const& kv)
   sqlite3_reset(stmt);
 }
 
+// Shared by all output files.
+mutex&
+gatherMutex()
+{
+  static mutex m;
+  return m;
+}
+
 } // unnamed namespace
 
 namespace art {
@@ -85,6 +94,7 @@ RootOutputFile(RootOutput* om, string const& fileName)
   , runEntryNumber_(0LL)
   , metaDataTree_(nullptr)
   , fileIndexTree_(nullptr)
+  , eventHashIndexTree_(nullptr)
   , parentageTree_(nullptr)
   , eventHistoryTree_(nullptr)
   , pEventAux_(new EventAuxiliary)
@@ -113,6 +123,11 @@ RootOutputFile(RootOutput* om, string const& fileName)
   , metaDataHandle_(filePtr_.get(), "RootFileDB",
                     SQLITE_OPEN_CREATE | SQLITE_OPEN_READWRITE)
   , selectedOutputItemList_()
+  , dummyProducts_()
+  , dummyProductsReused_(0)
+  , parentsCache_()
+  , ancestorVisits_()
+  , ancestorStamp_(0)
 {
   treePointers_[InEvent] = &eventTree_;
   treePointers_[InSubRun] = &subRunTree_;
@@ -122,6 +137,10 @@ RootOutputFile(RootOutput* om, string const& fileName)
                   rootNames::metaDataTreeName(), 0);
   fileIndexTree_ = RootOutputTree::makeTTree(filePtr_.get(),
                    rootNames::fileIndexTreeName(), 0);
+  if (om_->writeEventHashIndex()) {
+    eventHashIndexTree_ = RootOutputTree::makeTTree(filePtr_.get(),
+                          rootNames::eventHashIndexTreeName(), 0);
+  }
   parentageTree_ = RootOutputTree::makeTTree(filePtr_.get(),
                    rootNames::parentageTreeName(), 0);
   // Create the tree that will carry (event) History objects.
@@ -395,6 +414,37 @@ writeFileIndex()
     findexElemPtr = &entry;
     b->Fill();
   }
+  if (eventHashIndexTree_) {
+    writeEventHashIndex();
+  }
+}
+
+void
+RootOutputFile::
+writeEventHashIndex()
+{
+  // The slots of the hash table are written in chunks, each entry of
+  // the tree holding a variable-length array of up to chunkSize slots
+  // and the size and checksum of the file index they were built for.
+  size_t const chunkSize = 4096;
+  fileIndex_.buildEventHashIndex();
+  auto const& slots = fileIndex_.eventHashIndex();
+  Int_t n = 0;
+  vector<Long64_t> chunk(chunkSize);
+  Long64_t indexSize = fileIndex_.size();
+  ULong64_t indexChecksum = fileIndex_.checksum();
+  eventHashIndexTree_->Branch("n", &n, "n/I");
+  eventHashIndexTree_->Branch("slots", chunk.data(), "slots[n]/L");
+  eventHashIndexTree_->Branch("indexSize", &indexSize, "indexSize/L");
+  eventHashIndexTree_->Branch("indexChecksum", &indexChecksum, "indexChecksum/l");
+  for (size_t i = 0, sz = slots.size(); i < sz; i += chunkSize) {
+    n = min(chunkSize, sz - i);
+    copy(slots.cbegin() + i, slots.cbegin() + i + n, chunk.begin());
+    if (eventHashIndexTree_->Fill() <= 0) {
+      throw art::Exception(art::errors::FatalRootError)
+          << "Failed to fill the EventHashIndex tree.\n";
+    }
+  }
 }
 
 void
@@ -599,6 +649,9 @@ finishEndFile()
   metaDataTree_->SetEntries(-1);
   RootOutputTree::writeTTree(metaDataTree_);
   RootOutputTree::writeTTree(fileIndexTree_);
+  if (eventHashIndexTree_) {
+    RootOutputTree::writeTTree(eventHashIndexTree_);
+  }
   RootOutputTree::writeTTree(parentageTree_);
   // Write out the tree corresponding to each BranchType
   for (int i = InEvent; i < NumBranchTypes; ++i) {
@@ -612,6 +665,18 @@ finishEndFile()
   filePtr_.reset();
 }
 
+vector<BranchID> const&
+RootOutputFile::
+parentsOf(ProductProvenance const& prov)
+{
+  auto I = parentsCache_.find(prov.parentageID());
+  if (I == parentsCache_.end()) {
+    I = parentsCache_.emplace(prov.parentageID(),
+                              prov.parentage().parents()).first;
+  }
+  return I->second;
+}
+
 void
 RootOutputFile::
 insertAncestors(ProductProvenance const& iGetParents,
@@ -623,28 +688,67 @@ insertAncestors(ProductProvenance const& iGetParents,
   if (om_->dropMetaDataForDroppedData()) {
     return;
   }
-  auto parentIDs = iGetParents.parentage().parents();
-  for (auto I = parentIDs.cbegin(), E = parentIDs.cend(); I != E; ++I) {
-    branchesWithStoredHistory_.insert(*I);
-    auto info = principal.branchMapper().branchToProductProvenance(*I);
-    if (!info || om_->dropMetaData() != RootOutput::DropNone) {
-      continue;
-    }
-    auto bd = principal.getForOutput(info->branchID(), false).desc();
-    if (bd && bd->produced() && oToFill.insert(*info).second) {
-      // FIXME: Remove recursion!
-      insertAncestors(*info, principal, oToFill);
+  // Walk the parentage graph depth first, keeping the provenances
+  // still to be expanded on an explicit stack.  A branch is looked at
+  // no more than once per principal, however many of the kept
+  // products it is an ancestor of.
+  vector<ProductProvenance const*> pending { &iGetParents };
+  while (!pending.empty()) {
+    auto const& prov = *pending.back();
+    pending.pop_back();
+    for (auto const& bid : parentsOf(prov)) {
+      auto& stamp = ancestorVisits_[bid.id()];
+      if (stamp == ancestorStamp_) {
+        continue;
+      }
+      stamp = ancestorStamp_;
+      branchesWithStoredHistory_.insert(bid);
+      auto info = principal.branchMapper().branchToProductProvenance(bid);
+      if (!info || om_->dropMetaData() != RootOutput::DropNone) {
+        continue;
+      }
+      auto bd = principal.getForOutput(info->branchID(), false).desc();
+      if (bd && bd->produced() && oToFill.insert(*info).second) {
+        pending.push_back(info.get());
+      }
     }
   }
 }
 
+EDProduct const*
+RootOutputFile::
+dummyProduct(BranchDescription const& bd)
+{
+  auto I = dummyProducts_.find(bd.branchID());
+  if (I != dummyProducts_.end()) {
+    ++dummyProductsReused_;
+    return I->second.get();
+  }
+  auto name = bd.wrappedCintName().c_str();
+  TClass* cp = TClass::GetClass(name);
+  if (cp == nullptr) {
+    throw art::Exception(art::errors::DictionaryNotFound)
+        << "TClass::GetClass() returned null pointer for name: "
+        << name
+        << '\n';
+  }
+  unique_ptr<EDProduct> dummy(reinterpret_cast<EDProduct*>(cp->New()));
+  return dummyProducts_.emplace(bd.branchID(), move(dummy)).first->second.get();
+}
+
 void
 RootOutputFile::
 fillBranches(BranchType const& bt, Principal const& principal,
              vector<ProductProvenance>* vpp)
 {
-  vector<unique_ptr<EDProduct>> dummies;
   bool const fastCloning = (bt == InEvent) && currentlyFastCloning_;
+  // Output modules may be run concurrently on the same principal (see
+  // services.scheduler.parallelOutput): serialize the gathering of
+  // products and provenance, but not the filling of the trees, where
+  // the compression is done.
+  unique_lock<mutex> gatherLock(gatherMutex());
+  // Start a new generation of ancestor visit marks for this principal.
+  ++ancestorStamp_;
   set<ProductProvenance> keptProv;
   for (auto const& val : selectedOutputItemList_[bt]) {
     auto const& bd = val.branchDescription_;
@@ -680,24 +784,12 @@ fillBranches(BranchType const& bt, Principal const& principal,
     if (resolveProd) {
       if (product == nullptr) {
         // No such product in the event, so use a dummy product.
-        // FIXME: Can we cache these dummy products so that we do not
-        // FIXME: create them for every event?
-        auto name = bd->wrappedCintName().c_str();
-        TClass* cp = TClass::GetClass(name);
-        if (cp == nullptr) {
-          throw art::Exception(art::errors::DictionaryNotFound)
-              << "TClass::GetClass() returned null pointer for name: "
-              << name
-              << '\n';
-        }
-        unique_ptr<EDProduct> dummy(reinterpret_cast<EDProduct*>(cp->New()));
-        product = dummy.get();
-        // Make sure the dummies outlive the fillTree call.
-        dummies.emplace_back(move(dummy));
+        product = dummyProduct(*bd);
       }
       val.product_ = product;
     }
   }
+  gatherLock.unlock();
   vpp->assign(keptProv.begin(), keptProv.end());
   treePointers_[bt]->fillTree();
   vpp->clear();
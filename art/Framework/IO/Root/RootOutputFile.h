@@ -13,12 +13,14 @@
 #include "art/Framework/Core/Frameworkfwd.h"
 #include "art/Framework/IO/Root/RootOutput.h"
 #include "art/Framework/IO/Root/RootOutputTree.h"
+#include "art/Persistency/Common/EDProduct.h"
 #include "art/Persistency/Provenance/BranchDescription.h"
 #include "art/Persistency/Provenance/BranchID.h"
 #include "art/Persistency/Provenance/BranchType.h"
 #include "art/Persistency/Provenance/FileIndex.h"
 #include "art/Persistency/Provenance/ParameterSetBlob.h"
 #include "art/Persistency/Provenance/ParameterSetMap.h"
+#include "art/Persistency/Provenance/ParentageID.h"
 #include "art/Persistency/Provenance/ProductProvenance.h"
 #include "art/Persistency/Provenance/Selections.h"
 #include "art/Persistency/RootDB/SQLite3Wrapper.h"
@@ -27,8 +29,11 @@
 #include "cpp0x/array"
 #include "cpp0x/memory"
 #include <array>
+#include <cstddef>
 #include <map>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class TFile;
@@ -120,6 +125,7 @@ public: // MEMBER FUNCTIONS
   void writeRun(RunPrincipal const&);
   void writeFileFormatVersion();
   void writeFileIndex();
+  void writeEventHashIndex();
   void writeEventHistory();
   void writeProcessConfigurationRegistry();
   void writeProcessHistoryRegistry();
@@ -144,6 +150,18 @@ public: // MEMBER FUNCTIONS
     return file_;
   }
 
+  // Number of dummy products made for missing products, and number
+  // of times one of them was reused rather than made anew.
+  std::size_t dummyProductsCreated() const
+  {
+    return dummyProducts_.size();
+  }
+
+  std::size_t dummyProductsReused() const
+  {
+    return dummyProductsReused_;
+  }
+
 private: // MEMBER FUNCTIONS
 
   void
@@ -153,6 +171,8 @@ private: // MEMBER FUNCTIONS
                     std::vector<ProductProvenance>*);
   void insertAncestors(ProductProvenance const&, Principal const&,
                        std::set<ProductProvenance>&);
+  std::vector<BranchID> const& parentsOf(ProductProvenance const&);
+  EDProduct const* dummyProduct(BranchDescription const&);
 
 private: // MEMBER DATA
 
@@ -166,6 +186,7 @@ private: // MEMBER DATA
   FileIndex::EntryNumber_t runEntryNumber_;
   TTree* metaDataTree_;
   TTree* fileIndexTree_;
+  TTree* eventHashIndexTree_;
   TTree* parentageTree_;
   TTree* eventHistoryTree_;
   EventAuxiliary const* pEventAux_;
@@ -186,6 +207,17 @@ private: // MEMBER DATA
   std::set<BranchID> branchesWithStoredHistory_;
   SQLite3Wrapper metaDataHandle_;
   OutputItemListArray selectedOutputItemList_;
+  // Default-constructed products written in place of missing ones,
+  // made on first use and kept for the lifetime of the file.
+  std::map<BranchID, std::unique_ptr<EDProduct>> dummyProducts_;
+  std::size_t dummyProductsReused_;
+  // Parent BranchIDs of each parentage seen, kept across events so
+  // that each is obtained from the registry only once.
+  std::map<ParentageID, std::vector<BranchID>> parentsCache_;
+  // Value of ancestorStamp_ when each branch was last visited by
+  // insertAncestors(), avoiding clearing a visited set per principal.
+  std::unordered_map<BranchID::value_type, unsigned> ancestorVisits_;
+  unsigned ancestorStamp_;
 
 };
 
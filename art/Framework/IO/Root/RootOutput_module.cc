@@ -8,6 +8,8 @@
 #include "art/Framework/Principal/EventPrincipal.h"
 #include "art/Framework/Principal/RunPrincipal.h"
 #include "art/Framework/Principal/SubRunPrincipal.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "art/Framework/Services/System/TriggerNamesService.h"
 #include "art/Persistency/Provenance/FileFormatVersion.h"
 #include "art/Persistency/Provenance/ProductMetaData.h"
 #include "art/Utilities/Exception.h"
@@ -15,6 +17,7 @@
 #include "art/Utilities/parent_path.h"
 #include "cpp0x/utility"
 #include "fhiclcpp/ParameterSet.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
 #include <iomanip>
 #include <sstream>
 
@@ -68,6 +71,7 @@ RootOutput(ParameterSet const& ps)
   , dropMetaData_(DropNone)
   , dropMetaDataForDroppedData_(ps.get<bool>(
                                   "dropMetaDataForDroppedData", false))
+  , writeEventHashIndex_(ps.get<bool>("writeEventHashIndex", false))
   , moduleLabel_(ps.get<string>("module_label"))
   , inputFileCount_(0)
   , rootOutputFile_()
@@ -75,6 +79,8 @@ RootOutput(ParameterSet const& ps)
   , filePattern_(ps.get<string>("fileName"))
   , tmpDir_(ps.get<string>("tmpDir", parent_path(filePattern_)))
   , lastClosedFileName_()
+  , dummyProductsCreated_(0)
+  , dummyProductsReused_(0)
 {
   if (fastCloning_ && !wantAllEvents()) {
     fastCloning_ = false;
@@ -119,6 +125,21 @@ RootOutput(ParameterSet const& ps)
   }
 }
 
+void
+RootOutput::
+endJob()
+{
+  if (!ServiceHandle<TriggerNamesService>()->wantSummary()) {
+    return;
+  }
+  mf::LogAbsolute("ArtSummary")
+      << "RootOutput " << moduleLabel_
+      << ": dummy products for missing products created = "
+      << dummyProductsCreated_
+      << " reused = "
+      << dummyProductsReused_;
+}
+
 void
 RootOutput::
 openFile(FileBlock const& fb)
@@ -186,7 +207,7 @@ respondToOpenInputFile(FileBlock const& fb)
       fastCloneThisOne = false;
     }
     rootOutputFile_->beginInputFile(fb, fastCloneThisOne && fastCloning_);
-    fstats_.recordInputFile(fb.fileName());
+    fstats_.recordInputFile(fb.fileName(), fb.openLatency());
   }
 }
 
@@ -327,6 +348,8 @@ RootOutput::
 finishEndFile()
 {
   rootOutputFile_->finishEndFile();
+  dummyProductsCreated_ += rootOutputFile_->dummyProductsCreated();
+  dummyProductsReused_ += rootOutputFile_->dummyProductsReused();
   fstats_.recordFileClose();
   lastClosedFileName_ = PostCloseFileRenamer(fstats_).maybeRenameFile(
                           rootOutputFile_->currentFileName(), filePattern_);
@@ -6,11 +6,15 @@
 #include "art/Framework/Principal/Provenance.h"
 #include "art/Persistency/Provenance/BranchDescription.h"
 #include "art/Utilities/WrappedClassName.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
 #include "Rtypes.h"
 #include "TFile.h"
+#include "TFileCacheRead.h"
+#include "TObjArray.h"
 #include "TTreeCache.h"
 #include "TTreeIndex.h"
 #include "TVirtualIndex.h"
+#include <algorithm>
 #include <iostream>
 #include <utility>
 
@@ -32,6 +36,10 @@ TBranch* getProductProvenanceBranch(TTree* tree, BranchType const& branchType)
   return branch;
 }
 
+// The branches of a cache carried over from an earlier file are
+// learned again if fewer reads than this are served by the cache.
+double const minCacheHitRate = 0.99;
+
 } // unnamed namespace
 
 RootTree::
@@ -50,6 +58,10 @@ RootTree(std::shared_ptr<TFile> filePtr, BranchType const& branchType,
   , branchNames_()
   , branches_(new BranchMap)
   , primaryFile_(primaryFile)
+  , learnEntries_(0)
+  , autoCache_()
+  , cacheBranches_()
+  , autoCacheSized_(false)
 {
   if (filePtr_) {
     tree_ = static_cast<TTree*>(filePtr->Get(
@@ -157,6 +169,155 @@ setCacheSize(unsigned int cacheSize) const
   tree_->SetCacheSize(static_cast<Long64_t>(cacheSize));
 }
 
+// While entry N is being processed, have ROOT read and decompress the
+// baskets of the entries following it.  The tree cache is sized to
+// hold the compressed data of config.depth_ further entries of the
+// branches we read, and is served by an unzipping cache whose helper
+// thread decompresses the baskets ahead of their use.  The memory
+// budget, if any, is split equally between the compressed cache and
+// the unzip buffer.
+void
+RootTree::
+setReadAhead(input::ReadAheadConfig const& config)
+{
+  if ((config.depth_ == 0) || (entries_ == 0)) {
+    return;
+  }
+  Long64_t zipBytes = auxBranch_->GetZipBytes("*");
+  for (auto const& val : *branches_) {
+    if (val.second.productBranch_) {
+      zipBytes += val.second.productBranch_->GetZipBytes("*");
+    }
+  }
+  Long64_t cacheSize = (config.depth_ + 1) * (zipBytes / entries_ + 1);
+  if ((config.maxBytes_ > 0) &&
+      (cacheSize > static_cast<Long64_t>(config.maxBytes_ / 2))) {
+    cacheSize = config.maxBytes_ / 2;
+  }
+  if (TFileCacheRead* fc = filePtr_->GetCacheRead(tree_)) {
+    // Never shrink a cache configured explicitly by cacheSize.
+    cacheSize = std::max(cacheSize,
+                         static_cast<Long64_t>(fc->GetBufferSize()));
+  }
+  // Parallel unzipping is enabled once for the process by
+  // RootInputFileSequence.
+  tree_->SetCacheSize(cacheSize);
+  learnEntries_ = config.learnEntries_;
+  if (TTreeCache* tc = dynamic_cast<TTreeCache*>(
+                         filePtr_->GetCacheRead(tree_))) {
+    tc->SetEntryRange(0, entries_);
+  }
+}
+
+// Without a configured cacheSize, the cache holds only the branches
+// actually read. They are learned over the first entries of the file,
+// or taken from the previous file when all of them are present in
+// this one; the cache is then resized to hold config.entries_ entries
+// of them. A carried-over set that the reads of the file then miss is
+// dropped by updateLearnedBranches(), so that the next file learns
+// again.
+void
+RootTree::
+setAutoCache(input::AutoCacheConfig const& config,
+             std::vector<std::string> const& learnedBranches)
+{
+  if ((config.learnEntries_ == 0) || (config.maxBytes_ == 0) ||
+      (entries_ == 0)) {
+    return;
+  }
+  autoCache_ = config;
+  for (auto const& name : learnedBranches) {
+    TBranch* branch = tree_->GetBranch(name.c_str());
+    if (!branch) {
+      cacheBranches_.clear();
+      break;
+    }
+    cacheBranches_.push_back(branch);
+  }
+  learnEntries_ = cacheBranches_.empty() ? config.learnEntries_ : 0;
+  tree_->SetCacheSize(static_cast<Long64_t>(config.maxBytes_));
+  if (TTreeCache* tc = dynamic_cast<TTreeCache*>(
+                         filePtr_->GetCacheRead(tree_))) {
+    tc->SetEntryRange(0, entries_);
+  }
+}
+
+void
+RootTree::
+sizeAutoCache_(TTreeCache* tc)
+{
+  autoCacheSized_ = true;
+  Long64_t zipBytes = 0;
+  if (TObjArray const* branches = tc->GetCachedBranches()) {
+    // Split branches are listed with their sub-branches.
+    for (Int_t i = 0, n = branches->GetEntriesFast(); i != n; ++i) {
+      zipBytes += static_cast<TBranch*>(branches->UncheckedAt(i))->GetZipBytes();
+    }
+  }
+  if (zipBytes == 0) {
+    return;
+  }
+  Long64_t const perEntry = zipBytes / entries_ + 1;
+  Long64_t cacheSize = std::min(perEntry * autoCache_.entries_,
+                                static_cast<Long64_t>(autoCache_.maxBytes_));
+  cacheSize = std::max(cacheSize, perEntry);
+  tc->SetBufferSize(static_cast<Int_t>(cacheSize));
+}
+
+void
+RootTree::
+updateLearnedBranches(std::vector<std::string>& learnedBranches) const
+{
+  if (!autoCacheSized_) {
+    // Nothing learned from this file.
+    return;
+  }
+  TTreeCache* tc = dynamic_cast<TTreeCache*>(filePtr_->GetCacheRead(tree_));
+  if (!tc) {
+    return;
+  }
+  learnedBranches.clear();
+  if (!cacheBranches_.empty() && (tc->GetEfficiencyRel() < minCacheHitRate)) {
+    return;
+  }
+  if (TObjArray const* branches = tc->GetCachedBranches()) {
+    for (Int_t i = 0, n = branches->GetEntriesFast(); i != n; ++i) {
+      learnedBranches.emplace_back(branches->UncheckedAt(i)->GetName());
+    }
+  }
+}
+
+void
+RootTree::
+reportCacheUse(std::string const& fileName) const
+{
+  TTreeCache* tc = dynamic_cast<TTreeCache*>(filePtr_->GetCacheRead(tree_));
+  if (!tc) {
+    return;
+  }
+  TObjArray const* branches = tc->GetCachedBranches();
+  mf::LogInfo("TreeCache")
+      << "Tree cache of "
+      << BranchTypeToProductTreeName(branchType_)
+      << " in "
+      << fileName
+      << ": "
+      << tc->GetBufferSize()
+      << " bytes for "
+      << (branches ? branches->GetEntriesFast() : 0)
+      << " branches"
+      << (cacheBranches_.empty() ? "" : " as read in the previous file")
+      << ", "
+      << 100.0 * tc->GetEfficiencyRel()
+      << "% of reads served by the cache, "
+      << 100.0 * tc->GetEfficiency()
+      << "% of the prefetched baskets used, "
+      << filePtr_->GetReadCalls()
+      << " read calls to the file for "
+      << filePtr_->GetBytesRead()
+      << " bytes.";
+}
+
 void
 RootTree::
 setTreeMaxVirtualSize(int treeMaxVirtualSize)
@@ -175,7 +336,18 @@ setEntryNumber(EntryNumber theEntryNumber)
   if (TTreeCache* tc = dynamic_cast<TTreeCache*>(
                          filePtr_->GetCacheRead(tree_))) {
     assert(tree_ == tc->GetTree());
-    if ((theEntryNumber >= 0) && tc->IsLearning()) {
+    if ((theEntryNumber >= 0) && tc->IsLearning() && !cacheBranches_.empty()) {
+      // The branches read in the previous file.
+      for (auto branch : cacheBranches_) {
+        tc->AddBranch(branch, kFALSE);
+      }
+      tc->StopLearningPhase();
+    }
+    else if ((theEntryNumber >= 0) && tc->IsLearning() && (learnEntries_ > 0)) {
+      // Learn from the branches actually read over the first entries;
+      // their number is set once by RootInputFileSequence.
+    }
+    else if ((theEntryNumber >= 0) && tc->IsLearning()) {
       tc->SetLearnEntries(1);
       tc->SetEntryRange(0, tree_->GetEntries());
       for (auto i = branches_->cbegin(), e = branches_->cend(); i != e; ++i) {
@@ -185,6 +357,10 @@ setEntryNumber(EntryNumber theEntryNumber)
       }
       tc->StopLearningPhase();
     }
+    if ((autoCache_.learnEntries_ > 0) && !autoCacheSized_ &&
+        !tc->IsLearning()) {
+      sizeAutoCache_(tc);
+    }
   }
   entryNumber_ = theEntryNumber;
   auto err = tree_->LoadTree(theEntryNumber);
@@ -23,6 +23,7 @@
 #include <vector>
 
 class TFile;
+class TTreeCache;
 
 namespace art {
 
@@ -129,6 +130,19 @@ public:
 
   void setCacheSize(unsigned int cacheSize) const;
 
+  void setReadAhead(input::ReadAheadConfig const&);
+
+  void setAutoCache(input::AutoCacheConfig const&,
+                    std::vector<std::string> const& learnedBranches);
+
+  // Replace learnedBranches by the branches held in the automatic
+  // cache of this tree, or clear them if they are to be learned again
+  // for the next file.
+  void updateLearnedBranches(std::vector<std::string>& learnedBranches) const;
+
+  // Log the use of the tree cache, if any.
+  void reportCacheUse(std::string const& fileName) const;
+
   void setTreeMaxVirtualSize(int treeMaxVirtualSize);
 
   BranchMap const&
@@ -159,6 +173,16 @@ private:
   std::vector<std::string> branchNames_;
   std::shared_ptr<BranchMap> branches_;
   cet::exempt_ptr<RootInputFile> primaryFile_;
+  // Let the tree cache learn the branches read over this many
+  // entries, rather than reading all branches from the first.
+  unsigned int learnEntries_;
+  input::AutoCacheConfig autoCache_;
+  // The branches of the automatic cache, when learned from an earlier
+  // file.
+  std::vector<TBranch*> cacheBranches_;
+  bool autoCacheSized_;
+
+  void sizeAutoCache_(TTreeCache* tc);
 };
 
 } // namespace art
@@ -9,6 +9,7 @@ namespace {
 
   std::string const metaDataTree      = "MetaData";
   std::string const fileIndexTree     = "FileIndex";
+  std::string const eventHashIndexTree = "EventHashIndex";
   std::string const eventHistory      = "EventHistory";
   std::string const eventBranchMapper = "EventBranchMapper";
 
@@ -39,6 +40,11 @@ std::string const & art::rootNames::fileIndexTreeName( ) {
   return fileIndexTree;
 }
 
+// Event hash index Tree
+std::string const & art::rootNames::eventHashIndexTreeName( ) {
+  return eventHashIndexTree;
+}
+
 // EventHistory Tree
 std::string const & art::rootNames::eventHistoryTreeName( ) {
   return eventHistory;
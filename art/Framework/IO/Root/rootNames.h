@@ -32,6 +32,9 @@ namespace art {
     // FileIndex Tree
     std::string const & fileIndexTreeName( );
 
+    // Event hash index Tree (optional)
+    std::string const & eventHashIndexTreeName( );
+
     // Event History Tree
     std::string const & eventHistoryTreeName( );
 
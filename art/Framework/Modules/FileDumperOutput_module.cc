@@ -102,11 +102,8 @@ printPrincipal(P const & p)
   size_t present = 0;
   size_t not_present = 0;
   // insert the per-product data:
-  for (typename P::const_iterator
-       it  = p.begin(),
-       end = p.end();
-       it != end;
-       ++it) {
+  auto const groupsLock = p.lockGroups();
+  for (auto const it : p.sortedGroups()) {
     Group const & g = *(it->second);
     if (wantResolveProducts_) {
       try {
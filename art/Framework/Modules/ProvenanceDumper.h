@@ -216,11 +216,8 @@ operator()(PRINCIPAL const & p,
            void (DETAIL:: *func)(art::Provenance const &)) const
 {
   if (!p.size()) { return; } // Nothing to do.
-  for (typename PRINCIPAL::const_iterator
-       it  = p.begin(),
-       end = p.end();
-       it != end;
-       ++it) {
+  auto const groupsLock = p.lockGroups();
+  for (auto const it : p.sortedGroups()) {
     Group const & g = *(it->second);
     if (wantPresentOnly_ && resolveProducts_) {
       try {
@@ -87,6 +87,13 @@ resolveProductIfAvailable(bool fillOnDemand,
   return uniqueProduct(wanted_wrapper_type);
 }
 
+void
+art::AssnsGroup::
+removeCachedProduct() const {
+  secondaryProduct_.reset();
+  Group::removeCachedProduct();
+}
+
 std::unique_ptr<art::EDProduct>
 art::AssnsGroup::
 maybeObtainProductFromPartner(TypeID const &wanted_wrapper_type) const
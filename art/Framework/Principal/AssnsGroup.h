@@ -40,6 +40,7 @@ public:
   EDProduct const *uniqueProduct() const override;
   EDProduct const *uniqueProduct(TypeID const &wanted_wrapper_type) const override;
   bool resolveProductIfAvailable(bool fillOnDemand, TypeID const &) const override;
+  void removeCachedProduct() const override;
 
 private:
   std::unique_ptr<EDProduct>
@@ -0,0 +1,31 @@
+#ifndef art_Framework_Principal_ConsumedProduct_h
+#define art_Framework_Principal_ConsumedProduct_h
+// vim: set sw=2:
+
+//
+// ConsumedProduct
+//
+// A product which a module declares it reads from the event, named by
+// its type and InputTag (see ProducerBase::consumes()).
+//
+
+#include "art/Utilities/InputTag.h"
+#include "art/Utilities/TypeID.h"
+
+#include <vector>
+
+namespace art {
+
+  struct ConsumedProduct {
+    TypeID type;
+    InputTag tag;
+  };
+
+  typedef std::vector<ConsumedProduct> ConsumedProducts;
+
+} // namespace art
+
+// Local Variables:
+// mode: c++
+// End:
+#endif // art_Framework_Principal_ConsumedProduct_h
@@ -54,12 +54,15 @@ namespace art {
   }
 
   GroupQueryResult
-  DataViewImpl::getByLabel_(TypeID const& tid,
-                     string const& label,
-                     string const& productInstanceName,
-                     string const& processName) const
+  DataViewImpl::getByLabel_(TypeID const& tid, InputTag const& tag) const
   {
-    return principal_.getByLabel(tid, label, productInstanceName, processName);
+    return principal_.getByLabel(tid, tag);
+  }
+
+  GroupQueryResult
+  DataViewImpl::getByToken_(ProductTokenBase const& token) const
+  {
+    return principal_.getByToken(token);
   }
 
   void
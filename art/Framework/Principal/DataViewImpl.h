@@ -26,6 +26,13 @@
 // art::Handle<FruitCollection> fruits;
 // event.getByLabel("market", "apple", fruits);
 //
+// A module getting the same product for every event may instead make
+// a ProductToken once, and use getByToken(), which skips the search by
+// type and label after the first call (see ProductToken.h).
+//
+// art::ProductToken<AppleCollection> const applesToken_ { "tree" };
+// event.getByToken(applesToken_, apples);
+//
 // Putting Data
 //
 // std::unique_ptr<AppleCollection> pApples( new AppleCollection );
@@ -51,6 +58,7 @@
 #include "art/Persistency/Common/EDProduct.h"
 #include "art/Persistency/Common/GroupQueryResult.h"
 #include "art/Framework/Principal/Handle.h"
+#include "art/Framework/Principal/ProductToken.h"
 #include "art/Persistency/Common/Wrapper.h"
 #include "art/Persistency/Common/fwd.h"
 #include "art/Persistency/Common/traits.h"
@@ -102,6 +110,10 @@ public:
   bool
   getByLabel(InputTag const& tag, Handle<PROD>& result) const;
 
+  template <typename PROD>
+  bool
+  getByToken(ProductToken<PROD> const& token, Handle<PROD>& result) const;
+
   template <typename PROD>
   void
   getMany(SelectorBase const&, std::vector<Handle<PROD> >& results) const;
@@ -147,10 +159,10 @@ protected:
   get_(TypeID const& tid, SelectorBase const&) const;
 
   GroupQueryResult
-  getByLabel_(TypeID const& tid,
-              std::string const& label,
-              std::string const& productInstanceName,
-              std::string const& processName) const;
+  getByLabel_(TypeID const& tid, InputTag const& tag) const;
+
+  GroupQueryResult
+  getByToken_(ProductTokenBase const& token) const;
 
   void
   getMany_(TypeID const& tid,
@@ -244,7 +256,7 @@ bool
 art::DataViewImpl::getByLabel(InputTag const& tag, Handle<PROD>& result) const
 {
   result.clear();
-  GroupQueryResult bh = this->getByLabel_(TypeID(typeid(PROD)), tag.label(), tag.instance(), tag.process());
+  GroupQueryResult bh = this->getByLabel_(TypeID(typeid(PROD)), tag);
   convert_handle(bh, result);
   return bh.succeeded();
 }
@@ -257,7 +269,19 @@ art::DataViewImpl::getByLabel(std::string const& label,
                          Handle<PROD>& result) const
 {
   result.clear();
-  GroupQueryResult bh = this->getByLabel_(TypeID(typeid(PROD)), label, productInstanceName, std::string());
+  GroupQueryResult bh = this->getByLabel_(TypeID(typeid(PROD)), InputTag(label, productInstanceName));
+  convert_handle(bh, result);
+  return bh.succeeded();
+}
+
+template <typename PROD>
+inline
+bool
+art::DataViewImpl::getByToken(ProductToken<PROD> const& token,
+                              Handle<PROD>& result) const
+{
+  result.clear();
+  GroupQueryResult bh = this->getByToken_(token);
   convert_handle(bh, result);
   return bh.succeeded();
 }
@@ -61,6 +61,7 @@ public:
 
   using Base::get;
   using Base::getByLabel;
+  using Base::getByToken;
   using Base::getMany;
   using Base::getManyByType;
   using Base::removeCachedProduct;
@@ -121,6 +122,10 @@ public:
              std::string const& productInstanceName,
              Handle<PROD>& result) const;
 
+  template <typename PROD>
+  bool
+  getByToken(ProductToken<PROD> const& token, Handle<PROD>& result) const;
+
   template <typename PROD>
   void
   getMany(SelectorBase const& sel,
@@ -329,6 +334,18 @@ art::Event::getByLabel(std::string const& label,
   return ok;
 }  // getByLabel<>()
 
+template <typename PROD>
+bool
+art::Event::getByToken(ProductToken<PROD> const& token,
+                       Handle<PROD>& result) const
+{
+  bool ok = this->Base::getByToken(token, result);
+  if (ok) {
+    addToGotBranchIDs(*result.provenance());
+  }
+  return ok;
+}  // getByToken<>()
+
 // ----------------------------------------------------------------------
 
 template <typename PROD>
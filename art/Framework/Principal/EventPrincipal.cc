@@ -18,8 +18,30 @@
 using namespace cet;
 using namespace std;
 
+namespace {
+  art::EventPrincipal::ArenaOptions arenaOptions_ {
+    true, art::MonotonicArena::defaultBlockSize, false
+  };
+}
+
 namespace art {
 
+void
+EventPrincipal::
+setArenaOptions(ArenaOptions const& options)
+{
+  arenaOptions_ = options;
+  MonotonicArena::setPlaceObjects(options.enabled);
+  MonotonicArena::setForeignObjects(options.enabled && options.streamedProducts);
+}
+
+EventPrincipal::ArenaOptions const&
+EventPrincipal::
+arenaOptions()
+{
+  return arenaOptions_;
+}
+
 EventPrincipal::
 ~EventPrincipal()
 {
@@ -38,7 +60,11 @@ EventPrincipal(EventAuxiliary const& aux, ProcessConfiguration const& pc,
   , subRunPrincipal_()
   , history_(history)
   , branchToProductIDHelper_()
+  , groupsKey_(0)
 {
+  if (arenaOptions_.enabled) {
+    setArena(std::unique_ptr<MonotonicArena>(new MonotonicArena(arenaOptions_.blockSize)));
+  }
   productReader().setGroupFinder(cet::exempt_ptr<EventPrincipal const>(this));
   if (ProductMetaData::instance().productProduced(InEvent)) {
     addToProcessHistory();
@@ -46,11 +72,61 @@ EventPrincipal(EventAuxiliary const& aux, ProcessConfiguration const& pc,
     history_->addBranchListIndexEntry(
       BranchIDListRegistry::instance()->size() - 1);
   }
-  // Fill in helper map for Branch to ProductID mapping
-  for (auto IB = history->branchListIndexes().cbegin(),
-       IE = history->branchListIndexes().cend(), I = IB; I != IE; ++I) {
+  fillBranchToProductIDHelper_(branchToProductIDHelper_);
+}
+
+void
+EventPrincipal::
+keepGroupsOnReuse(std::uint64_t const groupsKey)
+{
+  groupsKey_ = groupsKey;
+  keepGroupsOnReuse_();
+}
+
+bool
+EventPrincipal::
+reuse(EventAuxiliary const& aux, std::shared_ptr<History> history,
+      std::unique_ptr<BranchMapper>&& mapper,
+      std::unique_ptr<DelayedReader>&& rtrv, std::uint64_t const groupsKey)
+{
+  deferredGetters_.clear();
+  aux_ = aux;
+  subRunPrincipal_.reset();
+  history_ = history;
+  // Before this process is added to it.
+  ProcessHistoryID const inputHistoryID = history_->processHistoryID();
+  bool const produced = ProductMetaData::instance().productProduced(InEvent);
+  if (produced) {
+    history_->addBranchListIndexEntry(
+      BranchIDListRegistry::instance()->size() - 1);
+  }
+  // The kept Groups hold ProductIDs made with the old helper map.
+  std::map<BranchListIndex, ProcessIndex> helper;
+  fillBranchToProductIDHelper_(helper);
+  bool const keepGroups =
+    (groupsKey != 0) && (groupsKey == groupsKey_) &&
+    (helper == branchToProductIDHelper_);
+  branchToProductIDHelper_.swap(helper);
+  if (!keepGroups) {
+    groupsKey_ = 0;
+  }
+  reuse_(inputHistoryID, std::move(mapper), std::move(rtrv), keepGroups);
+  productReader().setGroupFinder(cet::exempt_ptr<EventPrincipal const>(this));
+  if (produced) {
+    addToProcessHistory();
+  }
+  return keepGroups;
+}
+
+// Fill in helper map for Branch to ProductID mapping
+void
+EventPrincipal::
+fillBranchToProductIDHelper_(std::map<BranchListIndex, ProcessIndex>& helper) const
+{
+  for (auto IB = history_->branchListIndexes().cbegin(),
+       IE = history_->branchListIndexes().cend(), I = IB; I != IE; ++I) {
     ProcessIndex pix = I - IB;
-    branchToProductIDHelper_.insert({*I, pix});
+    helper.insert({*I, pix});
   }
 }
 
@@ -94,6 +170,7 @@ void
 EventPrincipal::
 addOrReplaceGroup(std::unique_ptr<Group>&& g)
 {
+  std::lock_guard<std::recursive_mutex> lock(groupsMutex());
   cet::exempt_ptr<Group const> group =
     getExistingGroup(g->productDescription().branchID());
   if (!group) {
@@ -122,6 +199,8 @@ void
 EventPrincipal::
 addGroup(BranchDescription const& bd)
 {
+  std::lock_guard<std::recursive_mutex> lock(groupsMutex());
+  MonotonicArena::Scope arenaScope(arena());
   addOrReplaceGroup(gfactory::make_group(bd,
                                          branchIDToProductID(bd.branchID())));
 }
@@ -130,6 +209,8 @@ void
 EventPrincipal::
 addGroup(std::unique_ptr<EDProduct>&& prod, BranchDescription const& bd)
 {
+  std::lock_guard<std::recursive_mutex> lock(groupsMutex());
+  MonotonicArena::Scope arenaScope(arena());
   addOrReplaceGroup(gfactory::make_group(std::move(prod),
                                          bd,
                                          branchIDToProductID(bd.branchID())));
@@ -141,6 +222,8 @@ addOnDemandGroup(BranchDescription const& desc, cet::exempt_ptr<Worker> worker)
 {
   ProductID pid(branchIDToProductID(desc.branchID()));
   cet::exempt_ptr<EventPrincipal> epp(this);
+  std::lock_guard<std::recursive_mutex> lock(groupsMutex());
+  MonotonicArena::Scope arenaScope(arena());
   addOrReplaceGroup(gfactory::make_group(desc, pid, worker, epp));
 }
 
@@ -149,6 +232,7 @@ EventPrincipal::
 put(std::unique_ptr<EDProduct>&& edp, BranchDescription const& bd,
     std::unique_ptr<ProductProvenance const>&& productProvenance)
 {
+  std::lock_guard<std::recursive_mutex> lock(groupsMutex());
   if (!edp) {
     throw art::Exception(art::errors::InsertFailure, "Null Pointer")
         << "put: Cannot put because unique_ptr to product is null.\n";
@@ -166,6 +250,7 @@ EDProductGetter const*
 EventPrincipal::
 productGetter(ProductID const& pid) const
 {
+  std::lock_guard<std::recursive_mutex> lock(groupsMutex());
   EDProductGetter const* result = getByProductID(pid).result().get();
   return result ? result : deferredGetter_(pid);
 }
@@ -222,6 +307,7 @@ GroupQueryResult
 EventPrincipal::
 getGroup(ProductID const& pid) const
 {
+  std::lock_guard<std::recursive_mutex> lock(groupsMutex());
   BranchID bid = productIDToBranchID(pid);
   SharedConstGroupPtr const& g = getGroupForPtr(bid);
   if (g.get()) {
@@ -238,6 +324,7 @@ GroupQueryResult
 EventPrincipal::
 getByProductID(ProductID const& pid) const
 {
+  std::lock_guard<std::recursive_mutex> lock(groupsMutex());
   // FIXME: This reproduces the logic of the old version of the
   // function, but I'm not sure it does the *right* thing in the face
   // of an unavailable product or other rare failure.
@@ -253,6 +340,16 @@ getByProductID(ProductID const& pid) const
   return GroupQueryResult(g.get());
 }
 
+cet::exempt_ptr<MonotonicArena>
+EventPrincipal::
+productArena() const
+{
+  if (!arenaOptions_.streamedProducts) {
+    return cet::exempt_ptr<MonotonicArena>();
+  }
+  return primaryArena();
+}
+
 EventSelectionIDVector const&
 EventPrincipal::
 eventSelectionIDs() const
@@ -10,6 +10,13 @@
 //  This is not visible to modules, instead they use the Event class,
 //  which is a proxy for this class.
 //
+//  Each event principal has its own MonotonicArena for its Groups,
+//  and optionally for the products read for it from a file (see
+//  ArenaOptions).
+//
+//  An input source may recycle the principals of past events for new
+//  ones with reuse(), instead of constructing them anew.
+//
 
 #include "art/Framework/Principal/NoDelayedReader.h"
 #include "art/Framework/Principal/Principal.h"
@@ -21,6 +28,7 @@
 #include "art/Persistency/Provenance/History.h"
 #include "cetlib/exempt_ptr.h"
 #include "cpp0x/memory"
+#include <cstdint>
 #include <map>
 #include <vector>
 
@@ -35,6 +43,19 @@ public:
   typedef EventAuxiliary Auxiliary;
   typedef Principal::SharedConstGroupPtr SharedConstGroupPtr;
 
+  // Configured by services.scheduler.eventArena, for all the event
+  // principals of the job, before any principal is made. With the
+  // arena disabled, Groups are plain heap objects (see
+  // MonotonicArena::setPlaceObjects()).
+  struct ArenaOptions {
+    bool enabled;
+    std::size_t blockSize;
+    bool streamedProducts;
+  };
+
+  static void setArenaOptions(ArenaOptions const& options);
+  static ArenaOptions const& arenaOptions();
+
 public:
 
   virtual ~EventPrincipal();
@@ -52,6 +73,20 @@ public:
 
   // use compiler-generated copy c'tor, copy assignment.
 
+  // Once filled with the Groups for the products of its input, keep
+  // those Groups for reuse() with the same groupsKey, which must
+  // identify that set of products.
+  void keepGroupsOnReuse(std::uint64_t groupsKey);
+
+  // Make the principal that of a new event, as if constructed with
+  // these arguments.  Return true if the Groups it was filled with
+  // were kept, false if it must be filled again.
+  bool reuse(EventAuxiliary const& aux,
+             std::shared_ptr<History> history,
+             std::unique_ptr<BranchMapper>&& mapper,
+             std::unique_ptr<DelayedReader>&& rtrv,
+             std::uint64_t groupsKey);
+
   SubRunPrincipal const& subRunPrincipal() const;
 
   SubRunPrincipal& subRunPrincipal();
@@ -154,6 +189,10 @@ public:
 
   EDProductGetter const* productGetter(ProductID const& pid) const;
 
+  // The arena in which a DelayedReader should place the products it
+  // reads for this event, or null if they go on the heap.
+  cet::exempt_ptr<MonotonicArena> productArena() const;
+
 private:
 
   BranchID productIDToBranchID(ProductID const& pid) const;
@@ -174,6 +213,8 @@ private:
     return history().setProcessHistoryID(phid);
   }
 
+  void fillBranchToProductIDHelper_(std::map<BranchListIndex, ProcessIndex>&) const;
+
   // This function and its associated member datum are required to
   // handle the lifetime of a deferred getter, which in turn is required
   // because a group does not exist until it is placed in the event.
@@ -193,6 +234,9 @@ private:
 
   std::map<BranchListIndex, ProcessIndex> branchToProductIDHelper_;
 
+  // Identifies the Groups kept on reuse(), zero if none.
+  std::uint64_t groupsKey_;
+
 };
 
 inline
@@ -15,6 +15,7 @@
 #include "art/Persistency/Provenance/BranchMapper.h"
 #include "art/Persistency/Provenance/ProductID.h"
 #include "art/Persistency/Provenance/ProductProvenance.h"
+#include "art/Utilities/MonotonicArena.h"
 #include "art/Utilities/fwd.h"
 #include "cetlib/exempt_ptr.h"
 #include "cpp0x/memory"
@@ -73,6 +74,22 @@ protected:
 
 public:
 
+#ifndef __GCCXML__
+
+  // Groups are made in the arena of their principal, if it has one
+  // (see MonotonicArena).
+  static void* operator new(std::size_t n)
+  {
+    return MonotonicArena::allocateObject(n);
+  }
+
+  static void operator delete(void* p)
+  {
+    MonotonicArena::deallocateObject(p);
+  }
+
+#endif // __GCCXML__
+
   void swap(Group& other);
 
   // product is not available (dropped or never created)
@@ -165,7 +182,7 @@ public:
   }
 
   // Remove any cached product.
-  void removeCachedProduct() const;
+  virtual void removeCachedProduct() const;
 
 protected:
 
@@ -1,9 +1,11 @@
 #include "art/Framework/Principal/Principal.h"
 // vim: set sw=2:
 
+#include "art/Framework/Principal/ProductToken.h"
 #include "art/Framework/Principal/Selector.h"
 #include "art/Persistency/Common/DelayedReader.h"
 #include "art/Persistency/Common/GroupQueryResult.h"
+#include "art/Persistency/Provenance/BranchKey.h"
 #include "art/Persistency/Provenance/BranchMapper.h"
 #include "art/Persistency/Provenance/ProcessHistory.h"
 #include "art/Persistency/Provenance/ProcessHistoryRegistry.h"
@@ -35,17 +37,32 @@ Principal(ProcessConfiguration const& pc, ProcessHistoryID const& hist,
           std::unique_ptr<BranchMapper>&& mapper,
           std::unique_ptr<DelayedReader>&& reader, int idx,
           Principal* primaryPrincipal)
-  : processHistoryPtr_(new ProcessHistory)
+  : processHistoryPtr_()
   , processConfiguration_(pc)
   , processHistoryModified_(false)
+  , inputProcessHistoryID_()
+  , arena_()
   , groups_()
+  , keptGroups_(0)
+  , arenaMark_()
   , branchMapperPtr_(std::move(mapper))
   , store_(std::move(reader))
   , primaryPrincipal_(primaryPrincipal)
   , secondaryPrincipals_()
   , secondaryIdx_(idx)
   , nextSecondaryFileIdx_(0)
+  , groupsMutex_()
 {
+  loadProcessHistory_(hist);
+}
+
+void
+Principal::
+loadProcessHistory_(ProcessHistoryID const& hist)
+{
+  inputProcessHistoryID_ = hist;
+  processHistoryPtr_.reset(new ProcessHistory);
+  processHistoryModified_ = false;
   if (!hist.isValid()) {
     return;
   }
@@ -55,6 +72,52 @@ Principal(ProcessConfiguration const& pc, ProcessHistoryID const& hist,
   assert(found);
 }
 
+void
+Principal::
+keepGroupsOnReuse_()
+{
+  std::lock_guard<std::recursive_mutex> lock(groupsMutex_);
+  keptGroups_ = groups_.size();
+  arenaMark_ = arena_ ? arena_->mark() : MonotonicArena::Mark();
+}
+
+void
+Principal::
+reuse_(ProcessHistoryID const& hist, std::unique_ptr<BranchMapper>&& mapper,
+       std::unique_ptr<DelayedReader>&& reader, bool const keepGroups)
+{
+  std::lock_guard<std::recursive_mutex> lock(groupsMutex_);
+  if (!keepGroups) {
+    keptGroups_ = 0;
+    arenaMark_ = MonotonicArena::Mark();
+  }
+  groups_.truncate(keptGroups_);
+  for (auto const& val : groups_) {
+    val.second->removeCachedProduct();
+  }
+  // Products read for this principal from secondary files may be in
+  // its arena too.
+  secondaryPrincipals_.clear();
+  nextSecondaryFileIdx_ = 0;
+  if (arena_) {
+    arena_->rewind(arenaMark_);
+  }
+  branchMapperPtr_ = std::move(mapper);
+  store_ = std::move(reader);
+  for (auto const& val : groups_) {
+    val.second->setResolvers(*branchMapperPtr_, *store_);
+  }
+  if (hist == inputProcessHistoryID_) {
+    // The same history as before, with this process already added to
+    // it if it was: its ID need not be computed again.
+    if (processHistoryModified_) {
+      setProcessHistoryID(processHistoryPtr_->id());
+    }
+    return;
+  }
+  loadProcessHistory_(hist);
+}
+
 void
 Principal::
 addToProcessHistory() const
@@ -120,11 +183,19 @@ GroupQueryResult
 Principal::
 getByLabel(TypeID const& productType, string const& label,
            string const& productInstanceName, string const& processName) const
+{
+  return getByLabel(productType,
+                    InputTag(label, productInstanceName, processName));
+}
+
+GroupQueryResult
+Principal::
+getByLabel(TypeID const& productType, InputTag const& tag) const
 {
   GroupQueryResultVec results;
-  Selector sel(ModuleLabelSelector(label) &&
-               ProductInstanceNameSelector(productInstanceName) &&
-               ProcessNameSelector(processName));
+  Selector sel(ModuleLabelSelector(tag.labelSymbol()) &&
+               ProductInstanceNameSelector(tag.instanceSymbol()) &&
+               ProcessNameSelector(tag.processSymbol()));
   int nFound = findGroupsForProduct(productType, sel, results, true);
   if (nFound == 0) {
     std::shared_ptr<cet::exception> whyFailed(new art::Exception(
@@ -134,13 +205,13 @@ getByLabel(TypeID const& productType, string const& label,
                << productType
                << "\n"
                << "Looking for module label: "
-               << label
+               << tag.label()
                << "\n"
                << "Looking for productInstanceName: "
-               << productInstanceName
+               << tag.instance()
                << "\n"
-               << (processName.empty() ? "" : "Looking for process: ")
-               << processName
+               << (tag.process().empty() ? "" : "Looking for process: ")
+               << tag.process()
                << "\n";
     return GroupQueryResult(whyFailed);
   }
@@ -153,18 +224,51 @@ getByLabel(TypeID const& productType, string const& label,
         << productType
         << "\n"
         << "Looking for module label: "
-        << label
+        << tag.label()
         << "\n"
         << "Looking for productInstanceName: "
-        << productInstanceName
+        << tag.instance()
         << "\n"
-        << (processName.empty() ? "" : "Looking for process: ")
-        << processName
+        << (tag.process().empty() ? "" : "Looking for process: ")
+        << tag.process()
         << "\n";
   }
   return results[0];
 }
 
+GroupQueryResult
+Principal::
+getByToken(ProductTokenBase const& token) const
+{
+  std::lock_guard<std::recursive_mutex> lock(groupsMutex_);
+  auto const generation = ProductMetaData::instance().generation();
+  if ((token.generation_ != generation) ||
+      (token.branchType_ != branchType()) ||
+      (token.processHistoryID_ != processHistoryID())) {
+    token.candidates_ = findCandidatesForToken(token.productType(),
+                                               token.inputTag());
+    token.generation_ = generation;
+    token.branchType_ = branchType();
+    token.processHistoryID_ = processHistoryID();
+  }
+  for (auto const& bid : token.candidates_) {
+    auto group = getGroup(bid);
+    if (!group || group->productUnavailable()) {
+      continue;
+    }
+    group->resolveProduct(true, token.wrapperType());
+    // If the product is a dummy filler, group will now be marked unavailable.
+    // Unscheduled execution can fail to produce the EDProduct so check.
+    if (!group->productUnavailable() && !group->onDemand()) {
+      return GroupQueryResult(group.get());
+    }
+  }
+  // Nothing usable among the candidates: the product may be in a
+  // secondary file not yet opened, or absent.  The general lookup
+  // deals with both, including the failure report.
+  return getByLabel(token.productType(), token.inputTag());
+}
+
 void
 Principal::
 getMany(TypeID const& productType, SelectorBase const& sel,
@@ -205,6 +309,7 @@ getMatchingSequence(TypeID const& elementType, SelectorBase const& selector,
                     GroupQueryResultVec& results,
                     bool stopIfProcessHasMatch) const
 {
+  std::lock_guard<std::recursive_mutex> lock(groupsMutex_);
   // Can we call elementType.friendlyClassName()?
   if (!elementType.hasDictionary()) {
     return 0;
@@ -256,6 +361,7 @@ findGroupsForProduct(TypeID const& wanted_product,
                      GroupQueryResultVec& results,
                      bool stopIfProcessHasMatch) const
 {
+  std::lock_guard<std::recursive_mutex> lock(groupsMutex_);
   // Can we call friendlyClassName()?
   if (!wanted_product.hasDictionary()) {
     return 0;
@@ -361,6 +467,40 @@ findGroups(ProcessLookup const& pl, SelectorBase const& sel,
   return res.size();
 }
 
+std::vector<BranchID>
+Principal::
+findCandidatesForToken(TypeID const& productType, InputTag const& tag) const
+{
+  std::vector<BranchID> result;
+  // Can we call friendlyClassName()?
+  if (!productType.hasDictionary()) {
+    return result;
+  }
+  auto const& pl = ProductMetaData::instance().productList();
+  auto const fcn = productType.friendlyClassName();
+  auto addCandidate = [&](std::string const& processName) {
+    auto I = pl.find(BranchKey(fcn, tag.label(), tag.instance(), processName));
+    if ((I != pl.end()) && (I->second.branchType() == branchType())) {
+      result.push_back(I->second.branchID());
+    }
+  };
+  if (!tag.process().empty()) {
+    addCandidate(tag.process());
+    return result;
+  }
+  // Same order as findGroups(): the current process, then the
+  // processes in the history in reverse time order.
+  addCandidate(processConfiguration_.processName());
+  for (auto I = processHistory().crbegin(), E = processHistory().crend();
+       I != E; ++I) {
+    if (I->processName() == processConfiguration_.processName()) {
+      continue;
+    }
+    addCandidate(I->processName());
+  }
+  return result;
+}
+
 void
 Principal::
 findGroupsForProcess(std::vector<BranchID> const& vbid,
@@ -398,6 +538,7 @@ OutputHandle
 Principal::
 getForOutput(BranchID const& bid, bool resolveProd) const
 {
+  std::lock_guard<std::recursive_mutex> lock(groupsMutex_);
   auto const& g = getResolvedGroup(bid, resolveProd, false);
   if (!g) {
     return OutputHandle();
@@ -458,6 +599,16 @@ getExistingGroup(BranchID const& bid) const
   return nullptr;
 }
 
+cet::exempt_ptr<MonotonicArena>
+Principal::
+primaryArena() const
+{
+  if (primaryPrincipal_ != nullptr) {
+    return primaryPrincipal_->arena();
+  }
+  return arena();
+}
+
 std::shared_ptr<const Group> const
 Principal::
 getGroupForPtr(BranchID const bid) const
@@ -10,14 +10,26 @@
 //
 //  The major internal component is the Group, which contains an EDProduct
 //  and its associated Provenance, along with ancillary transient information
-//  regarding the two.  Groups are handled through shared pointers.
+//  regarding the two.  Groups are handled through shared pointers, and
+//  are held in a flat table hashed on BranchID (detail::GroupTable).
 //
 //  The Principal returns GroupQueryResult, rather than a shared
 //  pointer to a Group, when queried.
 //
+//  Lookups, product resolution and insertions are serialized, so that
+//  modules on trigger paths run concurrently may share a principal.
+//
+//  A principal may own a MonotonicArena, from which its Groups are
+//  made, and which is released in bulk when the principal goes.
+//
+//  A principal may also be reused for another occurrence (see
+//  reuse_()), keeping the Groups it was filled with, and the arena
+//  memory they occupy, when the products to be read are the same.
+//
 
 #include "art/Framework/Principal/Group.h"
 #include "art/Framework/Principal/OutputHandle.h"
+#include "art/Framework/Principal/detail/GroupTable.h"
 #include "art/Framework/Principal/fwd.h"
 #include "art/Persistency/Common/DelayedReader.h"
 #include "art/Persistency/Common/GroupQueryResult.h"
@@ -29,10 +41,12 @@
 #include "art/Persistency/Provenance/ProductStatus.h"
 #include "art/Persistency/Provenance/ProvenanceFwd.h"
 #include "art/Utilities/InputTag.h"
+#include "art/Utilities/MonotonicArena.h"
 #include "art/Utilities/TypeID.h"
 #include "cetlib/exempt_ptr.h"
 #include "cpp0x/memory"
 #include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <cstdio>
@@ -43,7 +57,7 @@ class Principal {
 
 public: // TYPES
 
-  using GroupCollection = std::map<BranchID, std::shared_ptr<Group>>;
+  using GroupCollection = detail::GroupTable;
   using const_iterator = GroupCollection::const_iterator;
   using ProcessNameConstIterator = ProcessHistory::const_iterator;
   using SharedConstGroupPtr = std::shared_ptr<const Group>;
@@ -77,6 +91,14 @@ public: // MEMBER FUNCTIONS
              std::string const& productInstanceName,
              std::string const& processName) const;
 
+  GroupQueryResult
+  getByLabel(TypeID const&, InputTag const&) const;
+
+  // As getByLabel(), using the BranchIDs to which the token was
+  // last resolved.
+  GroupQueryResult
+  getByToken(ProductTokenBase const&) const;
+
   void
   getMany(TypeID const&, SelectorBase const&,
           std::vector<GroupQueryResult>& results) const;
@@ -99,6 +121,7 @@ public: // MEMBER FUNCTIONS
   void
   removeCachedProduct(BranchID const& bid) const
   {
+    std::lock_guard<std::recursive_mutex> lock(groupsMutex_);
     getExistingGroup(bid)->removeCachedProduct();
   }
 
@@ -179,6 +202,7 @@ public: // MEMBER FUNCTIONS
     return groups_.size();
   }
 
+  // Iteration is in the order the groups were added.
   const_iterator
   begin() const
   {
@@ -203,6 +227,22 @@ public: // MEMBER FUNCTIONS
     return groups_.cend();
   }
 
+  // The groups in BranchID order, for output in which the order shows.
+  std::vector<const_iterator>
+  sortedGroups() const
+  {
+    return groups_.sorted();
+  }
+
+  // Hold while iterating over the groups, or resolving their products
+  // directly, when modules on other threads may be using this
+  // principal (see services.scheduler.parallelOutput).
+  std::unique_lock<std::recursive_mutex>
+  lockGroups() const
+  {
+    return std::unique_lock<std::recursive_mutex>(groupsMutex_);
+  }
+
   // Flag that we have been updated in the current process.
   void
   addToProcessHistory() const;
@@ -222,6 +262,14 @@ public: // MEMBER FUNCTIONS
 
 protected: // MEMBER FUNCTIONS
 
+  // Held while groups or their products are looked up, resolved or
+  // added.
+  std::recursive_mutex&
+  groupsMutex() const
+  {
+    return groupsMutex_;
+  }
+
   BranchMapper&
   branchMapper()
   {
@@ -234,6 +282,38 @@ protected: // MEMBER FUNCTIONS
     return *store_;
   }
 
+  void
+  setArena(std::unique_ptr<MonotonicArena>&& arena)
+  {
+    arena_ = std::move(arena);
+  }
+
+  cet::exempt_ptr<MonotonicArena>
+  arena() const
+  {
+    return cet::exempt_ptr<MonotonicArena>(arena_.get());
+  }
+
+  // The arena of the primary principal: products read for it from
+  // secondary files belong to it, and must not outlive it.
+  cet::exempt_ptr<MonotonicArena>
+  primaryArena() const;
+
+  // Record the Groups added so far, and the arena memory they hold,
+  // as those to be kept by reuse_().
+  void
+  keepGroupsOnReuse_();
+
+  // Make the principal ready to be refilled for another occurrence,
+  // read with the given mapper and reader.  Everything added since
+  // keepGroupsOnReuse_() is dropped; the Groups before it are emptied
+  // of their products and kept if keepGroups is true, and dropped
+  // otherwise.  The process history is reloaded only if hist differs
+  // from that of the previous occurrence.
+  void
+  reuse_(ProcessHistoryID const& hist, std::unique_ptr<BranchMapper>&&,
+         std::unique_ptr<DelayedReader>&&, bool keepGroups);
+
   // Add a new Group.
   // We take ownership of the Group, which in turn owns its data.
   void
@@ -246,7 +326,7 @@ protected: // MEMBER FUNCTIONS
     assert(!bd.processName().empty());
     group->setResolvers(branchMapper(), *store_);
     std::shared_ptr<Group> g(group.release());
-    groups_.insert(make_pair(bd.branchID(), g));
+    groups_.insert(make_pair(bd.branchID(), std::move(g)));
   }
 
   void
@@ -259,7 +339,9 @@ protected: // MEMBER FUNCTIONS
     assert(!bd.processName().empty());
     group->setResolvers(branchMapper(), *store_);
     std::shared_ptr<Group> g(group.release());
-    groups_[bd.branchID()]->replace(*g);
+    auto I = groups_.find(bd.branchID());
+    assert(I != groups_.cend());
+    I->second->replace(*g);
   }
 
   int
@@ -309,12 +391,23 @@ private: // MEMBER FUNCTIONS
              bool stopIfProcessHasMatch,
              TypeID wanted_wrapper = TypeID()) const;
 
+  // The BranchIDs of the products in this principal's branch type
+  // exactly matching the type and tag, in the order in which
+  // getByLabel() would search for them.
+  std::vector<BranchID>
+  findCandidatesForToken(TypeID const& productType, InputTag const&) const;
+
   void
   findGroupsForProcess(std::vector<BranchID> const& vbid,
                        SelectorBase const& selector,
                        std::vector<GroupQueryResult>& results,
                        TypeID wanted_wrapper) const;
 
+  // Start afresh from the input process history hist, without this
+  // process added.
+  void
+  loadProcessHistory_(ProcessHistoryID const& hist);
+
 private: // MEMBER DATA
 
   std::shared_ptr<ProcessHistory> processHistoryPtr_;
@@ -323,8 +416,19 @@ private: // MEMBER DATA
 
   mutable bool processHistoryModified_;
 
+  // The process history with which the principal was read.
+  ProcessHistoryID inputProcessHistoryID_;
+
+  // Declared before everything that may be placed in it, so as to be
+  // destroyed after them.
+  std::unique_ptr<MonotonicArena> arena_;
+
   // products and provenances are persistent
-  std::map<BranchID, std::shared_ptr<Group>> groups_;
+  GroupCollection groups_;
+
+  // Kept by reuse_().
+  size_type keptGroups_;
+  MonotonicArena::Mark arenaMark_;
 
   // Pointer to the mapper that will get provenance
   // information from the persistent store.
@@ -353,6 +457,10 @@ private: // MEMBER DATA
   // file that a secondary principal should be created from.
   mutable int nextSecondaryFileIdx_;
 
+  // Recursive: lookups may open secondary files, or run on-demand
+  // producers that use this principal in turn.
+  mutable std::recursive_mutex groupsMutex_;
+
 };
 
 } // namespace art
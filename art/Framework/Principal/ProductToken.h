@@ -0,0 +1,101 @@
+#ifndef art_Framework_Principal_ProductToken_h
+#define art_Framework_Principal_ProductToken_h
+// vim: set sw=2:
+
+//
+// ProductToken
+//
+// Names one data product by its type and InputTag.  A token is made
+// once, typically as a module data member initialized in the module
+// constructor, and is then used in place of the InputTag:
+//
+//   art::ProductToken<IntProduct> const intToken_;
+//   ...
+//   art::Handle<IntProduct> h;
+//   e.getByToken(intToken_, h);
+//
+// The first get through a token resolves the tag against the product
+// list and process history to the BranchIDs of the candidate
+// products, in search order.  Subsequent gets go directly to the
+// Groups with those BranchIDs, with no string-keyed map lookups or
+// dictionary queries.  The resolution is redone only when the product
+// list changes (on opening an input file) or the process history of
+// the principal differs from the one last seen.
+//
+// A get which finds nothing through the token falls back to the
+// equivalent getByLabel(), so the result, including any failure
+// report, is the same as for getByLabel().
+//
+
+#include "art/Framework/Principal/fwd.h"
+#include "art/Persistency/Common/Wrapper.h"
+#include "art/Persistency/Provenance/BranchID.h"
+#include "art/Persistency/Provenance/BranchType.h"
+#include "art/Persistency/Provenance/ProcessHistoryID.h"
+#include "art/Utilities/InputTag.h"
+#include "art/Utilities/TypeID.h"
+
+#include <vector>
+
+class art::ProductTokenBase {
+public:
+  TypeID const& productType() const { return productType_; }
+  TypeID const& wrapperType() const { return wrapperType_; }
+  InputTag const& inputTag() const { return tag_; }
+
+protected:
+  ProductTokenBase(TypeID const& productType,
+                   TypeID const& wrapperType,
+                   InputTag const& tag);
+
+private:
+  friend class Principal;
+
+  TypeID productType_;
+  TypeID wrapperType_;
+  InputTag tag_;
+
+  // Resolution cache, valid while the product list generation,
+  // branch type and process history ID below are unchanged.
+  mutable unsigned generation_;
+  mutable BranchType branchType_;
+  mutable ProcessHistoryID processHistoryID_;
+  mutable std::vector<BranchID> candidates_;
+};
+
+template <typename PROD>
+class art::ProductToken : public art::ProductTokenBase {
+public:
+  explicit ProductToken(InputTag const& tag);
+};
+
+inline
+art::ProductTokenBase::
+ProductTokenBase(TypeID const& productType,
+                 TypeID const& wrapperType,
+                 InputTag const& tag)
+  :
+  productType_(productType),
+  wrapperType_(wrapperType),
+  tag_(tag),
+  generation_(0),
+  branchType_(NumBranchTypes),
+  processHistoryID_(),
+  candidates_()
+{
+}
+
+template <typename PROD>
+inline
+art::ProductToken<PROD>::
+ProductToken(InputTag const& tag)
+  :
+  ProductTokenBase(TypeID(typeid(PROD)), TypeID(typeid(Wrapper<PROD>)), tag)
+{
+}
+
+#endif /* art_Framework_Principal_ProductToken_h */
+
+// Local Variables:
+// mode: c++
+// End:
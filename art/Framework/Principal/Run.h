@@ -31,6 +31,7 @@ public:
 
   using Base::get;
   using Base::getByLabel;
+  using Base::getByToken;
   using Base::getMany;
   using Base::getManyByType;
   using Base::removeCachedProduct;
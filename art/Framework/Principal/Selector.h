@@ -35,6 +35,7 @@ for every event.
 #include "art/Framework/Principal/SelectorBase.h"
 #include "art/Framework/Principal/fwd.h"
 #include "art/Persistency/Provenance/BranchDescription.h"
+#include "art/Utilities/Symbol.h"
 #include "cetlib/value_ptr.h"
 #include "cpp0x/type_traits"
 
@@ -73,8 +74,9 @@ namespace art {
 
 class art::ProcessNameSelector : public art::SelectorBase {
 public:
-  ProcessNameSelector(const std::string& pn) :
-    pn_(pn.empty() ? std::string("*") : pn)
+  ProcessNameSelector(Symbol const& pn) :
+    pn_(pn.empty() ? any_() : pn),
+    matchAny_(pn_ == any_())
   { }
 
   virtual ProcessNameSelector* clone() const override
@@ -84,16 +86,23 @@ public:
 
   std::string const& name() const
   {
-    return pn_;
+    return pn_.str();
   }
 
 private:
   virtual bool doMatch(BranchDescription const& p) const override
   {
-    return (pn_=="*") || (p.processName() == pn_);
+    return matchAny_ || (p.processNameSymbol() == pn_);
   }
 
-  std::string pn_;
+  static Symbol const& any_()
+  {
+    static Symbol const s("*");
+    return s;
+  }
+
+  Symbol pn_;
+  bool matchAny_;
 };
 
 //------------------------------------------------------------------
@@ -105,7 +114,7 @@ private:
 
 class art::ProductInstanceNameSelector : public art::SelectorBase {
 public:
-  ProductInstanceNameSelector(const std::string& pin) :
+  ProductInstanceNameSelector(Symbol const& pin) :
     pin_(pin)
   { }
 
@@ -117,10 +126,10 @@ public:
 private:
   virtual bool doMatch(BranchDescription const& p) const override
   {
-    return p.productInstanceName() == pin_;
+    return p.productInstanceNameSymbol() == pin_;
   }
 
-  std::string pin_;
+  Symbol pin_;
 };
 
 //------------------------------------------------------------------
@@ -132,7 +141,7 @@ private:
 
 class art::ModuleLabelSelector : public art::SelectorBase {
 public:
-  ModuleLabelSelector(const std::string& label) :
+  ModuleLabelSelector(Symbol const& label) :
     label_(label)
   { }
 
@@ -144,10 +153,10 @@ public:
 private:
   virtual bool doMatch(BranchDescription const& p) const override
   {
-    return p.moduleLabel() == label_;
+    return p.moduleLabelSymbol() == label_;
   }
 
-  std::string label_;
+  Symbol label_;
 };
 
 //------------------------------------------------------------------
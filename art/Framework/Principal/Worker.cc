@@ -30,7 +30,7 @@ namespace {
     }
   private:
     bool filled_;
-    PostSig_t post_;
+    PostSig_t const & post_;
     art::ModuleDescription* md_;
   };
 
@@ -49,7 +49,9 @@ art::Worker::Worker(ModuleDescription const& iMD,
   md_(iMD),
   actions_(iWP.actions_),
   cached_exception_(),
-  actReg_()
+  actReg_(),
+  serializer_(),
+  mutex_()
 {
 }
 
@@ -21,10 +21,21 @@ will be rethrown if the worker is entered again and the state is not Ready.
 In other words, execution results (status) are cached and reused until
 the worker is reset().
 
+A worker shared by trigger paths that are run concurrently may be
+entered by several threads at once: the first runs the module while
+the others wait for it to finish and then use the cached result.
+
+The worker is held for as long as its module runs. A module that waits
+for TBB tasks of its own must spawn and wait for them in a task arena
+of its own (see MixHelper): waiting in the framework's arena, its
+thread could take up the task of another path and enter this worker,
+or one it waits on, again.
+
 */
 // ======================================================================
 
 #include "art/Framework/Principal/Actions.h"
+#include "art/Framework/Principal/ConsumedProduct.h"
 #include "art/Framework/Services/Registry/BranchActionType.h"
 #include "art/Framework/Principal/CurrentProcessingContext.h"
 #include "art/Framework/Principal/RunStopwatch.h"
@@ -38,6 +49,7 @@ the worker is reset().
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
 #include <iosfwd>
+#include <mutex>
 
 // ----------------------------------------------------------------------
 
@@ -78,6 +90,12 @@ public:
   /// this was done to improve performance based on profiling
   void setActivityRegistry(cet::exempt_ptr<ActivityRegistry> areg);
 
+  /// Clones of the same module on different schedules sharing a
+  /// serializer are never executed concurrently.
+  void setSerializer(std::shared_ptr<std::mutex> serializer) {
+    serializer_ = std::move(serializer);
+  }
+
   std::pair<double,double> timeCpuReal() const {
       return std::pair<double,double>(timer_.cpuTime(),timer_.realTime());
   }
@@ -95,6 +113,11 @@ public:
 
   virtual bool modifiesEvent() const = 0;
 
+  // The event products the module has declared it reads.
+  virtual ConsumedProducts const& consumedProducts() const = 0;
+  // False if the module has declared nothing, reads or not.
+  virtual bool declaresConsumes() const = 0;
+
   std::string const &label() const { return md_.moduleLabel(); }
 
 protected:
@@ -135,6 +158,12 @@ private:
   std::shared_ptr<art::Exception> cached_exception_; // if state is 'exception'
 
   cet::exempt_ptr<ActivityRegistry> actReg_;
+  std::shared_ptr<std::mutex> serializer_;
+
+  // Guards the state and counters against concurrent callers.
+  // Recursive so that re-entry from the same thread (a cycle of
+  // on-demand product dependencies) is still diagnosed below.
+  std::recursive_mutex mutex_;
 };
 
 namespace art {
@@ -180,6 +209,8 @@ bool art::Worker::doWork(typename T::MyPrincipal& ep,
   // A RunStopwatch, but only if we are processing an event.
   //std::unique_ptr<RunStopwatch> stopwatch(T::isEvent_ ? new RunStopwatch(stopwatch_) : 0);
 
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+
   if (T::isEvent_) {
     ++timesVisited_;
   }
@@ -204,6 +235,11 @@ bool art::Worker::doWork(typename T::MyPrincipal& ep,
   case Working: break; // See below.
   }
 
+  std::unique_lock<std::mutex> serialLock;
+  if (serializer_) {
+    serialLock = std::unique_lock<std::mutex>(*serializer_);
+  }
+
   try {
     if (state_ == Working) {
       // Not part of the switch statement above because we want the
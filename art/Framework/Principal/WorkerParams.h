@@ -6,6 +6,7 @@
 #include "art/Persistency/Provenance/MasterProductRegistry.h"
 #include "art/Persistency/Provenance/PassID.h"
 #include "art/Utilities/GetPassID.h"
+#include "art/Utilities/ScheduleID.h"
 #include "fhiclcpp/ParameterSet.h"
 #include <string>
 
@@ -20,13 +21,15 @@ struct art::WorkerParams {
                fhicl::ParameterSet const & pset,
                MasterProductRegistry & reg,
                ActionTable & actions,
-               std::string const & processName);
+               std::string const & processName,
+               ScheduleID scheduleID = ScheduleID::first());
 
   fhicl::ParameterSet const & procPset_;
   fhicl::ParameterSet const pset_;
   MasterProductRegistry & reg_;
   ActionTable & actions_;
   std::string const processName_;
+  ScheduleID const scheduleID_;
 };
 
 inline
@@ -35,13 +38,15 @@ WorkerParams(fhicl::ParameterSet const & procPset,
              fhicl::ParameterSet const & pset,
              MasterProductRegistry & reg,
              ActionTable & actions,
-             std::string const & processName)
+             std::string const & processName,
+             ScheduleID scheduleID)
   :
   procPset_(procPset),
   pset_(pset),
   reg_(reg),
   actions_(actions),
-  processName_(processName)
+  processName_(processName),
+  scheduleID_(scheduleID)
 {
 }
 
@@ -0,0 +1,226 @@
+#ifndef art_Framework_Principal_detail_GroupTable_h
+#define art_Framework_Principal_detail_GroupTable_h
+// vim: set sw=2:
+
+//
+// GroupTable
+//
+// Flat table of the Groups held by a Principal.
+//
+// The (BranchID, Group) entries are held contiguously in insertion
+// order, and found through an open-addressed hash index of BranchID
+// to entry position. Iteration is in insertion order; sorted() gives
+// the BranchID order of the std::map the table replaced. Filling a
+// principal therefore costs no tree node allocations, and a lookup is a
+// hash probe over a small contiguous array rather than a walk down a
+// std::map.
+//
+// As with std::map::insert(), an attempt to insert a Group for a
+// BranchID already present is ignored: the first entry wins.
+//
+// clear() keeps the allocated storage, so a table may be refilled for
+// the next event without reallocating; truncate() keeps the first
+// entries as well, for a principal reusing the Groups it was filled
+// with.
+//
+
+#include "art/Framework/Principal/Group.h"
+#include "art/Persistency/Provenance/BranchID.h"
+#include "cpp0x/memory"
+#include "cpp0x/utility"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace art {
+  namespace detail {
+    class GroupTable;
+  }
+}
+
+class art::detail::GroupTable {
+public:
+  using value_type = std::pair<BranchID, std::shared_ptr<Group>>;
+  using container_type = std::vector<value_type>;
+  using const_iterator = container_type::const_iterator;
+  using size_type = container_type::size_type;
+
+  GroupTable();
+
+  GroupTable(GroupTable const&) = delete;
+  GroupTable& operator=(GroupTable const&) = delete;
+
+  void reserve(size_type n);
+
+  void insert(value_type&& val);
+
+  const_iterator find(BranchID const& bid) const;
+
+  const_iterator begin() const { return groups_.cbegin(); }
+  const_iterator cbegin() const { return groups_.cbegin(); }
+  const_iterator end() const { return groups_.cend(); }
+  const_iterator cend() const { return groups_.cend(); }
+
+  size_type size() const { return groups_.size(); }
+  bool empty() const { return groups_.empty(); }
+
+  // The entries in BranchID order.
+  std::vector<const_iterator> sorted() const;
+
+  // Drop all entries, keeping the allocated storage.
+  void clear();
+
+  // Drop all entries but the first n, keeping the allocated storage.
+  void truncate(size_type n);
+
+private:
+  struct Slot {
+    BranchID::value_type id;
+    std::uint32_t pos;
+  };
+
+  static constexpr std::uint32_t emptySlot_()
+  {
+    return std::numeric_limits<std::uint32_t>::max();
+  }
+
+  size_type probe_(BranchID::value_type id) const;
+  void rehash_(size_type nSlots);
+
+  container_type groups_;
+  std::vector<Slot> index_; // Size is zero or a power of two.
+  unsigned shift_; // 32 - log2(index_.size()).
+};
+
+inline
+art::detail::GroupTable::
+GroupTable()
+  :
+  groups_(),
+  index_(),
+  shift_(32)
+{
+}
+
+inline
+void
+art::detail::GroupTable::
+reserve(size_type n)
+{
+  groups_.reserve(n);
+  // Keep the load factor of the index at or below one half.
+  size_type nSlots = 16;
+  while (nSlots < 2 * n) {
+    nSlots *= 2;
+  }
+  if (nSlots > index_.size()) {
+    rehash_(nSlots);
+  }
+}
+
+inline
+void
+art::detail::GroupTable::
+insert(value_type&& val)
+{
+  if (2 * (groups_.size() + 1) > index_.size()) {
+    rehash_(index_.empty() ? 16 : 2 * index_.size());
+  }
+  auto const i = probe_(val.first.id());
+  if (index_[i].pos != emptySlot_()) {
+    return; // Already present.
+  }
+  index_[i] = Slot { val.first.id(), static_cast<std::uint32_t>(groups_.size()) };
+  groups_.emplace_back(std::move(val));
+}
+
+inline
+art::detail::GroupTable::const_iterator
+art::detail::GroupTable::
+find(BranchID const& bid) const
+{
+  if (index_.empty()) {
+    return groups_.cend();
+  }
+  auto const pos = index_[probe_(bid.id())].pos;
+  return (pos == emptySlot_()) ? groups_.cend() : groups_.cbegin() + pos;
+}
+
+inline
+std::vector<art::detail::GroupTable::const_iterator>
+art::detail::GroupTable::
+sorted() const
+{
+  std::vector<const_iterator> result;
+  result.reserve(groups_.size());
+  for (auto i = groups_.cbegin(), e = groups_.cend(); i != e; ++i) {
+    result.push_back(i);
+  }
+  std::sort(result.begin(), result.end(),
+            [](const_iterator a, const_iterator b) { return a->first < b->first; });
+  return result;
+}
+
+inline
+void
+art::detail::GroupTable::
+clear()
+{
+  groups_.clear();
+  for (auto& slot : index_) {
+    slot.pos = emptySlot_();
+  }
+}
+
+inline
+void
+art::detail::GroupTable::
+truncate(size_type n)
+{
+  if (n >= groups_.size()) {
+    return;
+  }
+  groups_.erase(groups_.begin() + n, groups_.end());
+  rehash_(index_.size());
+}
+
+// Return the slot holding id, or the empty slot at which it would be
+// inserted.
+inline
+art::detail::GroupTable::size_type
+art::detail::GroupTable::
+probe_(BranchID::value_type id) const
+{
+  size_type const mask = index_.size() - 1;
+  // Knuth's multiplicative hash: the high bits of the product are the
+  // well-mixed ones, so they give the slot number.
+  size_type i = (static_cast<std::uint32_t>(id) * 2654435761u) >> shift_;
+  while (index_[i].pos != emptySlot_() && index_[i].id != id) {
+    i = (i + 1) & mask;
+  }
+  return i;
+}
+
+inline
+void
+art::detail::GroupTable::
+rehash_(size_type nSlots)
+{
+  index_.assign(nSlots, Slot { 0, emptySlot_() });
+  shift_ = 32;
+  for (size_type n = nSlots; n > 1; n /= 2) {
+    --shift_;
+  }
+  for (size_type pos = 0; pos != groups_.size(); ++pos) {
+    auto const id = groups_[pos].first.id();
+    index_[probe_(id)] = Slot { id, static_cast<std::uint32_t>(pos) };
+  }
+}
+
+#endif /* art_Framework_Principal_detail_GroupTable_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -18,6 +18,8 @@ namespace art {
   template< typename T > class Handle;
   class NoDelayedReader;
   class Principal;
+  template <typename PROD> class ProductToken;
+  class ProductTokenBase;
   class Provenance;
   class Run;
   class RunPrincipal;
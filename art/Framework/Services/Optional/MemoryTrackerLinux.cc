@@ -5,6 +5,7 @@
 // ======================================================================
 
 #include "art/Framework/Services/Optional/MemoryTracker.h"
+#include "art/Framework/Core/detail/ScheduleTask.h"
 #include "art/Framework/Services/Optional/detail/LinuxMallInfo.h"
 #include "art/Ntuple/Ntuple.h"
 #include "art/Ntuple/sqlite_helpers.h"
@@ -153,19 +154,27 @@ art::MemoryTracker::MemoryTracker(const fhicl::ParameterSet & pset,
   , includeMallocInfo_( checkMallocConfig_(pset.get<std::string>("filename",""),
                                            pset.get<bool> ("includeMallocInfo", false) )
                         )
+  , mutex_()
   , evtCount_()
+  , events_()
     // column headings
   , summaryTuple_   ( { "ProcessStep", "ModuleId", "DeltaVsize", "DeltaRSS" } )
   , eventTuple_     ( { "Run", "Subrun", "Event", "Vsize", "DeltaVsize", "RSS", "DeltaRSS" } )
   , moduleTuple_    ( { "Run", "Subrun", "Event", "PathModuleId", "Vsize", "DeltaVsize", "RSS", "DeltaRSS" } )
   , eventHeapTuple_ ( { "EvtRowId","arena", "ordblks", "keepcost", "hblkhd", "hblks", "uordblks", "fordblks" } )
   , moduleHeapTuple_( { "ModRowId","arena", "ordblks", "keepcost", "hblkhd", "hblks", "uordblks", "fordblks" } )
+  , moduleQuantileTuple_( { "PathModuleId", "Quantity", "Mean", "Median", "P90", "P99", "Max", "nEvts" } )
+  , eventArenaTuple_( { "EvtRowId", "ArenaInUse", "LargestArena" } )
     // tables
   , summaryTable_   ( dbMgr_.get(), "Summary", summaryTuple_ )
-  , eventTable_     ( dbMgr_.get(), "EventInfo" , eventTuple_ )
-  , moduleTable_    ( dbMgr_.get(), "ModuleInfo", moduleTuple_ )
-  , eventHeapTable_ ( includeMallocInfo_ ? std::make_unique<memHeap_t>( dbMgr_.get(), "EventMallocInfo" , eventHeapTuple_  ) : nullptr )
-  , moduleHeapTable_( includeMallocInfo_ ? std::make_unique<memHeap_t>( dbMgr_.get(), "ModuleMallocInfo", moduleHeapTuple_ ) : nullptr )
+    // per-event and per-module rows are written in the background
+    // when going to a file
+  , eventTable_     ( dbMgr_.get(), "EventInfo" , eventTuple_ , false, 1000u, FlushMode::background )
+  , moduleTable_    ( dbMgr_.get(), "ModuleInfo", moduleTuple_, false, 1000u, FlushMode::background )
+  , eventHeapTable_ ( includeMallocInfo_ ? std::make_unique<memHeap_t>( dbMgr_.get(), "EventMallocInfo" , eventHeapTuple_ , false, 1000u, FlushMode::background ) : nullptr )
+  , moduleHeapTable_( includeMallocInfo_ ? std::make_unique<memHeap_t>( dbMgr_.get(), "ModuleMallocInfo", moduleHeapTuple_, false, 1000u, FlushMode::background ) : nullptr )
+  , moduleQuantileTable_( dbMgr_.get(), "ModuleQuantiles", moduleQuantileTuple_, true ) // always recompute
+  , eventArenaTable_( dbMgr_.get(), "EventArenaInfo", eventArenaTuple_, false, 1000u, FlushMode::background )
     // instantiate the class templates
   , evtSource_      ( summaryTable_, procInfo_, evtCount_, "Event source"        )
   , modConstruction_( summaryTable_, procInfo_, evtCount_, "Module Construction" )
@@ -186,7 +195,6 @@ art::MemoryTracker::MemoryTracker(const fhicl::ParameterSet & pset,
   iReg.sPostModuleBeginRun    .watch( &this->modBeginRun_    , &CallbackPair<ModuleSummaryType>::post<modDesc_cref> );
   iReg.sPreModuleBeginSubRun  .watch( &this->modBeginSubRun_ , &CallbackPair<ModuleSummaryType>::pre <modDesc_cref> );
   iReg.sPostModuleBeginSubRun .watch( &this->modBeginSubRun_ , &CallbackPair<ModuleSummaryType>::post<modDesc_cref> );
-  iReg.sPreProcessPath        .watch(  this                  , &MemoryTracker::prePathProcessing  );
   iReg.sPreSource             .watch( &this->evtSource_      , &CallbackPair<SourceSummaryType>::pre  );
   iReg.sPostSource            .watch( &this->evtSource_      , &CallbackPair<SourceSummaryType>::post );
   iReg.sPreProcessEvent       .watch(  this                  , &MemoryTracker::preEventProcessing );
@@ -200,41 +208,66 @@ art::MemoryTracker::MemoryTracker(const fhicl::ParameterSet & pset,
   iReg.sPreModuleEndJob       .watch( &this->modEndJob_      , &CallbackPair<ModuleSummaryType>::pre <modDesc_cref> );
   iReg.sPostModuleEndJob      .watch( &this->modEndJob_      , &CallbackPair<ModuleSummaryType>::post<modDesc_cref> );
   iReg.sPostEndJob            .watch(  this                  , &MemoryTracker::postEndJob   );
+
+  // The background writers commit on their own connections; wait for
+  // them rather than fail when writing or reading on this one.
+  sqlite3_busy_timeout( dbMgr_.get(), 60000 );
 }
 
 //======================================================================
-void
-art::MemoryTracker::prePathProcessing(std::string const& pathname)
+thread_local std::vector<art::detail::LinuxProcData::proc_array> art::MemoryTracker::modData_;
+
+//======================================================================
+art::MemoryTracker::EventState&
+art::MemoryTracker::eventState_()
 {
-  pathname_ = pathname;
+  // Without schedule tasks (one schedule), there is no current schedule.
+  auto const sid = ScheduleScope::scheduleID();
+  std::size_t const i = sid.isValid() ? sid.id() : 0u;
+  if ( i >= events_.size() ) events_.resize( i+1 );
+  return events_[i];
 }
 
 //======================================================================
 void
 art::MemoryTracker::preEventProcessing(const Event & e)
 {
-  ++evtCount_;
-  eventId_ = e.id();
-  evtData_ = procInfo_.getCurrentData();
+  auto const data = procInfo_.getCurrentData();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto & event = eventState_();
+  event.skipped = ++evtCount_ <= numToSkip_;
+  event.id      = e.id();
+  event.data    = data;
 }
 
 void
 art::MemoryTracker::postEventProcessing(const Event &)
 {
 
-  auto const data   = procInfo_.getCurrentData();
-  auto const deltas = data-evtData_;
+  auto const data = procInfo_.getCurrentData();
 
-  if (evtCount_ <= numToSkip_) { return; }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto const & event = eventState_();
+  if ( event.skipped ) { return; }
 
-  eventTable_.insert( eventId_.run(),
-                      eventId_.subRun(),
-                      eventId_.event(),
+  auto const deltas = data-event.data;
+
+  eventTable_.insert( event.id.run(),
+                      event.id.subRun(),
+                      event.id.event(),
                       data.at(LinuxProcData::VSIZE),
                       deltas.at(LinuxProcData::VSIZE),
                       data.at(LinuxProcData::RSS),
                       deltas.at(LinuxProcData::RSS) );
 
+  // Memory held in the arenas of the events being processed, which is
+  // given back in bulk when they are done.
+  auto const arenas = MonotonicArena::statistics();
+  eventArenaTable_.insert( eventTable_.lastRowid(),
+                           arenas.bytesInUse/1048576.,
+                           arenas.largestArena/1048576. );
+
   if ( includeMallocInfo_ ) {
     auto minfo = LinuxMallInfo().get();
     eventHeapTable_->insert( eventTable_.lastRowid(),
@@ -253,21 +286,31 @@ art::MemoryTracker::postEventProcessing(const Event &)
 void
 art::MemoryTracker::preModule(ModuleDescription const &)
 {
-  modData_ = procInfo_.getCurrentData();
+  modData_.push_back( procInfo_.getCurrentData() );
 }
 
 void
 art::MemoryTracker::postModule(ModuleDescription const & md)
 {
   auto const data   = procInfo_.getCurrentData();
-  auto const deltas = data-modData_;
+  auto const deltas = data-modData_.back();
+  modData_.pop_back();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto const & event = eventState_();
+  if ( event.skipped ) { return; }
 
-  if (evtCount_ <= numToSkip_) { return; }
+  auto const pathname = ScheduleScope::pathName();
+  std::string const id = (pathname ? *pathname : ""s)+":"s+md.moduleLabel()+":"s+md.moduleName();
 
-  moduleTable_.insert( eventId_.run(),
-                       eventId_.subRun(),
-                       eventId_.event(),
-                       pathname_+":"s+md.moduleLabel()+":"s+md.moduleName(),
+  auto & summaries = modDeltas_[id];
+  summaries.first .add( deltas.at(LinuxProcData::VSIZE) );
+  summaries.second.add( deltas.at(LinuxProcData::RSS  ) );
+
+  moduleTable_.insert( event.id.run(),
+                       event.id.subRun(),
+                       event.id.event(),
+                       id,
                        data.at(LinuxProcData::VSIZE),
                        deltas.at(LinuxProcData::VSIZE),
                        data.at(LinuxProcData::RSS),
@@ -291,6 +334,17 @@ art::MemoryTracker::postModule(ModuleDescription const & md)
 void
 art::MemoryTracker::postEndJob()
 {
+  // Finish all background writes before the summaries are written
+  // and read.
+  eventTable_.flush();
+  moduleTable_.flush();
+  eventArenaTable_.flush();
+  if ( includeMallocInfo_ ) {
+    eventHeapTable_->flush();
+    moduleHeapTable_->flush();
+  }
+
+  if ( dbMgr_.logToDb() ) writeModuleQuantiles_();
 
   if ( printSummary_.none() ) return;
 
@@ -373,6 +427,28 @@ art::MemoryTracker::checkMallocConfig_( std::string const& dbfilename,
   return include;
 }
 
+//======================================================================
+void
+art::MemoryTracker::writeModuleQuantiles_()
+{
+  auto insert = [this]( std::string const& mod, std::string const& quantity, StreamingSummary const& s ) {
+    moduleQuantileTable_.insert( mod,
+                                 quantity,
+                                 s.mean(),
+                                 s.median(),
+                                 s.quantile(0.9),
+                                 s.quantile(0.99),
+                                 s.max(),
+                                 s.count() );
+  };
+
+  for ( auto const & mod : modDeltas_ ) {
+    insert( mod.first, "DeltaVsize", mod.second.first  );
+    insert( mod.first, "DeltaRSS"  , mod.second.second );
+  }
+  moduleQuantileTable_.flush();
+}
+
 //======================================================================
 void
 art::MemoryTracker::generalSummary_( std::ostringstream& oss )
@@ -389,7 +465,13 @@ art::MemoryTracker::generalSummary_( std::ostringstream& oss )
 
   const std::string rule = std::string(sWidth+2+mWidth+2+2*12,'=');
 
+  auto const arenas = MonotonicArena::statistics();
+
   oss << "  Peak virtual memory usage (VmPeak): " << procInfo_.getVmPeak() << " Mbytes"
+      << "\n"
+      << "  Peak memory in event arenas: " << arenas.peakBytesInUse/1048576. << " Mbytes"
+      << "\n"
+      << "  Largest single event arena: " << arenas.largestArena/1048576. << " Mbytes"
       << "\n\n"
       << setw(sWidth+2) << "ProcessStep"
       << setw(mWidth+2) << "Module ID/Event No."
@@ -5,23 +5,35 @@
 //
 // MemoryTracker
 //
+// The event and module signals may come from several threads at once
+// (several schedules, concurrent paths, producers or output modules).
+// Module baselines are kept per thread, the event being tracked per
+// schedule, and everything else is guarded by a mutex.  The Vsize and
+// RSS deltas are those of the whole process, so they include the
+// memory used by whatever else ran meanwhile.
+//
 // ======================================================================
 
 #include "art/Framework/Principal/Event.h"
 #include "art/Framework/Services/Optional/detail/LinuxProcData.h"
 #include "art/Framework/Services/Optional/detail/LinuxProcMgr.h"
 #include "art/Framework/Services/Optional/detail/MemoryTrackerLinuxCallbackPair.h"
+#include "art/Framework/Services/Optional/detail/StreamingSummary.h"
 #include "art/Framework/Services/Registry/ActivityRegistry.h"
 #include "art/Ntuple/Ntuple.h"
 #include "art/Ntuple/sqlite_DBmanager.h"
 #include "art/Persistency/Provenance/EventID.h"
 #include "art/Persistency/Provenance/ModuleDescription.h"
+#include "art/Utilities/MonotonicArena.h"
 #include "cetlib/exempt_ptr.h"
 #include "fhiclcpp/ParameterSet.h"
 
 #include <bitset>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <tuple>
+#include <vector>
 
 namespace art {
 
@@ -30,9 +42,6 @@ namespace art {
 
     MemoryTracker(fhicl::ParameterSet const &, ActivityRegistry &);
 
-    // Path level
-    void prePathProcessing(std::string const&);
-
     // Event level
     void preEventProcessing (Event const &);
     void postEventProcessing(Event const &);
@@ -54,6 +63,7 @@ namespace art {
     void generalSummary_( std::ostringstream& );
     void eventSummary_  ( std::ostringstream&, std::string const& col, std::string const& header );
     void moduleSummary_ ( std::ostringstream&, std::string const& col, std::string const& header );
+    void writeModuleQuantiles_();
 
     detail::LinuxProcMgr procInfo_;
 
@@ -63,12 +73,26 @@ namespace art {
     sqlite::DBmanager dbMgr_;
     bool     includeMallocInfo_;
 
-    std::string pathname_;
-    detail::LinuxProcData::proc_array evtData_;
-    art::EventID eventId_;
+    // The event being processed by a schedule.
+    struct EventState {
+      detail::LinuxProcData::proc_array data;
+      art::EventID id;
+      bool skipped {true};
+    };
+
+    // The state of the calling thread's schedule; mutex_ must be held.
+    EventState& eventState_();
+
+    std::mutex   mutex_;
     std::size_t  evtCount_;
+    std::vector<EventState> events_;
+
+    // Baselines of the modules running on each thread, innermost last.
+    static thread_local std::vector<detail::LinuxProcData::proc_array> modData_;
 
-    detail::LinuxProcData::proc_array modData_;
+    // Streaming summaries of the per-module Vsize and RSS increments,
+    // keyed by path:label:type.
+    std::map<std::string,std::pair<detail::StreamingSummary,detail::StreamingSummary>> modDeltas_;
 
     template<unsigned SIZE>
     using name_array = ntuple::name_array<SIZE>;
@@ -78,17 +102,23 @@ namespace art {
     name_array<8u> moduleTuple_;
     name_array<8u> eventHeapTuple_;
     name_array<8u> moduleHeapTuple_;
+    name_array<8u> moduleQuantileTuple_;
+    name_array<3u> eventArenaTuple_;
 
-    using memSummary_t = ntuple::Ntuple<std::string,std::string,double,double>;
-    using memEvent_t   = ntuple::Ntuple<uint32_t,uint32_t,uint32_t,double,double,double,double>;
-    using memModule_t  = ntuple::Ntuple<uint32_t,uint32_t,uint32_t,std::string,double,double,double,double>;
-    using memHeap_t    = ntuple::Ntuple<sqlite_int64,int,int,int,int,int,int,int>;
+    using memSummary_t  = ntuple::Ntuple<std::string,std::string,double,double>;
+    using memEvent_t    = ntuple::Ntuple<uint32_t,uint32_t,uint32_t,double,double,double,double>;
+    using memModule_t   = ntuple::Ntuple<uint32_t,uint32_t,uint32_t,std::string,double,double,double,double>;
+    using memHeap_t     = ntuple::Ntuple<sqlite_int64,int,int,int,int,int,int,int>;
+    using memQuantile_t = ntuple::Ntuple<std::string,std::string,double,double,double,double,double,uint32_t>;
+    using memArena_t    = ntuple::Ntuple<sqlite_int64,double,double>;
 
     memSummary_t summaryTable_;
     memEvent_t   eventTable_;
     memModule_t  moduleTable_;
     std::unique_ptr<memHeap_t> eventHeapTable_;
     std::unique_ptr<memHeap_t> moduleHeapTable_;
+    memQuantile_t moduleQuantileTable_;
+    memArena_t    eventArenaTable_;
 
     template<typename T>
     using CallbackPair      = detail::CallbackPair<T>;
@@ -0,0 +1,10 @@
+#ifndef art_Framework_Services_Optional_PerfCounterTracker_h
+#define art_Framework_Services_Optional_PerfCounterTracker_h
+
+#ifdef __linux__
+#  include "art/Framework/Services/Optional/PerfCounterTrackerLinux.h"
+#elif  __APPLE__
+#  include "art/Framework/Services/Optional/PerfCounterTrackerDarwin.h"
+#endif
+
+#endif // art_Framework_Services_Optional_PerfCounterTracker_h
@@ -0,0 +1,35 @@
+#ifndef art_Framework_Services_Optional_PerfCounterTrackerDarwin_h
+#define art_Framework_Services_Optional_PerfCounterTrackerDarwin_h
+
+// ======================================================================
+//
+// PerfCounterTrackerDarwin
+//
+// ======================================================================
+
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+namespace art   { class ActivityRegistry; }
+namespace fhicl { class ParameterSet;     }
+
+namespace art {
+
+  class PerfCounterTracker {
+  public:
+
+    PerfCounterTracker(fhicl::ParameterSet const &, ActivityRegistry &) {
+      mf::LogAbsolute("PerfCounterTracker") << "\n"
+                                            << "Service currently not supported for this operating system.\n"
+                                            << "If desired, please log an issue with:\n\n"
+                                            << "https://cdcvs.fnal.gov/redmine/projects/cet-is/issues/new\n\n";
+    }
+
+  };
+
+}  // art
+
+#endif // art_Framework_Services_Optional_PerfCounterTrackerDarwin_h
+
+// Local variables:
+// mode: c++
+// End:
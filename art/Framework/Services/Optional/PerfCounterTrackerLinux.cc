@@ -0,0 +1,187 @@
+// ======================================================================
+//
+// PerfCounterTracker
+//
+// ======================================================================
+
+#include "art/Framework/Services/Optional/PerfCounterTracker.h"
+#include "boost/format.hpp"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <sstream>
+
+using namespace std::string_literals;
+using art::detail::LinuxPerfEventGroup;
+using std::setw;
+
+namespace {
+
+  // Misses per thousand instructions, and instructions per cycle.
+  double perKilo( std::uint64_t const n, std::uint64_t const instructions )
+  {
+    return instructions == 0 ? 0. : 1000.*n/instructions;
+  }
+
+  double ratio( std::uint64_t const n, std::uint64_t const d )
+  {
+    return d == 0 ? 0. : static_cast<double>(n)/d;
+  }
+
+  // Generation 0 is never used, so that no thread starts with a
+  // valid cached state.
+  std::atomic<std::size_t> nextGeneration {1};
+
+}
+
+thread_local art::PerfCounterTracker::CachedThreadState art::PerfCounterTracker::threadState_c_ {0, nullptr};
+
+//======================================================================
+art::PerfCounterTracker::PerfCounterTracker(fhicl::ParameterSet const & pset,
+                                            ActivityRegistry & iReg)
+  : printSummary_( pset.get<bool>("printSummary", true) )
+  , generation_( nextGeneration++ )
+  , mutex_()
+  , threads_()
+{
+  auto const & group = threadState_().group;
+  if ( !group.isAvailable() ) {
+    mf::LogWarning("PerfCounterTracker")
+      << "Hardware counters are not available (" << group.reason() << ").\n"
+      << "No counts will be reported.\n";
+    return;
+  }
+
+  iReg.sPreModule .watch( this, &PerfCounterTracker::preModule  );
+  iReg.sPostModule.watch( this, &PerfCounterTracker::postModule );
+  iReg.sPostEndJob.watch( this, &PerfCounterTracker::postEndJob );
+}
+
+//======================================================================
+art::PerfCounterTracker::ThreadState&
+art::PerfCounterTracker::threadState_()
+{
+  if ( threadState_c_.generation != generation_ ) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    threads_.emplace_back( std::make_unique<ThreadState>() );
+    threadState_c_ = { generation_, threads_.back().get() };
+  }
+  return *threadState_c_.state;
+}
+
+//======================================================================
+void
+art::PerfCounterTracker::preModule(ModuleDescription const &)
+{
+  auto & state = threadState_();
+  // Read last, so the bookkeeping above is not counted.
+  state.starts.emplace_back();
+  state.starts.back() = state.group.read();
+}
+
+void
+art::PerfCounterTracker::postModule(ModuleDescription const & md)
+{
+  auto & state = threadState_();
+  // Read first, for the same reason.
+  auto const end = state.group.read();
+  if ( state.starts.empty() ) return;
+
+  auto & mod = state.counts[md.moduleLabel()];
+  ++mod.calls;
+  for ( std::size_t i = 0; i != end.size(); ++i ) {
+    mod.counts[i] += end[i]-state.starts.back()[i];
+  }
+  state.starts.pop_back();
+}
+
+//======================================================================
+void
+art::PerfCounterTracker::postEndJob()
+{
+  if ( !printSummary_ ) return;
+
+  // Merge the per-thread counts.
+  counts_map merged;
+  std::array<bool,LinuxPerfEventGroup::ncounters> available {{}};
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for ( auto const & state : threads_ ) {
+      for ( std::size_t i = 0; i != available.size(); ++i ) {
+        available[i] = available[i] || state->group.isAvailable(static_cast<LinuxPerfEventGroup::counter_type>(i));
+      }
+      for ( auto const & entry : state->counts ) {
+        auto & mod = merged[entry.first];
+        mod.calls += entry.second.calls;
+        for ( std::size_t i = 0; i != mod.counts.size(); ++i ) {
+          mod.counts[i] += entry.second.counts[i];
+        }
+      }
+    }
+  }
+
+  // Most cycles first.
+  std::vector<std::pair<std::string,ModuleCounts>> modules( merged.cbegin(), merged.cend() );
+  std::stable_sort( modules.begin(), modules.end(),
+                    [](auto const & a, auto const & b) {
+                      return a.second.counts[LinuxPerfEventGroup::CYCLES] > b.second.counts[LinuxPerfEventGroup::CYCLES];
+                    } );
+
+  ModuleCounts total;
+  std::size_t width(30);
+  for ( auto const & mod : modules ) {
+    width = std::max( width, mod.first.size() );
+    total.calls += mod.second.calls;
+    for ( std::size_t i = 0; i != total.counts.size(); ++i ) {
+      total.counts[i] += mod.second.counts[i];
+    }
+  }
+
+  auto printLine = [width](std::ostringstream & oss, std::string const & name, ModuleCounts const & c) {
+    oss << setw(width) << std::left << name << "  "
+        << boost::format(" %=10d ") % c.calls
+        << boost::format(" %=12.4g ") % static_cast<double>( c.counts[LinuxPerfEventGroup::CYCLES] )
+        << boost::format(" %=12.4g ") % static_cast<double>( c.counts[LinuxPerfEventGroup::INSTRUCTIONS] )
+        << boost::format(" %=8.3f ") % ratio( c.counts[LinuxPerfEventGroup::INSTRUCTIONS], c.counts[LinuxPerfEventGroup::CYCLES] )
+        << boost::format(" %=12.3f ") % perKilo( c.counts[LinuxPerfEventGroup::CACHE_MISSES], c.counts[LinuxPerfEventGroup::INSTRUCTIONS] )
+        << boost::format(" %=12.3f ") % perKilo( c.counts[LinuxPerfEventGroup::BRANCH_MISSES], c.counts[LinuxPerfEventGroup::INSTRUCTIONS] )
+        << "\n";
+  };
+
+  std::size_t const ruleWidth = width+2+12+2*14+10+2*14;
+
+  std::ostringstream msgOss;
+  msgOss << std::string(ruleWidth,'=') << "\n";
+  msgOss << setw(width+2) << std::left << "PerfCounterTracker (user space)"
+         << boost::format(" %=10s ") % "Calls"
+         << boost::format(" %=12s ") % "Cycles"
+         << boost::format(" %=12s ") % "Instructions"
+         << boost::format(" %=8s ") % "IPC"
+         << boost::format(" %=12s ") % "Cache MPKI"
+         << boost::format(" %=12s ") % "Branch MPKI"
+         << "\n";
+  msgOss << std::string(ruleWidth,'=') << "\n";
+
+  for ( auto const & mod : modules ) {
+    printLine( msgOss, mod.first, mod.second );
+  }
+  msgOss << std::string(ruleWidth,'-') << "\n";
+  printLine( msgOss, "Total", total );
+  msgOss << std::string(ruleWidth,'=') << "\n";
+
+  for ( std::size_t i = 0; i != available.size(); ++i ) {
+    if ( !available[i] ) {
+      msgOss << " The " << LinuxPerfEventGroup::name(static_cast<LinuxPerfEventGroup::counter_type>(i))
+             << " counter could not be opened; its column is zero.\n";
+    }
+  }
+  msgOss << " MPKI: misses per thousand instructions.\n";
+
+  mf::LogAbsolute("PerfCounterTracker") << msgOss.str();
+}
+
+// Local variables:
+// mode: c++
+// End:
@@ -0,0 +1,93 @@
+#ifndef art_Framework_Services_Optional_PerfCounterTrackerLinux_h
+#define art_Framework_Services_Optional_PerfCounterTrackerLinux_h
+
+// ======================================================================
+//
+// PerfCounterTracker
+//
+// Counts CPU cycles, instructions, cache misses and branch misses in
+// user space around each module invocation, using a group of
+// hardware counters per thread (see detail/LinuxPerfEventGroup.h),
+// and at end of job reports the totals, instructions per cycle and
+// misses per thousand instructions for each module label.
+//
+// Reading the group costs one read(2) before and one after each
+// module; the counts are accumulated per thread, without locking,
+// and merged at end of job.
+//
+// If the counters cannot be opened, a warning is issued and the
+// service does nothing.
+//
+// ======================================================================
+
+#include "art/Framework/Services/Optional/detail/LinuxPerfEventGroup.h"
+#include "art/Framework/Services/Registry/ActivityRegistry.h"
+#include "art/Persistency/Provenance/ModuleDescription.h"
+#include "fhiclcpp/ParameterSet.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace art {
+
+  class PerfCounterTracker {
+  public:
+
+    PerfCounterTracker(fhicl::ParameterSet const &, ActivityRegistry &);
+
+    // Module level
+    void preModule (ModuleDescription const &);
+    void postModule(ModuleDescription const &);
+
+    // Wrap up
+    void postEndJob();
+
+  private:
+
+    using counter_array = detail::LinuxPerfEventGroup::counter_array;
+
+    struct ModuleCounts {
+      std::size_t   calls {0};
+      counter_array counts {{}};
+    };
+
+    using counts_map = std::unordered_map<std::string,ModuleCounts>;
+
+    struct ThreadState {
+      detail::LinuxPerfEventGroup group;
+      std::vector<counter_array> starts; // One per module in progress.
+      counts_map counts;
+    };
+
+    ThreadState& threadState_();
+
+    bool printSummary_;
+
+    // Distinguishes this service from earlier ones, which may have had
+    // the same address, in the state cached by each thread.
+    std::size_t const generation_;
+
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<ThreadState>> threads_;
+
+    // The state of the current thread for the tracker of generation
+    // `generation`; state is only used if that is still this tracker.
+    struct CachedThreadState {
+      std::size_t generation;
+      ThreadState* state;
+    };
+
+    static thread_local CachedThreadState threadState_c_;
+
+  }; // PerfCounterTracker
+
+}  // art
+
+#endif // art_Framework_Services_Optional_PerfCounterTrackerLinux_h
+
+// Local variables:
+// mode: c++
+// End:
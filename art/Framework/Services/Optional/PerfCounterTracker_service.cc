@@ -0,0 +1,11 @@
+#include "art/Framework/Services/Registry/ServiceMacros.h"
+#include "art/Framework/Services/Optional/PerfCounterTracker.h"
+
+// ======================================================================
+
+// The DECLARE macro call should be moved to the header file, should you
+// create one.
+DECLARE_ART_SERVICE(art::PerfCounterTracker, LEGACY)
+DEFINE_ART_SERVICE(art::PerfCounterTracker)
+
+// ======================================================================
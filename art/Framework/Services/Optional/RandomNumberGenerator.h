@@ -18,6 +18,11 @@
 // as desired.  However, by design, source modules are permitted to make
 // no use of this Service.
 //
+// Engines, snapshots and saved states are kept per module label, so
+// the Service cannot be used with more than one schedule
+// (services.scheduler.num_schedules); such a job is refused at
+// configuration.
+//
 // ======================================================================
 // Creating an engine
 // ------------------
@@ -5,9 +5,28 @@
 //
 // TimeTracker
 //
+// The end-of-job summary is made from constant-memory streaming
+// summaries (see detail/StreamingSummary.h) of the full-event, path
+// and module times, accumulated as the job runs.  The times of
+// individual events and modules are written to the TimeEvent and
+// TimeModule tables only if a database file is given and
+// 'dbOutput.includeRows' is true (the default).
+//
+// With 'samplingInterval: N', only the first of every N events is
+// timed.
+//
+// With 'perModule: false', only the full-event and path times are
+// recorded.
+//
+// The signals watched may come from several threads at once (several
+// schedules, concurrent paths, producers or output modules). Path and
+// module start times are kept per thread, the event being timed per
+// schedule, and everything else is guarded by a mutex.
+//
 // ======================================================================
 
 #include "art/Framework/Principal/Event.h"
+#include "art/Framework/Services/Optional/detail/StreamingSummary.h"
 #include "art/Framework/Services/Registry/ActivityRegistry.h"
 #include "art/Ntuple/Ntuple.h"
 #include "art/Ntuple/sqlite_DBmanager.h"
@@ -17,7 +36,12 @@
 #include "fhiclcpp/ParameterSet.h"
 #include "tbb/tick_count.h"
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace art {
 
@@ -29,6 +53,7 @@ namespace art {
   private:
 
     void prePathProcessing(std::string const&);
+    void postPathProcessing(std::string const&, HLTPathStatus const&);
 
     void postEndJob();
 
@@ -38,28 +63,62 @@ namespace art {
     void preModule(ModuleDescription const&);
     void postModule(ModuleDescription const&);
 
-    std::string pathname_;
-    EventID eventId_;
-    tbb::tick_count eventStart_;
-    tbb::tick_count moduleStart_;
+    // Summaries in order of first appearance.
+    class SummaryList {
+    public:
+      detail::StreamingSummary& operator[](std::string const& name);
+
+      auto begin() const { return summaries_.cbegin(); }
+      auto end  () const { return summaries_.cend  (); }
+
+    private:
+      std::vector<std::pair<std::string,detail::StreamingSummary>> summaries_;
+      std::unordered_map<std::string,std::size_t> index_;
+    };
+
+    // The event being processed by a schedule.
+    struct EventState {
+      EventID id;
+      tbb::tick_count start;
+      bool sampled {false};
+    };
+
+    // The state of the calling thread's schedule; mutex_ must be held.
+    EventState& eventState_();
 
     bool printSummary_;
+    unsigned samplingInterval_;
+
+    std::mutex mutex_;
+    std::size_t eventCount_;
+    std::vector<EventState> events_;
+
+    // Start times of the paths and modules running on each thread,
+    // innermost last.
+    static thread_local std::vector<tbb::tick_count> pathStarts_;
+    static thread_local std::vector<tbb::tick_count> moduleStarts_;
+
     sqlite::DBmanager dbMgr_;
     bool overwriteContents_;
+    bool includeRows_;
+
+    detail::StreamingSummary eventSummary_;
+    SummaryList pathSummaries_;
+    SummaryList moduleSummaries_;
 
     template<unsigned SIZE>
     using name_array = ntuple::name_array<SIZE>;
-    name_array<7u> timeReportTuple_;
+    name_array<9u> timeReportTuple_;
     name_array<4u> timeEventTuple_;
     name_array<5u> timeModuleTuple_;
 
-    using timeReport_t = ntuple::Ntuple<std::string,double,double,double,double,double,uint32_t>;
+    using timeReport_t = ntuple::Ntuple<std::string,double,double,double,double,double,double,double,uint32_t>;
     using timeEvent_t  = ntuple::Ntuple<uint32_t,uint32_t,uint32_t,double>;
     using timeModule_t = ntuple::Ntuple<uint32_t,uint32_t,uint32_t,std::string,double>;
 
     timeReport_t timeReportTable_;
-    timeEvent_t  timeEventTable_;
-    timeModule_t timeModuleTable_;
+    std::unique_ptr<timeEvent_t>  timeEventTable_;
+    std::unique_ptr<timeModule_t> timeModuleTable_;
 
   };  // TimeTracker
 
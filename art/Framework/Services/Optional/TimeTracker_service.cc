@@ -5,8 +5,9 @@
 // ======================================================================
 
 #include "art/Framework/Services/Optional/TimeTracker.h"
+#include "art/Framework/Core/detail/ScheduleTask.h"
 #include "art/Framework/Services/Registry/ServiceMacros.h"
-#include "art/Ntuple/sqlite_helpers.h"
+#include "art/Utilities/Exception.h"
 #include "boost/format.hpp"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
@@ -23,6 +24,31 @@ namespace {
 
   auto now = std::bind(&tbb::tick_count::now);
 
+  unsigned checkSamplingInterval(unsigned const interval)
+  {
+    if ( interval == 0 ) {
+      throw art::Exception(art::errors::Configuration)
+        << "TimeTracker: 'samplingInterval' must be at least 1.\n";
+    }
+    return interval;
+  }
+
+  void printLine( std::ostringstream& oss,
+                  std::size_t const width,
+                  std::string const& name,
+                  art::detail::StreamingSummary const& s )
+  {
+    oss << setw(width) << name << "  "
+        << boost::format(" %=12g ") % s.min()
+        << boost::format(" %=12g ") % s.mean()
+        << boost::format(" %=12g ") % s.max()
+        << boost::format(" %=12g ") % s.median()
+        << boost::format(" %=12g ") % s.quantile(0.9)
+        << boost::format(" %=12g ") % s.quantile(0.99)
+        << boost::format(" %=12g ") % s.rms()
+        << boost::format(" %=10d ") % s.count() << "\n";
+  }
+
 }
 
 // ======================================================================
@@ -30,175 +56,212 @@ namespace {
 art::
 TimeTracker::TimeTracker(fhicl::ParameterSet const& iPS, ActivityRegistry& iRegistry)
   : printSummary_(iPS.get<bool>("printSummary", true))
+  , samplingInterval_ ( checkSamplingInterval( iPS.get<unsigned>("samplingInterval", 1u) ) )
+  , mutex_()
+  , eventCount_()
+  , events_()
   , dbMgr_            ( iPS.get<std::string>("dbOutput.filename","") )
   , overwriteContents_( iPS.get<bool>("dbOutput.overwrite",false) )
+  , includeRows_      ( dbMgr_.logToDb() && iPS.get<bool>("dbOutput.includeRows",true) )
     // table headers
-  , timeReportTuple_( {"ReportType","Min","Mean","Max","Median","RMS","nEvts" } )
+  , timeReportTuple_( {"ReportType","Min","Mean","Max","Median","P90","P99","RMS","nEvts" } )
   , timeEventTuple_ ( {"Run","Subrun","Event","Time" } )
   , timeModuleTuple_( {"Run","Subrun","Event","PathModuleId","Time"} )
     // tables
   , timeReportTable_( dbMgr_.get(), "TimeReport", timeReportTuple_, true ) // always recompute reports
-  , timeEventTable_ ( dbMgr_.get(), "TimeEvent" , timeEventTuple_ , overwriteContents_ )
-  , timeModuleTable_( dbMgr_.get(), "TimeModule", timeModuleTuple_, overwriteContents_ )
+  , timeEventTable_ ( includeRows_ ? std::make_unique<timeEvent_t> ( dbMgr_.get(), "TimeEvent" , timeEventTuple_ , overwriteContents_, 1000u, FlushMode::background ) : nullptr )
+  , timeModuleTable_( includeRows_ ? std::make_unique<timeModule_t>( dbMgr_.get(), "TimeModule", timeModuleTuple_, overwriteContents_, 1000u, FlushMode::background ) : nullptr )
 
 {
   iRegistry.sPreProcessPath.watch(this, &TimeTracker::prePathProcessing);
+  iRegistry.sPostProcessPath.watch(this, &TimeTracker::postPathProcessing);
 
   iRegistry.sPostEndJob.watch(this, &TimeTracker::postEndJob);
 
   iRegistry.sPreProcessEvent.watch(this, &TimeTracker::preEventProcessing);
   iRegistry.sPostProcessEvent.watch(this, &TimeTracker::postEventProcessing);
 
-  iRegistry.sPreModule.watch(this, &TimeTracker::preModule);
-  iRegistry.sPostModule.watch(this, &TimeTracker::postModule);
+  // Without per-module times, leave the module signals unwatched so
+  // they cost the modules nothing.
+  if ( iPS.get<bool>("perModule", true) ) {
+    iRegistry.sPreModule.watch(this, &TimeTracker::preModule);
+    iRegistry.sPostModule.watch(this, &TimeTracker::postModule);
+  }
+
+  // The background writers commit on their own connections; wait for
+  // them rather than fail when writing on this one.
+  sqlite3_busy_timeout(dbMgr_.get(), 60000);
 }
 
 //======================================================================
-void art::TimeTracker::prePathProcessing(std::string const& pathname)
+thread_local std::vector<tbb::tick_count> art::TimeTracker::pathStarts_;
+thread_local std::vector<tbb::tick_count> art::TimeTracker::moduleStarts_;
+
+//======================================================================
+art::detail::StreamingSummary&
+art::TimeTracker::SummaryList::operator[](std::string const& name)
 {
-  pathname_ = pathname;
+  auto const it = index_.emplace(name, summaries_.size()).first;
+  if ( it->second == summaries_.size() ) {
+    summaries_.emplace_back(name, detail::StreamingSummary());
+  }
+  return summaries_[it->second].second;
 }
 
 //======================================================================
-void art::TimeTracker::postEndJob()
+art::TimeTracker::EventState&
+art::TimeTracker::eventState_()
 {
+  // Without schedule tasks (one schedule), there is no current schedule.
+  auto const sid = detail::ScheduleScope::scheduleID();
+  std::size_t const i = sid.isValid() ? sid.id() : 0u;
+  if ( i >= events_.size() ) events_.resize( i+1 );
+  return events_[i];
+}
 
-  timeEventTable_ .flush();
+//======================================================================
+void art::TimeTracker::prePathProcessing(std::string const&)
+{
+  pathStarts_.push_back( now() );
+}
 
-  double const evtTime_min    = sqlite::min   ( dbMgr_.get(), "TimeEvent", "Time" );
-  double const evtTime_max    = sqlite::max   ( dbMgr_.get(), "TimeEvent", "Time" );
-  double const evtTime_mean   = sqlite::mean  ( dbMgr_.get(), "TimeEvent", "Time" );
-  double const evtTime_median = sqlite::median( dbMgr_.get(), "TimeEvent", "Time" );
-  double const evtTime_rms    = sqlite::rms   ( dbMgr_.get(), "TimeEvent", "Time" );
+void art::TimeTracker::postPathProcessing(std::string const& pathname, HLTPathStatus const&)
+{
+  double const t = (now()-pathStarts_.back()).seconds();
+  pathStarts_.pop_back();
 
-  if ( dbMgr_.logToDb() ) {
-    timeReportTable_.insert( "Full event",
-                             evtTime_min,
-                             evtTime_mean,
-                             evtTime_max,
-                             evtTime_median,
-                             evtTime_rms,
-                             timeEventTable_.lastRowid() );
-  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if ( !eventState_().sampled ) return;
+  pathSummaries_[pathname].add( t );
+}
 
-  // This done here (instead of later) to determine the formatting
-  // width in the printout
-  timeModuleTable_.flush();
-  const std::vector<std::string> modules
-    = sqlite::getUniqueEntries<std::string>( dbMgr_.get(), "TimeModule", "PathModuleId" );
+//======================================================================
+void art::TimeTracker::postEndJob()
+{
 
-  std::size_t width(30);
-  std::for_each( modules.begin(),
-                 modules.end(),
-                 [&width](const auto& id) { width = std::max( width, id.size() ); } );
+  // Finish all background writes before the reports are written.
+  if ( includeRows_ ) {
+    timeEventTable_->flush();
+    timeModuleTable_->flush();
+  }
 
-  std::ostringstream msgOss;
+  if ( dbMgr_.logToDb() ) {
 
-  if ( printSummary_ ) {
-    msgOss << std::string(width+4+5*14+12,'=') << "\n";
-    msgOss << std::setw(width+2) << std::left << "TimeTracker printout (sec)"
-           << boost::format(" %=12s ") % "Min"
-           << boost::format(" %=12s ") % "Avg"
-           << boost::format(" %=12s ") % "Max"
-           << boost::format(" %=12s ") % "Median"
-           << boost::format(" %=12s ") % "RMS"
-           << boost::format(" %=10s ") % "nEvts" << "\n";
-
-    msgOss << std::string(width+4+5*14+12,'=') << "\n";
-
-    msgOss << setw(width) << "Full event" << "  "
-           << boost::format(" %=12g ") % evtTime_min
-           << boost::format(" %=12g ") % evtTime_mean
-           << boost::format(" %=12g ") % evtTime_max
-           << boost::format(" %=12g ") % evtTime_median
-           << boost::format(" %=12g ") % evtTime_rms
-           << boost::format(" %=10d ") % timeEventTable_.lastRowid() << "\n";
-
-    msgOss << std::string(width+4+5*14+12,'-') << "\n";
+    auto insert = [this](std::string const& name, detail::StreamingSummary const& s) {
+      timeReportTable_.insert( name,
+                               s.min(),
+                               s.mean(),
+                               s.max(),
+                               s.median(),
+                               s.quantile(0.9),
+                               s.quantile(0.99),
+                               s.rms(),
+                               s.count() );
+    };
+
+    insert( "Full event", eventSummary_ );
+    for ( auto const& path : pathSummaries_   ) insert( "Path "s+path.first, path.second );
+    for ( auto const& mod  : moduleSummaries_ ) insert( mod.first, mod.second );
   }
 
+  if ( !printSummary_ ) return;
 
-  for ( auto const & mod : modules ) {
+  std::size_t width(30);
+  for ( auto const& path : pathSummaries_   ) width = std::max( width, "Path "s.size()+path.first.size() );
+  for ( auto const& mod  : moduleSummaries_ ) width = std::max( width, mod.first.size() );
 
-    std::string const ddl =
-      "CREATE TABLE temp.tmpModTable AS "s +
-      "SELECT * FROM TimeModule WHERE PathModuleId='"s+mod+"'"s;
+  std::ostringstream msgOss;
 
-    sqlite::exec( dbMgr_.get(), ddl );
+  msgOss << std::string(width+4+7*14+12,'=') << "\n";
+  msgOss << std::setw(width+2) << std::left << "TimeTracker printout (sec)"
+         << boost::format(" %=12s ") % "Min"
+         << boost::format(" %=12s ") % "Avg"
+         << boost::format(" %=12s ") % "Max"
+         << boost::format(" %=12s ") % "Median"
+         << boost::format(" %=12s ") % "P90"
+         << boost::format(" %=12s ") % "P99"
+         << boost::format(" %=12s ") % "RMS"
+         << boost::format(" %=10s ") % "nEvts" << "\n";
 
-    double const modTime_min    = sqlite::min   ( dbMgr_.get(), "temp.tmpModTable", "Time" );
-    double const modTime_max    = sqlite::max   ( dbMgr_.get(), "temp.tmpModTable", "Time" );
-    double const modTime_mean   = sqlite::mean  ( dbMgr_.get(), "temp.tmpModTable", "Time" );
-    double const modTime_median = sqlite::median( dbMgr_.get(), "temp.tmpModTable", "Time" );
-    double const modTime_rms    = sqlite::rms   ( dbMgr_.get(), "temp.tmpModTable", "Time" );
+  msgOss << std::string(width+4+7*14+12,'=') << "\n";
 
-    uint32_t const nEvts = sqlite::query_db<uint32_t>( dbMgr_.get(), "select count(*) from temp.tmpModTable" );
+  printLine( msgOss, width, "Full event", eventSummary_ );
 
-    if ( printSummary_ ) {
-      msgOss << setw(width) << mod << "  "
-             << boost::format(" %=12g ") % modTime_min
-             << boost::format(" %=12g ") % modTime_mean
-             << boost::format(" %=12g ") % modTime_max
-             << boost::format(" %=12g ") % modTime_median
-             << boost::format(" %=12g ") % modTime_rms
-             << boost::format(" %=10d ") % nEvts << "\n";
-    }
+  msgOss << std::string(width+4+7*14+12,'-') << "\n";
 
-    if ( dbMgr_.logToDb() ) {
-      timeReportTable_.insert( mod,
-                               modTime_min,
-                               modTime_mean,
-                               modTime_max,
-                               modTime_median,
-                               modTime_rms,
-                               nEvts );
-    }
+  for ( auto const& path : pathSummaries_ ) {
+    printLine( msgOss, width, "Path "s+path.first, path.second );
+  }
 
-    sqlite::dropTable( dbMgr_.get(), "temp.tmpModTable" );
+  msgOss << std::string(width+4+7*14+12,'-') << "\n";
 
+  for ( auto const& mod : moduleSummaries_ ) {
+    printLine( msgOss, width, mod.first, mod.second );
   }
 
-  if ( printSummary_ ) {
-    msgOss << std::string(width+4+5*14+12,'=') << "\n";
-    mf::LogAbsolute("TimeTracker") << msgOss.str();
-  }
+  msgOss << std::string(width+4+7*14+12,'=') << "\n";
+  mf::LogAbsolute("TimeTracker") << msgOss.str();
 
 }
 
 //======================================================================
 void art::TimeTracker::preEventProcessing(Event const& ev)
 {
-  eventId_    = ev.id();
-  eventStart_ = now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& event = eventState_();
+  event.sampled = ( eventCount_++ % samplingInterval_ == 0 );
+  if ( !event.sampled ) return;
+
+  event.id    = ev.id();
+  event.start = now();
 }
 
 void art::TimeTracker::postEventProcessing(Event const&)
 {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto const& event = eventState_();
+  if ( !event.sampled ) return;
 
-  double const t = (now()-eventStart_).seconds();
+  double const t = (now()-event.start).seconds();
 
-  timeEventTable_.insert( eventId_.run(),
-                          eventId_.subRun(),
-                          eventId_.event(),
-                          t );
+  eventSummary_.add( t );
+
+  if ( includeRows_ ) {
+    timeEventTable_->insert( event.id.run(),
+                             event.id.subRun(),
+                             event.id.event(),
+                             t );
+  }
 
 }
 
 //======================================================================
 void art::TimeTracker::preModule(ModuleDescription const&)
 {
-  moduleStart_ = now();
+  moduleStarts_.push_back( now() );
 }
 
 void art::TimeTracker::postModule(ModuleDescription const& desc)
 {
-  double const t = (now()-moduleStart_).seconds();
+  double const t = (now()-moduleStarts_.back()).seconds();
+  moduleStarts_.pop_back();
 
-  timeModuleTable_.insert( eventId_.run(),
-                           eventId_.subRun(),
-                           eventId_.event(),
-                           pathname_+":"s+desc.moduleLabel()+":"s+desc.moduleName(),
-                           t );
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto const& event = eventState_();
+  if ( !event.sampled ) return;
+
+  auto const pathname = detail::ScheduleScope::pathName();
+  std::string const id = (pathname ? *pathname : ""s)+":"s+desc.moduleLabel()+":"s+desc.moduleName();
+
+  moduleSummaries_[id].add( t );
+
+  if ( includeRows_ ) {
+    timeModuleTable_->insert( event.id.run(),
+                              event.id.subRun(),
+                              event.id.event(),
+                              id,
+                              t );
+  }
 
 }
 
@@ -0,0 +1,143 @@
+// ============================================================
+//
+// LinuxPerfEventGroup
+//
+// ============================================================
+
+#include "art/Framework/Services/Optional/detail/LinuxPerfEventGroup.h"
+
+#include <cerrno>
+#include <cstring>
+
+extern "C" {
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+}
+
+namespace {
+
+  using art::detail::LinuxPerfEventGroup;
+
+  // glibc provides no wrapper for perf_event_open.
+  int perfEventOpen( perf_event_attr* attr, int const groupFd )
+  {
+    // Calling thread, any CPU.
+    return syscall( __NR_perf_event_open, attr, 0, -1, groupFd, 0 );
+  }
+
+  std::uint64_t config( LinuxPerfEventGroup::counter_type const c )
+  {
+    switch (c) {
+    case LinuxPerfEventGroup::CYCLES       : return PERF_COUNT_HW_CPU_CYCLES;
+    case LinuxPerfEventGroup::INSTRUCTIONS : return PERF_COUNT_HW_INSTRUCTIONS;
+    case LinuxPerfEventGroup::CACHE_MISSES : return PERF_COUNT_HW_CACHE_MISSES;
+    case LinuxPerfEventGroup::BRANCH_MISSES: return PERF_COUNT_HW_BRANCH_MISSES;
+    default: return 0;
+    }
+  }
+
+  // Layout of a read(2) of the group leader with the read_format
+  // used below.
+  struct GroupReadFormat {
+    std::uint64_t nr;
+    std::uint64_t timeEnabled;
+    std::uint64_t timeRunning;
+    std::uint64_t values[LinuxPerfEventGroup::ncounters];
+  };
+
+} // anon. namespace
+
+namespace art {
+  namespace detail {
+
+    //=======================================================
+    LinuxPerfEventGroup::LinuxPerfEventGroup()
+      : fds_()
+      , slots_()
+      , nOpened_()
+      , reason_()
+    {
+      fds_.fill(-1);
+      slots_.fill(-1);
+
+      for ( int i = 0; i != ncounters; ++i ) {
+        auto const c = static_cast<counter_type>(i);
+
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size           = sizeof(attr);
+        attr.type           = PERF_TYPE_HARDWARE;
+        attr.config         = config(c);
+        attr.disabled       = (c == CYCLES);
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        attr.read_format    = PERF_FORMAT_GROUP |
+                              PERF_FORMAT_TOTAL_TIME_ENABLED |
+                              PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        int const fd = perfEventOpen(&attr, c == CYCLES ? -1 : fds_[CYCLES]);
+        if ( fd < 0 ) {
+          if ( c == CYCLES ) {
+            reason_ = std::string("perf_event_open failed: ")+std::strerror(errno);
+            return;
+          }
+          continue;
+        }
+        fds_[c]   = fd;
+        slots_[c] = nOpened_++;
+      }
+
+      ioctl(fds_[CYCLES], PERF_EVENT_IOC_RESET , PERF_IOC_FLAG_GROUP);
+      ioctl(fds_[CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    //=======================================================
+    LinuxPerfEventGroup::~LinuxPerfEventGroup()
+    {
+      // Members first, then the leader.
+      for ( int i = ncounters; i-- != 0; ) {
+        if ( fds_[i] >= 0 ) close(fds_[i]);
+      }
+    }
+
+    //=======================================================
+    LinuxPerfEventGroup::counter_array
+    LinuxPerfEventGroup::read() const
+    {
+      counter_array result;
+      result.fill(0);
+      if ( !isAvailable() ) return result;
+
+      GroupReadFormat data;
+      if ( ::read(fds_[CYCLES], &data, sizeof(data)) <= 0 ) return result;
+
+      // If the PMU was shared with other events, the counters ran for
+      // only part of the time: extrapolate.
+      double const scale = ( data.timeRunning != 0 && data.timeRunning < data.timeEnabled ) ?
+        static_cast<double>(data.timeEnabled)/data.timeRunning : 1.;
+
+      for ( int i = 0; i != ncounters; ++i ) {
+        int const slot = slots_[i];
+        if ( slot < 0 || static_cast<std::uint64_t>(slot) >= data.nr ) continue;
+        result[i] = static_cast<std::uint64_t>(data.values[slot]*scale);
+      }
+      return result;
+    }
+
+    //=======================================================
+    char const*
+    LinuxPerfEventGroup::name(counter_type const c)
+    {
+      switch (c) {
+      case CYCLES       : return "cycles";
+      case INSTRUCTIONS : return "instructions";
+      case CACHE_MISSES : return "cache-misses";
+      case BRANCH_MISSES: return "branch-misses";
+      default: return "";
+      }
+    }
+
+  } // namespace detail
+} // namespace art
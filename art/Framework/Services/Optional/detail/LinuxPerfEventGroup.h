@@ -0,0 +1,65 @@
+#ifndef art_Framework_Services_Optional_detail_LinuxPerfEventGroup_h
+#define art_Framework_Services_Optional_detail_LinuxPerfEventGroup_h
+
+// ============================================================
+//
+// LinuxPerfEventGroup
+//
+// A group of hardware counters (cycles, instructions, cache misses
+// and branch misses) opened with perf_event_open(2) for the calling
+// thread, and read together with a single read(2) of the group
+// leader.
+//
+// The counters are opened for user-space events only.  If the group
+// leader cannot be opened (no PMU, or perf_event_paranoid forbids it)
+// the group is unavailable, and 'reason()' says why; a member that
+// cannot be opened reads as zero.
+//
+// ============================================================
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace art {
+  namespace detail {
+
+    class LinuxPerfEventGroup {
+    public:
+
+      enum counter_type { CYCLES, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, ncounters };
+
+      // Counter values, scaled for any multiplexing of the PMU since
+      // the group was enabled.
+      using counter_array = std::array<std::uint64_t,ncounters>;
+
+      LinuxPerfEventGroup();
+      ~LinuxPerfEventGroup();
+
+      LinuxPerfEventGroup(LinuxPerfEventGroup const&) = delete;
+      LinuxPerfEventGroup& operator=(LinuxPerfEventGroup const&) = delete;
+
+      bool isAvailable() const { return fds_[CYCLES] >= 0; }
+      bool isAvailable(counter_type const c) const { return fds_[c] >= 0; }
+      std::string const& reason() const { return reason_; }
+
+      counter_array read() const;
+
+      static char const* name(counter_type);
+
+    private:
+
+      std::array<int,ncounters> fds_;
+      std::array<int,ncounters> slots_; // Position of each counter in the group read.
+      int nOpened_;
+      std::string reason_;
+
+    };
+
+  }
+}
+#endif // art_Framework_Services_Optional_detail_LinuxPerfEventGroup_h
+
+// Local variables:
+// mode:c++
+// End:
@@ -64,10 +64,10 @@ namespace art {
     LinuxProcData::proc_array LinuxProcMgr::getCurrentData() const
     {
 
-      lseek(fd_, 0, SEEK_SET);
-
+      // pread leaves the file offset alone, so that several threads
+      // can read at once.
       char buf[400];
-      int const cnt = read(fd_, buf, sizeof(buf));
+      int const cnt = pread(fd_, buf, sizeof(buf)-1, 0);
 
       LinuxProcData::proc_array data;
 
@@ -0,0 +1,132 @@
+#include "art/Framework/Services/Optional/detail/StreamingSummary.h"
+#include "art/Utilities/Exception.h"
+
+#include <algorithm>
+#include <cmath>
+
+using art::detail::StreamingSummary;
+
+//==========================================================
+StreamingSummary::StreamingSummary(double const relativeAccuracy,
+                                   double const minMagnitude)
+  : relativeAccuracy_(relativeAccuracy)
+  , minMagnitude_(minMagnitude)
+  , logGamma_()
+{
+  if (!(relativeAccuracy > 0. && relativeAccuracy < 1.)) {
+    throw art::Exception(art::errors::Configuration)
+      << "StreamingSummary: the relative accuracy must lie in (0,1); "
+      << relativeAccuracy << " was given.\n";
+  }
+  logGamma_ = std::log((1.+relativeAccuracy)/(1.-relativeAccuracy));
+}
+
+//==========================================================
+void
+StreamingSummary::Store::add(int const index)
+{
+  if (counts.empty()) {
+    offset = index;
+    counts.push_back(0);
+  }
+  else if (index < offset) {
+    counts.insert(counts.begin(), offset-index, 0);
+    offset = index;
+  }
+  else if (index-offset >= static_cast<int>(counts.size())) {
+    counts.resize(index-offset+1, 0);
+  }
+  ++counts[index-offset];
+}
+
+//==========================================================
+int
+StreamingSummary::index_(double const magnitude) const
+{
+  return static_cast<int>(std::ceil(std::log(magnitude)/logGamma_));
+}
+
+double
+StreamingSummary::value_(int const index) const
+{
+  double const gamma = std::exp(logGamma_);
+  return 2.*std::exp(index*logGamma_)/(gamma+1.);
+}
+
+//==========================================================
+void
+StreamingSummary::add(double const x)
+{
+  if (count_ == 0) {
+    min_ = max_ = x;
+  }
+  else {
+    min_ = std::min(min_, x);
+    max_ = std::max(max_, x);
+  }
+  ++count_;
+  double const delta = x-mean_;
+  mean_ += delta/count_;
+  m2_ += delta*(x-mean_);
+
+  if (x > minMagnitude_) {
+    positive_.add(index_(x));
+  }
+  else if (x < -minMagnitude_) {
+    negative_.add(index_(-x));
+  }
+  else {
+    ++zeroCount_;
+  }
+}
+
+//==========================================================
+double StreamingSummary::min () const { return min_;  }
+double StreamingSummary::max () const { return max_;  }
+double StreamingSummary::mean() const { return mean_; }
+
+double
+StreamingSummary::rms() const
+{
+  return count_ == 0 ? 0. : std::sqrt(m2_/count_);
+}
+
+//==========================================================
+double
+StreamingSummary::quantile(double const p) const
+{
+  if (count_ == 0) return 0.;
+  if (p <= 0.) return min_;
+  if (p >= 1.) return max_;
+
+  // Walk the bins in increasing order of value until more than 'rank'
+  // values have been passed.
+  double const rank = std::floor(p*(count_-1));
+  double passed = 0.;
+  double result = max_;
+  bool found = false;
+
+  for (std::size_t i = negative_.counts.size(); i-- != 0 && !found;) {
+    passed += negative_.counts[i];
+    if (passed > rank) {
+      result = -value_(negative_.offset+static_cast<int>(i));
+      found = true;
+    }
+  }
+  if (!found) {
+    passed += zeroCount_;
+    if (passed > rank) {
+      result = 0.;
+      found = true;
+    }
+  }
+  for (std::size_t i = 0; i != positive_.counts.size() && !found; ++i) {
+    passed += positive_.counts[i];
+    if (passed > rank) {
+      result = value_(positive_.offset+static_cast<int>(i));
+      found = true;
+    }
+  }
+
+  return std::min(std::max(result, min_), max_);
+}
@@ -0,0 +1,94 @@
+#ifndef art_Framework_Services_Optional_detail_StreamingSummary_h
+#define art_Framework_Services_Optional_detail_StreamingSummary_h
+
+// ====================================================
+//
+// StreamingSummary
+//
+// Constant-memory summary of a stream of values: the count, minimum,
+// maximum, mean and RMS (exact), and quantiles estimated to within a
+// fixed relative accuracy.
+//
+// The quantiles come from a histogram with logarithmically spaced
+// bins: a value x > 0 falls in bin i with gamma^(i-1) < x <= gamma^i,
+// where gamma = (1+a)/(1-a) for the relative accuracy a, and is
+// represented by the bin's midpoint 2*gamma^i/(gamma+1), which lies
+// within a factor (1 +/- a) of every value in the bin.  Negative
+// values are binned by magnitude in a second histogram, and values of
+// magnitude below 'minMagnitude' are counted as zero.  The number of
+// bins depends only on the range of the values seen (about 800 bins
+// for six decades at the default accuracy of 1%), not on their number.
+//
+// ====================================================
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace art {
+  namespace detail {
+
+    class StreamingSummary {
+    public:
+
+      explicit StreamingSummary(double relativeAccuracy = 0.01,
+                                double minMagnitude = 1.e-12);
+
+      void add(double x);
+
+      std::size_t count() const { return count_; }
+      bool empty() const { return count_ == 0; }
+
+      // All of the following return 0 for an empty summary.
+      double min() const;
+      double max() const;
+      double mean() const;
+      double rms() const;
+
+      // The value of rank p*(count-1) in the sorted stream, for p in
+      // [0,1], to within the relative accuracy; quantile(0.) and
+      // quantile(1.) are the exact minimum and maximum.
+      double quantile(double p) const;
+      double median() const { return quantile(0.5); }
+
+      double relativeAccuracy() const { return relativeAccuracy_; }
+
+      // The number of histogram bins in use.
+      std::size_t nBins() const { return positive_.counts.size() + negative_.counts.size(); }
+
+    private:
+
+      // Bin counts for indices offset, offset+1, ...
+      struct Store {
+        int offset {0};
+        std::vector<std::uint64_t> counts;
+
+        void add(int index);
+      };
+
+      int index_(double magnitude) const;
+      double value_(int index) const;
+
+      double relativeAccuracy_;
+      double minMagnitude_;
+      double logGamma_;
+
+      Store positive_;
+      Store negative_;
+      std::uint64_t zeroCount_ {0};
+
+      std::size_t count_ {0};
+      double min_ {0.};
+      double max_ {0.};
+      double mean_ {0.};
+      double m2_ {0.}; // Sum of squared deviations from the mean (Welford).
+    };
+
+  }
+}
+
+#endif /* art_Framework_Services_Optional_detail_StreamingSummary_h */
+
+// Local variables:
+// mode: c++
+// End:
@@ -8,13 +8,17 @@
 // users wishing to register for callbacks; the invoke() and clear()
 // functions are intended to be called only by art code.
 //
+// The slots are held contiguously, in calling order, and invoke()
+// returns at once if there are none, so a signal nobody watches costs
+// only a test of its size.
+//
 ////////////////////////////////////////////////////////////////////////
 
 #include "art/Framework/Services/Registry/detail/SignalResponseType.h"
 #include "art/Framework/Services/Registry/detail/makeWatchFunc.h"
 
-#include <deque>
 #include <functional>
+#include <vector>
 
 namespace art {
   template <detail::SignalResponseType, typename ResultType, typename... Args > class GlobalSignal;
@@ -49,10 +53,13 @@ public:
 
   void invoke(Args && ... args) const; // Discard ResultType.
 
+  // True if nobody watches.
+  bool empty() const { return signal_.empty(); }
+
   void clear();
 
 private:
-  std::deque<slot_type> signal_;
+  std::vector<slot_type> signal_;
 };
 
 // 1.
@@ -105,11 +112,13 @@ watch(T const * t, ResultType(T::*slot)(Args...) const)
 }
 
 template <art::detail::SignalResponseType SRTYPE, typename ResultType, typename... Args>
+inline
 void
 art::GlobalSignal<SRTYPE, ResultType, Args...>::
 invoke(Args && ... args) const
 {
-  for (auto f : signal_) {
+  if (signal_.empty()) return;
+  for (auto const & f : signal_) {
     f(std::forward<Args>(args)...);
   }
 }
@@ -23,8 +23,8 @@
 #include "art/Utilities/ScheduleID.h"
 #include "cetlib/container_algorithms.h"
 
-#include <deque>
 #include <functional>
+#include <vector>
 
 namespace art {
   template <detail::SignalResponseType, typename ResultType, typename... Args > class LocalSignal;
@@ -38,7 +38,7 @@ public:
   typedef ResultType result_type;
 private:
   // Required for derivative typedef below.
-  typedef std::vector<std::deque<slot_type> > ContainerType_;
+  typedef std::vector<std::vector<slot_type> > ContainerType_;
 public:
   typedef typename ContainerType_::size_type size_type;
 
@@ -71,6 +71,9 @@ public:
 
   void invoke(ScheduleID sID, Args && ... args) const; // Discard ResultType.
 
+  // True if nobody watches for the given schedule.
+  bool empty(ScheduleID sID) const { return signals_.at(sID.id()).empty(); }
+
   void clear(ScheduleID sID);
   void clearAll();
 
@@ -151,7 +154,7 @@ void
 art::LocalSignal<STYPE, ResultType, Args...>::
 invoke(ScheduleID sID, Args && ... args) const
 {
-  for (auto f : signals_.at(sID.id())) {
+  for (auto const & f : signals_.at(sID.id())) {
     f(std::forward<Args>(args)...);
   }
 }
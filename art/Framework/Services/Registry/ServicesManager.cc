@@ -84,8 +84,8 @@ void
 art::ServicesManager::
 fillCache_(ParameterSets  const & psets, cet::LibraryManager const & lm)
 {
-  // Receive from EventProcessor when we go multi-schedule.
-  detail::ServiceCacheEntry::setNSchedules(1);
+  // The number of schedules for PER_SCHEDULE services is set by the
+  // EventProcessor (default 1) via ServiceCacheEntry::setNSchedules().
   // Loop over each configured service parameter set.
   for (auto const & ps : psets) {
     std::string service_name(ps.get<std::string>("service_type"));
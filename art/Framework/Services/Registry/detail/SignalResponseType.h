@@ -17,7 +17,7 @@ namespace art {
 
     template <SignalResponseType STYPE, typename SIGNAL, typename FUNC>
     typename std::enable_if<STYPE == SignalResponseType::LIFO>::type
-    connect_to_signal(SIGNAL & s, FUNC f) { s.emplace_front(f); }
+    connect_to_signal(SIGNAL & s, FUNC f) { s.emplace(s.begin(), f); }
   }
 }
 
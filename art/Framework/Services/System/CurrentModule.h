@@ -6,6 +6,10 @@
 // CurrentModule: A Service to track and make available information re
 //                the currently-running module
 //
+// The module is tracked per thread, so label() reports the module
+// running on the calling thread when modules run concurrently
+// (several schedules, concurrent paths, producers or output modules).
+//
 // ======================================================================
 
 #include "art/Framework/Services/Registry/ServiceMacros.h"
@@ -38,7 +42,7 @@ public:
     label() const { return desc_.moduleLabel(); }
 
 private:
-  art::ModuleDescription  desc_;
+  static thread_local art::ModuleDescription  desc_;
 
   void
     track_module( art::ModuleDescription const & desc );
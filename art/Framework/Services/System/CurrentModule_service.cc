@@ -17,8 +17,11 @@ using fhicl::ParameterSet;
 
 // ----------------------------------------------------------------------
 
+thread_local ModuleDescription CurrentModule::desc_;
+
+// ----------------------------------------------------------------------
+
 CurrentModule::CurrentModule( ActivityRegistry & r )
-: desc_( )
 {
   // activities to monitor in order to note the current module
   r.sPreModuleConstruction.watch( this, & CurrentModule::track_module );
@@ -16,6 +16,8 @@ art::ScheduleID
 art::ScheduleContext::
 currentScheduleID()
 {
+  auto const sid = detail::ScheduleScope::scheduleID();
+  if (sid.isValid()) { return sid; } // Set by the framework for this thread.
   if (!in_context_.load()) { return ScheduleID(); } // Not in schedule-running context.
   tbb::task * ct = & tbb::task::self();
   detail::ScheduleTask * st { nullptr };
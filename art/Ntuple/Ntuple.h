@@ -1,8 +1,15 @@
 #ifndef art_Ntuple_Ntuple_h
 #define art_Ntuple_Ntuple_h
 
+#include <algorithm>
 #include <array>
+#include <condition_variable>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 
@@ -15,6 +22,23 @@ namespace ntuple
   template <class ... ARGS> class Ntuple;
   template <size_t N> using name_array = std::array<std::string, N>;
 
+  /// How full buffers are written to the database.
+  ///
+  ///  synchronous: by the thread calling insert() or flush().
+  ///
+  ///  background:  by a writer thread with its own connection to the
+  ///               database file. insert() hands a full buffer to the
+  ///               writer and carries on filling a second one, waiting
+  ///               only if the writer has not finished with the
+  ///               previous buffer. flush() waits until everything
+  ///               inserted has been written. Ntuples on a database
+  ///               with no file (in-memory or temporary) are written
+  ///               synchronously. The writer's connection waits for
+  ///               the file to be free; the caller's connection is left
+  ///               as it is, so if it also writes to the file while a
+  ///               writer is active it should be given a busy timeout
+  ///               (sqlite3_busy_timeout).
+  enum class FlushMode { synchronous, background };
 
   /// class Ntuple
 
@@ -28,84 +52,101 @@ namespace ntuple
            std::string const& name,
            name_array<SIZE> const& columns,
            bool const overwriteContents = false,
-           std::size_t bufsize = 1000UL);
+           std::size_t bufsize = 1000UL,
+           FlushMode mode = FlushMode::synchronous);
 
     Ntuple(std::string const& filename,
            std::string const& tablename,
            name_array<SIZE> const& columns,
            bool const overwriteContents = false,
-           std::size_t bufsiz = 1000UL);
+           std::size_t bufsiz = 1000UL,
+           FlushMode mode = FlushMode::synchronous);
+
+    Ntuple(Ntuple const&) = delete;
+    Ntuple& operator=(Ntuple const&) = delete;
 
     ~Ntuple();
 
     void insert(ARGS...);
     void flush();
     sqlite3_int64 lastRowid() { return last_rowid_; }
+    FlushMode mode() const { return writerThread_.joinable() ? FlushMode::background : FlushMode::synchronous; }
 
   private:
-    sqlite3*           db_;
-    std::size_t        max_;
-    std::vector<row_t> buffer_;
-    sqlite3_stmt*      insert_statement_;
-    sqlite3_int64      last_rowid_;
-  };
 
-}
+    /// Writes rows to one connection, using a statement inserting
+    /// several rows at once for as many rows as possible.
+    class Writer {
+    public:
+      Writer(sqlite3* db, std::string const& name, std::size_t bufsize);
+      ~Writer();
+      Writer(Writer const&) = delete;
+      Writer& operator=(Writer const&) = delete;
 
-template <class ...ARGS>
-ntuple::Ntuple<ARGS...>::Ntuple(sqlite3* db,
-                                std::string const& name,
-                                name_array<SIZE> const& cnames,
-                                bool const overwriteContents,
-                                std::size_t bufsize) :
-  db_(db),
-  max_(bufsize),
-  buffer_(),
-  insert_statement_(nullptr),
-  last_rowid_()
-{
-  if (!db)
-    { throw art::Exception(art::errors::SQLExecutionError,"Attempt to create Ntuple with null database pointer"); }
-  sqlite::createTableIfNeeded<ARGS...>(db, last_rowid_, name, begin(cnames), end(cnames), overwriteContents );
-  std::string sql("INSERT INTO ");
-  sql += name;
-  sql += " VALUES (?";
-  for (std::size_t i = 1; i < SIZE; ++i) { sql += ",?"; }
-  sql += ")";
-  int rc = sqlite3_prepare_v2(db_,
-                              sql.c_str(),
-                              sql.size(),
-                              &insert_statement_,
-                              nullptr);
-  if (rc != SQLITE_OK)
-    { throw art::Exception(art::errors::SQLExecutionError,"Failed to prepare insertion statment"); }
-  buffer_.reserve(bufsize);
+      // Returns the rowid of the last row written.
+      sqlite3_int64 write(std::vector<row_t> const& rows);
 
-}
+    private:
+      sqlite3*      db_;
+      sqlite3_stmt* single_statement_;
+      sqlite3_stmt* multi_statement_;
+      std::size_t   rows_per_multi_;
+    };
 
-template <class ...ARGS>
-ntuple::Ntuple<ARGS...>::Ntuple(std::string const& filename,
-                                std::string const& name,
-                                name_array<SIZE> const& cnames,
-                                const bool overwriteContents,
-                                std::size_t bufsize) :
-  Ntuple(sqlite::openDatabaseFile(filename), name, cnames, overwriteContents, bufsize)
-{ }
+    void hand_off_(); // Give buffer_ to the writer thread.
+    void wait_for_writer_(std::unique_lock<std::mutex>& lock);
+    void run_writer_();
+
+    sqlite3*                db_;
+    std::size_t             max_;
+    std::vector<row_t>      buffer_;
+    std::unique_ptr<Writer> writer_;
+    sqlite3_int64           last_rowid_;
+
+    // Background writing.
+    sqlite3*                 writerDb_;
+    std::unique_ptr<Writer>  backgroundWriter_;
+    std::vector<row_t>       pending_;
+    bool                     busy_;
+    bool                     stop_;
+    std::exception_ptr       error_;
+    std::mutex               mutex_;
+    std::condition_variable  cv_;
+    std::thread              writerThread_;
+  };
 
-template <class ... ARGS>
-ntuple::Ntuple<ARGS...>::~Ntuple()
-{
-  flush();
-  sqlite3_finalize(insert_statement_);
 }
 
-template <class ...ARGS>
-void
-ntuple::Ntuple<ARGS...>::insert(ARGS... args)
-{
-  if (buffer_.size() == max_) { flush(); }
-  buffer_.emplace_back(args...);
-  ++last_rowid_;
+namespace ntuple {
+  namespace detail {
+    inline
+    std::string insert_sql(std::string const& name, std::size_t ncols, std::size_t nrows)
+    {
+      std::string row("(?");
+      for (std::size_t i = 1; i < ncols; ++i) { row += ",?"; }
+      row += ")";
+      std::string sql("INSERT INTO ");
+      sql += name;
+      sql += " VALUES ";
+      sql += row;
+      for (std::size_t i = 1; i < nrows; ++i) { sql += ","; sql += row; }
+      return sql;
+    }
+
+    inline
+    sqlite3_stmt* prepare(sqlite3* db, std::string const& sql)
+    {
+      sqlite3_stmt* stmt = nullptr;
+      int rc = sqlite3_prepare_v2(db,
+                                  sql.c_str(),
+                                  sql.size(),
+                                  &stmt,
+                                  nullptr);
+      if (rc != SQLITE_OK)
+        { throw art::Exception(art::errors::SQLExecutionError,"Failed to prepare insertion statment"); }
+      return stmt;
+    }
+  }
 }
 
 inline
@@ -148,42 +189,243 @@ void bind_one_parameter(sqlite3_stmt* s, std::size_t idx, std::string const& v)
     { throw art::Exception(art::errors::SQLExecutionError,"Failed to bind text " + std::to_string(rc)); }
 }
 
+// The parameters of a row are numbered from 'offset'+1.
 template <class TUP, size_t N>
 struct bind_parameters
 {
-  static void bind(sqlite3_stmt* s, TUP const& t)
+  static void bind(sqlite3_stmt* s, TUP const& t, std::size_t offset = 0)
   {
-    bind_parameters < TUP, N - 1 >::bind(s, t);
-    bind_one_parameter(s, N, std::get < N - 1 > (t));
+    bind_parameters < TUP, N - 1 >::bind(s, t, offset);
+    bind_one_parameter(s, offset + N, std::get < N - 1 > (t));
   }
 };
 
 template <class TUP>
 struct bind_parameters<TUP, 1>
 {
-  static void bind(sqlite3_stmt* s, TUP const& t)
+  static void bind(sqlite3_stmt* s, TUP const& t, std::size_t offset = 0)
   {
-    bind_one_parameter(s, 1, std::get<0>(t));
+    bind_one_parameter(s, offset + 1, std::get<0>(t));
   }
 };
 
 template <class ...ARGS>
-void
-ntuple::Ntuple<ARGS...>::flush()
+ntuple::Ntuple<ARGS...>::Writer::Writer(sqlite3* db,
+                                        std::string const& name,
+                                        std::size_t bufsize) :
+  db_(db),
+  single_statement_(nullptr),
+  multi_statement_(nullptr),
+  rows_per_multi_(1)
 {
-  sqlite::Transaction txn(db_);
-  for (auto const& r : buffer_)
+  // A multi-row statement may have no more parameters than the
+  // connection allows, and no more rows than older SQLite versions
+  // allow in a compound SELECT.
+  std::size_t const max_params = sqlite3_limit(db_, SQLITE_LIMIT_VARIABLE_NUMBER, -1);
+  rows_per_multi_ = std::max(std::size_t(1), std::min({bufsize, max_params/SIZE, std::size_t(100)}));
+  single_statement_ = detail::prepare(db_, detail::insert_sql(name, SIZE, 1));
+  if (rows_per_multi_ > 1) {
+    multi_statement_ = detail::prepare(db_, detail::insert_sql(name, SIZE, rows_per_multi_));
+  }
+}
+
+template <class ...ARGS>
+ntuple::Ntuple<ARGS...>::Writer::~Writer()
+{
+  sqlite3_finalize(single_statement_);
+  sqlite3_finalize(multi_statement_);
+}
+
+template <class ...ARGS>
+sqlite3_int64
+ntuple::Ntuple<ARGS...>::Writer::write(std::vector<row_t> const& rows)
+{
+  auto step = [](sqlite3_stmt* stmt)
     {
-      bind_parameters<std::tuple<ARGS...>, SIZE>::bind(insert_statement_, r);
-      int rc = sqlite3_step(insert_statement_);
+      int rc = sqlite3_step(stmt);
       if (rc != SQLITE_DONE) throw art::Exception(art::errors::SQLExecutionError,"SQLite step failure");
-      last_rowid_ = sqlite3_last_insert_rowid(db_);
-      sqlite3_reset(insert_statement_);
+      sqlite3_reset(stmt);
+    };
+
+  sqlite::Transaction txn(db_);
+  auto it = rows.cbegin();
+  auto const end = rows.cend();
+  if (multi_statement_ != nullptr) {
+    for (; static_cast<std::size_t>(end - it) >= rows_per_multi_; it += rows_per_multi_)
+      {
+        for (std::size_t i = 0; i != rows_per_multi_; ++i)
+          { bind_parameters<row_t, SIZE>::bind(multi_statement_, *(it + i), i * SIZE); }
+        step(multi_statement_);
+      }
+  }
+  for (; it != end; ++it)
+    {
+      bind_parameters<row_t, SIZE>::bind(single_statement_, *it);
+      step(single_statement_);
     }
   txn.commit();
+  return sqlite3_last_insert_rowid(db_);
+}
+
+template <class ...ARGS>
+ntuple::Ntuple<ARGS...>::Ntuple(sqlite3* db,
+                                std::string const& name,
+                                name_array<SIZE> const& cnames,
+                                bool const overwriteContents,
+                                std::size_t bufsize,
+                                FlushMode const mode) :
+  db_(db),
+  max_(bufsize),
+  buffer_(),
+  writer_(),
+  last_rowid_(),
+  writerDb_(nullptr),
+  backgroundWriter_(),
+  pending_(),
+  busy_(false),
+  stop_(false),
+  error_(),
+  mutex_(),
+  cv_(),
+  writerThread_()
+{
+  if (!db)
+    { throw art::Exception(art::errors::SQLExecutionError,"Attempt to create Ntuple with null database pointer"); }
+  sqlite::createTableIfNeeded<ARGS...>(db, last_rowid_, name, begin(cnames), end(cnames), overwriteContents );
+  writer_.reset(new Writer(db_, name, bufsize));
+  buffer_.reserve(bufsize);
+
+  if (mode == FlushMode::background) {
+    // An in-memory or temporary database has no file for a second
+    // connection to open.
+    char const* filename = sqlite3_db_filename(db_, "main");
+    if (filename != nullptr && *filename != '\0') {
+      writerDb_ = sqlite::openDatabaseFile(filename);
+      // Wait for the file rather than fail when another connection
+      // is writing to it.
+      sqlite3_busy_timeout(writerDb_, 60000);
+      backgroundWriter_.reset(new Writer(writerDb_, name, bufsize));
+      pending_.reserve(bufsize);
+      writerThread_ = std::thread([this]{ run_writer_(); });
+    }
+  }
+}
+
+template <class ...ARGS>
+ntuple::Ntuple<ARGS...>::Ntuple(std::string const& filename,
+                                std::string const& name,
+                                name_array<SIZE> const& cnames,
+                                const bool overwriteContents,
+                                std::size_t bufsize,
+                                FlushMode const mode) :
+  Ntuple(sqlite::openDatabaseFile(filename), name, cnames, overwriteContents, bufsize, mode)
+{ }
+
+template <class ... ARGS>
+ntuple::Ntuple<ARGS...>::~Ntuple()
+{
+  // A failure to write the last rows, or one reported by the writer
+  // thread, must not escape the destructor; the writer thread is
+  // stopped regardless.
+  try {
+    flush();
+  }
+  catch (std::exception const& e) {
+    std::cerr << "Ntuple: failed to write rows on destruction: " << e.what() << '\n';
+  }
+  catch (...) {
+    std::cerr << "Ntuple: failed to write rows on destruction: unknown exception.\n";
+  }
+  if (writerThread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    writerThread_.join();
+    backgroundWriter_.reset();
+    sqlite3_close(writerDb_);
+  }
+}
+
+template <class ...ARGS>
+void
+ntuple::Ntuple<ARGS...>::insert(ARGS... args)
+{
+  if (buffer_.size() == max_) {
+    if (writerThread_.joinable()) { hand_off_(); }
+    else { flush(); }
+  }
+  buffer_.emplace_back(args...);
+  ++last_rowid_;
+}
+
+template <class ...ARGS>
+void
+ntuple::Ntuple<ARGS...>::flush()
+{
+  if (writerThread_.joinable()) {
+    hand_off_();
+    std::unique_lock<std::mutex> lock(mutex_);
+    wait_for_writer_(lock);
+    return;
+  }
+  if (buffer_.empty()) return;
+  last_rowid_ = writer_->write(buffer_);
   buffer_.clear();
 }
 
+template <class ...ARGS>
+void
+ntuple::Ntuple<ARGS...>::wait_for_writer_(std::unique_lock<std::mutex>& lock)
+{
+  cv_.wait(lock, [this]{ return !busy_; });
+  if (error_) {
+    auto const error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+template <class ...ARGS>
+void
+ntuple::Ntuple<ARGS...>::hand_off_()
+{
+  if (buffer_.empty()) return;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    wait_for_writer_(lock);
+    // The writer left pending_ empty: it becomes the buffer to fill.
+    pending_.swap(buffer_);
+    busy_ = true;
+  }
+  cv_.notify_all();
+}
+
+template <class ...ARGS>
+void
+ntuple::Ntuple<ARGS...>::run_writer_()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    cv_.wait(lock, [this]{ return busy_ || stop_; });
+    if (!busy_) break;
+    lock.unlock();
+    try {
+      backgroundWriter_->write(pending_);
+    }
+    catch (...) {
+      lock.lock();
+      error_ = std::current_exception();
+      lock.unlock();
+    }
+    pending_.clear();
+    lock.lock();
+    busy_ = false;
+    cv_.notify_all();
+  }
+}
+
 #endif /* art_Ntuple_Ntuple_h */
 
 // Local Variables:
@@ -76,8 +76,17 @@
 // D const & data(size_t index) const;
 // D const & data(assn_iterator it) const;
 //
+// Lookup.
+//
+// detail::AssnsIndex & leftIndex() const; // For FindOne and FindMany.
+//
+// The index is kept in an AssnsIndexCache, which needs nothing in the
+// dictionary selections of Assns. Modifying, assigning, swapping or
+// reading an Assns drops the index, invalidating any reference to it.
+//
 ////////////////////////////////////////////////////////////////////////
 
+#include "art/Persistency/Common/AssnsIndexCache.h"
 #include "art/Persistency/Common/Ptr.h"
 #include "art/Persistency/Common/Wrapper.h"
 #include "art/Utilities/Exception.h"
@@ -107,11 +116,18 @@ namespace art {
   class Assns<L, R, void>; // No data: base class.
 
   namespace detail {
+    class AssnsIndex;
+
     // Temporary streamer class until streamer method registration is
     // working again.
     template <typename L, typename R>
     class AssnsStreamer : public TClassStreamer {
     public:
+      // The per-thread copy ROOT uses once thread safety is enabled.
+      virtual TClassStreamer * Generate() const {
+        return new AssnsStreamer(*this);
+      }
+
       void operator()(TBuffer & R_b, void * objp) {
         static TClassRef cl(TClass::GetClass(typeid(Assns<L, R, void>)));
         Assns<L, R, void> *obj = reinterpret_cast<Assns<L, R, void> *>(objp);
@@ -149,6 +165,8 @@ public:
   // Constructors, destructor.
   Assns();
   Assns(partner_t const & other);
+  Assns(Assns const & other);
+  Assns & operator = (Assns const & other);
   virtual ~Assns();
 
   // Accessors.
@@ -158,6 +176,10 @@ public:
   assn_t const & at(size_type index) const;
   size_type size() const;
 
+  // The index of the associations by left item, made on first call and
+  // kept until the Assns is modified (which invalidates it).
+  detail::AssnsIndex & leftIndex() const;
+
   // Modifier.
   void addSingle(Ptr<left_t> const & left,
                  Ptr<right_t> const & right);
@@ -194,10 +216,12 @@ private:
   void fill_from_transients();
 
   void init_streamer();
+  void resetIndex_();
 
   mutable ptrs_t ptrs_; //! transient
   mutable ptr_data_t ptr_data_1_;
   mutable ptr_data_t ptr_data_2_;
+  AssnsIndexCache index_;
 };
 
 ////////////////////////////////////////////////////////////////////////
@@ -224,6 +248,7 @@ public:
   using base::end;
   using base::operator[];
   using base::at;
+  using base::leftIndex;
 
   data_t const & data(typename std::vector<data_t>::size_type index) const;
   data_t const & data(assn_iterator it) const;
@@ -256,7 +281,8 @@ art::Assns<L, R, void>::Assns()
   :
   ptrs_(),
   ptr_data_1_(),
-  ptr_data_2_()
+  ptr_data_2_(),
+  index_()
 {
   init_streamer();
 }
@@ -267,7 +293,8 @@ art::Assns<L, R, void>::Assns(partner_t const & other)
   :
   ptrs_(),
   ptr_data_1_(),
-  ptr_data_2_()
+  ptr_data_2_(),
+  index_()
 {
   ptrs_.reserve(other.ptrs_.size());
   for (typename partner_t::ptrs_t::const_iterator
@@ -280,6 +307,33 @@ art::Assns<L, R, void>::Assns(partner_t const & other)
   init_streamer();
 }
 
+// The index is not copied: the copy makes its own when asked.
+template <typename L, typename R>
+inline
+art::Assns<L, R, void>::Assns(Assns const & other)
+  :
+  ptrs_(other.ptrs_),
+  ptr_data_1_(other.ptr_data_1_),
+  ptr_data_2_(other.ptr_data_2_),
+  index_()
+{
+  init_streamer();
+}
+
+template <typename L, typename R>
+inline
+art::Assns<L, R, void> &
+art::Assns<L, R, void>::operator = (Assns const & other)
+{
+  if (this != &other) {
+    ptrs_ = other.ptrs_;
+    ptr_data_1_ = other.ptr_data_1_;
+    ptr_data_2_ = other.ptr_data_2_;
+    resetIndex_();
+  }
+  return *this;
+}
+
 template <typename L, typename R>
 inline
 art::Assns<L, R, void>::~Assns()
@@ -326,6 +380,14 @@ art::Assns<L, R, void>::size() const
   return ptrs_.size();
 }
 
+template <typename L, typename R>
+inline
+art::detail::AssnsIndex &
+art::Assns<L, R, void>::leftIndex() const
+{
+  return index_.get();
+}
+
 template <typename L, typename R>
 inline
 void
@@ -333,6 +395,7 @@ art::Assns<L, R, void>::addSingle(Ptr<left_t> const & left,
                                   Ptr<right_t> const & right)
 {
   ptrs_.emplace_back(left, right);
+  resetIndex_();
 }
 
 template <typename L, typename R>
@@ -360,6 +423,8 @@ art::Assns<L, R, void>::swap_(art::Assns<L, R, void> &other)
   swap(ptrs_, other.ptrs_);
   swap(ptr_data_1_, other.ptr_data_1_);
   swap(ptr_data_2_, other.ptr_data_2_);
+  resetIndex_();
+  other.resetIndex_();
 }
 
 template <typename L, typename R>
@@ -408,6 +473,7 @@ art::Assns<L, R, void>::fill_transients()
   ptr_data_t tmp1, tmp2;
   l_ref.swap(tmp1);
   r_ref.swap(tmp2);
+  resetIndex_();
 }
 
 template <typename L, typename R>
@@ -438,6 +504,14 @@ art::Assns<L, R, void>::fill_from_transients()
   }
 }
 
+template <typename L, typename R>
+inline
+void
+art::Assns<L, R, void>::resetIndex_()
+{
+  index_.reset();
+}
+
 template <typename L, typename R>
 void
 art::Assns<L, R, void>::init_streamer()
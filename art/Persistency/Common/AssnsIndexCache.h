@@ -0,0 +1,108 @@
+#ifndef art_Persistency_Common_AssnsIndexCache_h
+#define art_Persistency_Common_AssnsIndexCache_h
+// vim: set sw=2:
+
+//
+// AssnsIndexCache
+//
+// ROOT safe holder of the index an Assns makes of its associations by
+// left item (see detail/AssnsIndex.h). Its only member is selected as
+// transient in the art dictionary, so an Assns can hold one without any
+// edit to the dictionary selections of its instantiations.
+//
+// The index is made on the first call to get(); of concurrent first
+// callers, the one to install its index wins. reset() drops it: a
+// reference obtained from get() is invalidated by the next reset(),
+// which the Assns calls whenever it is modified, assigned, swapped or
+// read. A copy starts empty.
+//
+
+#ifndef __GCCXML__
+#include "art/Persistency/Common/detail/AssnsIndex.h"
+#include <atomic>
+#include <memory>
+#endif
+
+namespace art {
+  namespace detail {
+    class AssnsIndex;
+  }
+
+  class AssnsIndexCache;
+}
+
+class art::AssnsIndexCache {
+public:
+  AssnsIndexCache();
+  AssnsIndexCache(AssnsIndexCache const &);
+  AssnsIndexCache & operator = (AssnsIndexCache const &);
+  ~AssnsIndexCache();
+
+  detail::AssnsIndex & get() const;
+  void reset();
+
+private:
+#ifndef __GCCXML__
+  mutable std::atomic<detail::AssnsIndex *> index_;
+#else
+  mutable detail::AssnsIndex * index_;
+#endif
+};
+
+#ifndef __GCCXML__
+inline
+art::AssnsIndexCache::AssnsIndexCache()
+  :
+  index_(nullptr)
+{
+}
+
+inline
+art::AssnsIndexCache::AssnsIndexCache(AssnsIndexCache const &)
+  :
+  index_(nullptr)
+{
+}
+
+inline
+art::AssnsIndexCache &
+art::AssnsIndexCache::operator = (AssnsIndexCache const &)
+{
+  reset();
+  return *this;
+}
+
+inline
+art::AssnsIndexCache::~AssnsIndexCache()
+{
+  delete index_.load();
+}
+
+inline
+art::detail::AssnsIndex &
+art::AssnsIndexCache::get() const
+{
+  detail::AssnsIndex * index = index_.load(std::memory_order_acquire);
+  if (index == nullptr) {
+    std::unique_ptr<detail::AssnsIndex> made(new detail::AssnsIndex);
+    if (index_.compare_exchange_strong(index, made.get(),
+                                       std::memory_order_acq_rel)) {
+      index = made.release();
+    }
+  }
+  return *index;
+}
+
+inline
+void
+art::AssnsIndexCache::reset()
+{
+  delete index_.exchange(nullptr);
+}
+#endif /* __GCCXML__ */
+
+#endif /* art_Persistency_Common_AssnsIndexCache_h */
+
+// Local Variables:
+// mode: c++
+// End:
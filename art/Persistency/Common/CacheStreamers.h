@@ -11,6 +11,9 @@ namespace art {
     explicit ConstPtrCacheStreamer() : cl_("art::ConstPtrCache"){}
 
     void operator() (TBuffer &R_b, void *objp);
+    TClassStreamer* Generate() const override {
+      return new ConstPtrCacheStreamer(*this);
+    }
 
   private:
     TClassRef cl_;
@@ -21,6 +24,9 @@ public:
     explicit BoolCacheStreamer() : cl_("art::BoolCache"){}
 
     void operator() (TBuffer &R_b, void *objp);
+    TClassStreamer* Generate() const override {
+      return new BoolCacheStreamer(*this);
+    }
 
 private:
     TClassRef cl_;
@@ -8,6 +8,10 @@
 // Abstract interface used by EventPrincipal to request
 // input sources to retrieve EDProducts from external storage.
 //
+// Input is shared by all schedules: getProduct() may be called on
+// several readers at once, and an implementation reading from shared
+// storage must serialize the calls itself.
+//
 
 #include "art/Persistency/Common/EDProduct.h"
 #include "art/Utilities/fwd.h"
@@ -8,6 +8,7 @@
 #include "art/Persistency/Common/EDProduct.h"
 
 #include "art/Persistency/Provenance/ProductID.h"
+#include "art/Utilities/MonotonicArena.h"
 
 using art::EDProduct;
 
@@ -17,6 +18,15 @@ EDProduct::EDProduct()
 EDProduct::~EDProduct()
 { }
 
+void
+EDProduct::operator delete(void* p)
+{
+  if (!art::MonotonicArena::foreignObjects() ||
+      !art::MonotonicArena::contains(p)) {
+    ::operator delete(p);
+  }
+}
+
 void
 EDProduct::setPtr(std::type_info const &toType,
                   unsigned long index,
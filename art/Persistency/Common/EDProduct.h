@@ -26,6 +26,12 @@ public:
   EDProduct();
   virtual ~EDProduct();
 
+#ifndef __GCCXML__
+  // A product may have been read into the arena of its event (see
+  // MonotonicArena), which then owns its memory.
+  static void operator delete(void* p);
+#endif
+
   bool
     isPresent() const
   { return isPresent_(); }
@@ -1,3 +1,4 @@
+#include "art/Persistency/Common/AssnsIndexCache.h"
 #include "art/Persistency/Common/BoolCache.h"
 #include "art/Persistency/Common/ConstPtrCache.h"
 #include "art/Persistency/Common/EDProduct.h"
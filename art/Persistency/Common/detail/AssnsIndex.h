@@ -0,0 +1,181 @@
+#ifndef art_Persistency_Common_detail_AssnsIndex_h
+#define art_Persistency_Common_detail_AssnsIndex_h
+// vim: set sw=2:
+
+//
+// AssnsIndex
+//
+// Transient index of the associations in an Assns by their left item,
+// for the use of FindOne and FindMany (see IPRHelper). An Assns makes
+// its index on first request and keeps it, so it is built at most once
+// per event however many queries are made against the product (an
+// Assns and its partner each have their own).
+//
+// Each of the two lookups is a CSR table: the sorted distinct keys
+// and, for each key, the range of positions in the Assns of the
+// associations having that key, in Assns order.
+//
+//   byPtr():     keyed by the ProductID and key of the left Ptr. It
+//                is made without resolving any Ptr, and a query with a
+//                Ptr matches only associations to the same product.
+//
+//   byAddress(): keyed by the address of the left item, for queries
+//                with collections of items. It is made by resolving
+//                the available left Ptrs.
+//
+
+#include "art/Persistency/Provenance/ProductID.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace art {
+  namespace detail {
+    template <typename KEY>
+    class CSRIndex;
+
+    class AssnsIndex;
+  }
+}
+
+template <typename KEY>
+class art::detail::CSRIndex {
+public:
+  typedef std::vector<std::size_t>::const_iterator const_iterator;
+  typedef std::pair<const_iterator, const_iterator> range_type;
+
+  // The entries are (key, position) pairs in position order.
+  explicit CSRIndex(std::vector<std::pair<KEY, std::size_t>> entries);
+
+  range_type find(KEY const & key) const;
+
+private:
+  std::vector<KEY> keys_;
+  std::vector<std::size_t> offsets_; // keys_.size() + 1 entries.
+  std::vector<std::size_t> positions_;
+};
+
+class art::detail::AssnsIndex {
+public:
+  typedef std::pair<ProductID, std::size_t> ptr_key_type;
+  typedef CSRIndex<ptr_key_type> ptr_index_type;
+  typedef CSRIndex<void const *> address_index_type;
+
+  AssnsIndex();
+
+  AssnsIndex(AssnsIndex const &) = delete;
+  AssnsIndex & operator = (AssnsIndex const &) = delete;
+
+  template <typename ASSNS>
+  ptr_index_type const & byPtr(ASSNS const & assns);
+
+  template <typename ASSNS>
+  address_index_type const & byAddress(ASSNS const & assns);
+
+private:
+  std::mutex mutex_;
+  std::unique_ptr<ptr_index_type> byPtr_;
+  std::unique_ptr<address_index_type> byAddress_;
+};
+
+template <typename KEY>
+art::detail::CSRIndex<KEY>::
+CSRIndex(std::vector<std::pair<KEY, std::size_t>> entries)
+  :
+  keys_(),
+  offsets_(),
+  positions_()
+{
+  typedef std::pair<KEY, std::size_t> entry_t;
+  std::less<KEY> const less;
+  std::stable_sort(entries.begin(), entries.end(),
+                   [&less](entry_t const & a, entry_t const & b)
+                   { return less(a.first, b.first); });
+  positions_.reserve(entries.size());
+  for (auto const & entry : entries) {
+    if (keys_.empty() || less(keys_.back(), entry.first)) {
+      keys_.push_back(entry.first);
+      offsets_.push_back(positions_.size());
+    }
+    positions_.push_back(entry.second);
+  }
+  offsets_.push_back(positions_.size());
+}
+
+template <typename KEY>
+inline
+auto
+art::detail::CSRIndex<KEY>::
+find(KEY const & key) const
+-> range_type
+{
+  std::less<KEY> const less;
+  auto const it = std::lower_bound(keys_.cbegin(), keys_.cend(), key, less);
+  if (it == keys_.cend() || less(key, *it)) {
+    return range_type(positions_.cend(), positions_.cend());
+  }
+  auto const k = it - keys_.cbegin();
+  return range_type(positions_.cbegin() + offsets_[k],
+                    positions_.cbegin() + offsets_[k + 1]);
+}
+
+inline
+art::detail::AssnsIndex::
+AssnsIndex()
+  :
+  mutex_(),
+  byPtr_(),
+  byAddress_()
+{
+}
+
+template <typename ASSNS>
+auto
+art::detail::AssnsIndex::
+byPtr(ASSNS const & assns)
+-> ptr_index_type const &
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!byPtr_) {
+    std::vector<std::pair<ptr_key_type, std::size_t>> entries;
+    entries.reserve(assns.size());
+    for (std::size_t i = 0, e = assns.size(); i != e; ++i) {
+      auto const & left = assns[i].first;
+      entries.emplace_back(ptr_key_type(left.id(), left.key()), i);
+    }
+    byPtr_.reset(new ptr_index_type(std::move(entries)));
+  }
+  return *byPtr_;
+}
+
+template <typename ASSNS>
+auto
+art::detail::AssnsIndex::
+byAddress(ASSNS const & assns)
+-> address_index_type const &
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!byAddress_) {
+    std::vector<std::pair<void const *, std::size_t>> entries;
+    entries.reserve(assns.size());
+    for (std::size_t i = 0, e = assns.size(); i != e; ++i) {
+      auto const & left = assns[i].first;
+      if (left.isAvailable()) {
+        entries.emplace_back(static_cast<void const *>(left.get()), i);
+      }
+    }
+    byAddress_.reset(new address_index_type(std::move(entries)));
+  }
+  return *byAddress_;
+}
+
+#endif /* art_Persistency_Common_detail_AssnsIndex_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -15,6 +15,9 @@ class TBuffer;
 class art::detail::PtrVectorBaseStreamer : public TClassStreamer {
 public:
   void operator()(TBuffer &R_b, void *objp);
+  TClassStreamer* Generate() const override {
+    return new PtrVectorBaseStreamer(*this);
+  }
 };
 
 #endif /* art_Persistency_Common_detail_setPtrVectorBaseStreamer_h */
@@ -45,6 +45,10 @@ namespace {
 art::BranchDescription::Transients::Transients() :
   branchName_(),
   wrappedName_(),
+  wrappedCintName_(),
+  moduleLabelSymbol_(),
+  processNameSymbol_(),
+  productInstanceNameSymbol_(),
   produced_(false),
   present_(true),
   transient_(false),
@@ -117,6 +121,10 @@ void art::BranchDescription::fluffTransients_() const {
   // name, as this gives instruction to ROOT to split this branch in the
   // modern (v4+) way vs the old way (v3-).
 
+  transients_.get().moduleLabelSymbol_ = Symbol(moduleLabel());
+  transients_.get().processNameSymbol_ = Symbol(processName());
+  transients_.get().productInstanceNameSymbol_ = Symbol(productInstanceName());
+
   Reflex::Type t = Reflex::Type::ByName(producedClassName());
   Reflex::PropertyList p = t.Properties();
   if (p.HasProperty("persistent") &&
@@ -360,6 +368,9 @@ art::operator==(BranchDescription const& a, BranchDescription const& b) {
 class art::detail::BranchDescriptionStreamer : public TClassStreamer {
 public:
   void operator()(TBuffer &R_b, void *objp);
+  TClassStreamer* Generate() const override {
+    return new BranchDescriptionStreamer(*this);
+  }
 };
 
 void
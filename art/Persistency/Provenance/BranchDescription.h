@@ -15,6 +15,7 @@ This description also applies to every product instance on the branch.
 #include "art/Persistency/Provenance/ProvenanceFwd.h"
 #include "art/Persistency/Provenance/Transient.h"
 #include "art/Persistency/Provenance/TypeLabel.h"
+#include "art/Utilities/Symbol.h"
 #include "fhiclcpp/ParameterSetID.h"
 
 #include <iosfwd>
@@ -73,6 +74,12 @@ public:
   std::string const& friendlyClassName() const {return friendlyClassName_;}
   std::string const& productInstanceName() const {return productInstanceName_;}
 
+  // Interned forms of the module label, process name and product
+  // instance name, for comparison with those of an InputTag.
+  Symbol const& moduleLabelSymbol() const {return guts().moduleLabelSymbol_;}
+  Symbol const& processNameSymbol() const {return guts().processNameSymbol_;}
+  Symbol const& productInstanceNameSymbol() const {return guts().productInstanceNameSymbol_;}
+
   bool const & produced() const {return guts().produced_;}
   bool const & present() const {return guts().present_;}
   bool const & transient() const {return guts().transient_;}
@@ -111,6 +118,11 @@ public:
     // here), which is currently derivable fron the other attributes.
     std::string wrappedCintName_;
 
+    // The interned module label, process name and product instance name.
+    Symbol moduleLabelSymbol_;
+    Symbol processNameSymbol_;
+    Symbol productInstanceNameSymbol_;
+
     // Was this branch produced in this process
     // rather than in a previous process
     bool produced_;
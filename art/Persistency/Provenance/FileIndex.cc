@@ -4,6 +4,7 @@
 #include "cpp0x/algorithm"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
+#include <cstdint>
 #include <iomanip>
 #include <ostream>
 
@@ -36,30 +37,34 @@ namespace art {
    // vector is empty, which is consistent with it having been
    // sorted.
 
-   FileIndex::Transients::Transients() : allInEntryOrder_(false), resultCached_(false), sortState_(kSorted_Run_SubRun_Event) {}
+   FileIndex::Transients::Transients() : allInEntryOrder_(false), resultCached_(false), sortState_(kSorted_Run_SubRun_Event), eventHashIndex_() {}
 
    void
    FileIndex::addEntry(EventID const &eID, EntryNumber_t entry) {
       entries_.push_back(FileIndex::Element(eID, entry));
       resultCached() = false;
       sortState() = kNotSorted;
+      hashSlots().clear();
    }
 
    void
    FileIndex::addEntryOnLoad(EventID const &eID, EntryNumber_t entry) {
       entries_.push_back(FileIndex::Element(eID, entry));
       resultCached() = false;
+      hashSlots().clear();
    }
 
    void FileIndex::sortBy_Run_SubRun_Event() {
       stable_sort_all(entries_);
       resultCached() = false;
+      hashSlots().clear();
       sortState() = kSorted_Run_SubRun_Event;
    }
 
    void FileIndex::sortBy_Run_SubRun_EventEntry() {
       stable_sort_all(entries_, Compare_Run_SubRun_EventEntry());
       resultCached() = false;
+      hashSlots().clear();
       sortState() = kSorted_Run_SubRun_EventEntry;
    }
 
@@ -117,6 +122,86 @@ namespace art {
       return true; // finished and found no duplicates
    }
 
+   void FileIndex::buildEventHashIndex() const {
+      size_t nEvents = 0;
+      for (auto const& el : entries_) {
+         if (el.getEntryType() == kEvent) ++nEvents;
+      }
+      // Keep the load factor at or below one half.
+      size_t nSlots = 16;
+      while (nSlots < 2 * nEvents) nSlots *= 2;
+      EventHashIndex& slots = hashSlots();
+      slots.assign(nSlots, Element::invalidEntry);
+      size_t const mask = nSlots - 1;
+      for (size_t pos = 0, sz = entries_.size(); pos != sz; ++pos) {
+         Element const& el = entries_[pos];
+         if (el.getEntryType() != kEvent) continue;
+         size_t i = eventHashSlot(el.eventID_, mask);
+         while (slots[i] != Element::invalidEntry &&
+                entries_[slots[i]].eventID_ != el.eventID_) {
+            i = (i + 1) & mask;
+         }
+         // As for findEventPosition(), the first of any duplicates wins.
+         if (slots[i] == Element::invalidEntry) slots[i] = pos;
+      }
+   }
+
+   bool FileIndex::adoptEventHashIndex(EventHashIndex &slots,
+                                       size_t indexSize,
+                                       uint64_t indexChecksum) const {
+      // The slots are trusted to be those written for an index of this
+      // size and checksum: checking them against the index event by
+      // event would cost as much as building them again.
+      if (sortState() != kSorted_Run_SubRun_Event ||
+          slots.size() < 16 ||
+          (slots.size() & (slots.size() - 1)) != 0 ||
+          indexSize != entries_.size() ||
+          indexChecksum != checksum()) {
+         return false;
+      }
+      hashSlots().swap(slots);
+      return true;
+   }
+
+   uint64_t FileIndex::checksum() const {
+      // FNV-1a over the identifying fields of each entry.
+      uint64_t const prime = 0x100000001B3ull;
+      uint64_t h = 0xCBF29CE484222325ull;
+      auto add = [&h, prime](uint64_t v) {
+         for (int i = 0; i != 8; ++i, v >>= 8) {
+            h = (h ^ (v & 0xFF)) * prime;
+         }
+      };
+      for (auto const& el : entries_) {
+         add(el.eventID_.run());
+         add(el.eventID_.subRun());
+         add(el.eventID_.event());
+         add(static_cast<uint64_t>(el.entry_));
+      }
+      return h;
+   }
+
+   size_t FileIndex::eventHashSlot(EventID const &eID, size_t mask) {
+      uint64_t const k = 0x9E3779B97F4A7C15ull;
+      uint64_t h = eID.run();
+      h = h * k + eID.subRun();
+      h = h * k + eID.event();
+      h ^= h >> 29;
+      return static_cast<size_t>(h * k >> 32) & mask;
+   }
+
+   FileIndex::const_iterator
+   FileIndex::findEventByHash(EventID const &eID) const {
+      EventHashIndex const& slots = hashSlots();
+      size_t const mask = slots.size() - 1;
+      for (size_t i = eventHashSlot(eID, mask);
+           slots[i] != Element::invalidEntry;
+           i = (i + 1) & mask) {
+         if (entries_[slots[i]].eventID_ == eID) return entries_.begin() + slots[i];
+      }
+      return entries_.end();
+   }
+
    FileIndex::const_iterator
    FileIndex::findPosition(EventID const &eID) const {
 
@@ -135,6 +220,13 @@ namespace art {
          return findEventForUnspecifiedSubRun(eID, exact);
       }
 
+      if (hasEventHashIndex()) {
+         // An event in the file is found directly; otherwise, for an
+         // inexact search, fall through to look for the next one.
+         const_iterator it = findEventByHash(eID);
+         if (exact || it != entries_.end()) return it;
+      }
+
       const_iterator it = findPosition(eID);
       const_iterator itEnd = entries_.end();
       while (it != itEnd && it->getEntryType() != FileIndex::kEvent) {
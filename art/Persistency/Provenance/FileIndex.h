@@ -24,6 +24,15 @@
 //    answer returned by findEventPosition() in these circumstances is
 //    in any way unique.
 //
+// 4. Optionally, events may also be looked up through an event hash
+//    index: an open-addressed hash table of EventID to the position of
+//    the event in the index, giving findEventPosition() constant time
+//    for events present in the file. The hash table is built by
+//    buildEventHashIndex() or taken from the output file (see
+//    adoptEventHashIndex()), where it is stored with the size and
+//    checksum of the index it was built for. It is discarded whenever
+//    the index is modified or re-sorted.
+//
 ////////////////////////////////////////////////////////////////////////
 
 #include "art/Persistency/Provenance/EventID.h"
@@ -31,6 +40,8 @@
 #include "art/Persistency/Provenance/SubRunID.h"
 #include "art/Persistency/Provenance/Transient.h"
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <iosfwd>
 #include <vector>
 
@@ -120,6 +131,29 @@ public:
 
    bool eventsUniqueAndOrdered() const;
 
+   // Each slot of the event hash index is the position in this index
+   // of an event entry, or Element::invalidEntry for an empty slot.
+   typedef std::vector<EntryNumber_t> EventHashIndex;
+
+   bool hasEventHashIndex() const {return !eventHashIndex().empty();}
+
+   // Build the event hash index from the current contents.
+   void buildEventHashIndex() const;
+
+   // Use the given event hash index, as written with an index sorted
+   // by Run, SubRun and Event of the given size and checksum(). The
+   // contents of slots are swapped into place. Returns false, leaving
+   // this index unchanged, if this index differs in size or checksum.
+   bool adoptEventHashIndex(EventHashIndex &slots,
+                            std::size_t indexSize,
+                            std::uint64_t indexChecksum) const;
+
+   // A checksum of the entries, in their current order.
+   std::uint64_t checksum() const;
+
+   // The event hash index, empty if there is none.
+   EventHashIndex const& eventHashIndex() const {return hashSlots();}
+
    enum SortState { kNotSorted, kSorted_Run_SubRun_Event, kSorted_Run_SubRun_EventEntry};
 
    struct Transients {
@@ -127,6 +161,7 @@ public:
       bool allInEntryOrder_;
       bool resultCached_;
       SortState sortState_;
+      EventHashIndex eventHashIndex_;
    };
 
 private:
@@ -134,6 +169,12 @@ private:
    bool& allInEntryOrder() const {return transients_.get().allInEntryOrder_;}
    bool& resultCached() const {return transients_.get().resultCached_;}
    SortState& sortState() const {return transients_.get().sortState_;}
+   EventHashIndex& hashSlots() const {return transients_.get().eventHashIndex_;}
+
+   static std::size_t eventHashSlot(EventID const &eID, std::size_t mask);
+
+   const_iterator
+   findEventByHash(EventID const &eID) const;
 
    const_iterator
    findEventForUnspecifiedSubRun(EventID const &eID, bool exact) const;
@@ -74,6 +74,8 @@ MasterProductRegistry()
   , perFileProds_()
   , productLookup_()
   , elementLookup_()
+  , productListUpdatedCallbacks_()
+  , generation_(1)
 {
   productProduced_.fill(false);
   perFileProds_.resize(1);
@@ -101,6 +103,7 @@ addProduct(std::unique_ptr<BranchDescription>&& bdp)
   I.first->second.swap(*bdp);
   perFileProds_[0].insert(*I.first);
   productProduced_[I.first->second.branchType()] = true;
+  ++generation_;
 }
 
 void
@@ -132,6 +135,7 @@ initFromFirstPrimaryFile(ProductList const& pl, FileBlock const& fb)
     assert(combinable(J->second, bd));
     J->second.merge(bd);
   }
+  ++generation_;
   for (auto const& val : productListUpdatedCallbacks_) {
     val(fb);
   }
@@ -174,6 +178,7 @@ updateFromSecondaryFile(ProductList const& pl, FileBlock const& fb)
   elementLookup_.resize(elementLookup_.size()+1);
   recreateLookups(perFileProds_.back(), productLookup_.back(),
                   elementLookup_.back());
+  ++generation_;
   for (auto const& val : productListUpdatedCallbacks_) {
     val(fb);
   }
@@ -252,6 +257,7 @@ updateFromNewPrimaryFile(ProductList const& other, std::string const& fileName,
   elementLookup_.clear();
   elementLookup_.resize(1);
   recreateLookups(productList_, productLookup_[0], elementLookup_[0]);
+  ++generation_;
   for (auto const& val : productListUpdatedCallbacks_) {
     val(fb);
   }
@@ -272,6 +278,7 @@ setFrozen()
   elementLookup_.clear();
   elementLookup_.resize(1);
   recreateLookups(productList_, productLookup_[0], elementLookup_[0]);
+  ++generation_;
 }
 
 void
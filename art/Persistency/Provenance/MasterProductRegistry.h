@@ -66,6 +66,11 @@ public:
   std::vector<TypeLookup> const& elementLookup() const {
     return elementLookup_;
   }
+  // Incremented whenever the product list or the lookup maps change,
+  // so that clients may cache lookup results between such changes.
+  unsigned generation() const {
+    return generation_;
+  }
   void print(std::ostream&) const;
   void addProduct(std::unique_ptr<BranchDescription>&&);
   void initFromFirstPrimaryFile(ProductList const&, FileBlock const&);
@@ -97,6 +102,7 @@ private:
   // <product::value_type friendly class name, process name>.
   std::vector<TypeLookup> elementLookup_;
   std::vector<ProductListUpdatedCallback> productListUpdatedCallbacks_;
+  unsigned generation_;
 };
 
 } // namespace art
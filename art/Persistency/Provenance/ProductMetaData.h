@@ -103,6 +103,12 @@ public:
     return mpr_->elementLookup();
   }
 
+  // Changes whenever the product list or the lookup maps change.
+  unsigned generation() const
+  {
+    return mpr_->generation();
+  }
+
   // Return true if any product is produced in this process for
   // the given branch type.
   bool productProduced(BranchType which) const
@@ -26,6 +26,9 @@ class art::TransientStreamer : public TClassStreamer {
   typedef T element_type;
   TransientStreamer();
   void operator() (TBuffer &R_b, void *objp);
+  TClassStreamer* Generate() const override {
+    return new TransientStreamer<T>(*this);
+  }
 private:
   std::string className_;
   TClassRef cl_;
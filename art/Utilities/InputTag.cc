@@ -1,25 +1,32 @@
 #include "art/Utilities/InputTag.h"
 
 #include "art/Utilities/Exception.h"
-#include "boost/algorithm/string/classification.hpp"
-#include "boost/algorithm/string/split.hpp"
+
+#include <algorithm>
 
 namespace art {
-  void InputTag::set_from_string_(std::string const& s)
+  void InputTag::set_from_string_(char const* s, std::size_t len)
   {
-    // string is delimited by colons
-    std::vector<std::string> tokens;
-    // cet::split(s, ':', std::back_inserter(tokens));
-    boost::split(tokens, s, boost::is_any_of(":"), boost::token_compress_off);
-
-    int nwords = tokens.size();
+    // string is delimited by colons; each field is interned directly
+    // from the characters, without a temporary copy.
+    char const* const end = s + len;
+    int const nwords = std::count(s, end, ':') + 1;
     if(nwords > 3) {
       throw art::Exception(errors::Configuration,"InputTag")
-        << "Input tag " << s << " has " << nwords << " tokens";
+        << "Input tag " << std::string(s, len) << " has " << nwords << " tokens";
+    }
+    char const* b = s;
+    char const* e = std::find(b, end, ':');
+    label_ = Symbol(b, e - b);
+    if(nwords > 1) {
+      b = e + 1;
+      e = std::find(b, end, ':');
+      instance_ = Symbol(b, e - b);
+    }
+    if(nwords > 2) {
+      b = e + 1;
+      process_ = Symbol(b, end - b);
     }
-    if(nwords > 0) label_ = tokens[0];
-    if(nwords > 1) instance_ = tokens[1];
-    if(nwords > 2) process_=tokens[2];
   }
 
   std::string InputTag::encode() const {
@@ -27,12 +34,12 @@ namespace art {
     // to change it so that not specifying a process would cause two colons to appear in the
     // encoding and thus not being backwards compatible
     static std::string const separator(":");
-    std::string result = label_;
+    std::string result = label();
     if(!instance_.empty() || !process_.empty()) {
-      result += separator + instance_;
+      result += separator + instance();
     }
     if(!process_.empty()) {
-      result += separator + process_;
+      result += separator + process();
     }
     return result;
   }
@@ -1,9 +1,11 @@
 #ifndef art_Utilities_InputTag_h
 #define art_Utilities_InputTag_h
 
+#include "art/Utilities/Symbol.h"
 #include "art/Utilities/fwd.h"
 #include "fhiclcpp/ParameterSet.h"
 
+#include <cstring>
 #include <iosfwd>
 #include <string>
 #include <vector>
@@ -15,6 +17,10 @@ namespace art {
   bool operator != (InputTag const & left, InputTag const & right);
 }
 
+// The label, instance and process name are held as Symbols, so copying
+// an InputTag does not allocate, and comparing or hashing one does not
+// look at the characters.
+
 class art::InputTag {
 public:
   InputTag();
@@ -46,22 +52,26 @@ public:
 
   std::string encode() const;
 
-  std::string const& label() const {return label_;}
-  std::string const& instance() const {return instance_;}
+  std::string const& label() const {return label_.str();}
+  std::string const& instance() const {return instance_.str();}
   ///an empty string means find the most recently produced
   ///product with the label and instance
-  std::string const& process() const {return process_;}
+  std::string const& process() const {return process_.str();}
+
+  Symbol const& labelSymbol() const {return label_;}
+  Symbol const& instanceSymbol() const {return instance_;}
+  Symbol const& processSymbol() const {return process_;}
 
   bool operator==(InputTag const& tag) const;
 
 private:
-  std::string label_;
-  std::string instance_;
-  std::string process_;
+  Symbol label_;
+  Symbol instance_;
+  Symbol process_;
 
   // Helper function, to parse colon-separated initialization
   // string.
-  void set_from_string_(std::string const& s);
+  void set_from_string_(char const* s, std::size_t len);
 };
 
 #ifndef __GCCXML__
@@ -103,7 +113,7 @@ InputTag(std::string const& s)
   instance_(),
   process_()
 {
-  set_from_string_(s);
+  set_from_string_(s.data(), s.size());
 }
 
 inline
@@ -114,7 +124,7 @@ InputTag(const char* s)
   instance_(),
   process_()
 {
-  set_from_string_(s);
+  set_from_string_(s, std::strlen(s));
 }
 
 inline
@@ -134,6 +144,18 @@ operator!=(InputTag const & left, InputTag const & right)
 {
   return ! (left == right);
 }
+
+namespace std {
+  template <>
+  struct hash<art::InputTag> {
+    std::size_t operator () (art::InputTag const& tag) const
+    {
+      std::size_t h = tag.labelSymbol().id();
+      h = h * 31 + tag.instanceSymbol().id();
+      return h * 31 + tag.processSymbol().id();
+    }
+  };
+}
 #endif /* __GCCXML__ */
 
 //=====================================================================
@@ -0,0 +1,293 @@
+#include "art/Utilities/MonotonicArena.h"
+// vim: set sw=2:
+
+#include "art/Utilities/Exception.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <new>
+
+namespace {
+
+  thread_local art::MonotonicArena* currentArena = nullptr;
+
+  std::atomic<std::size_t> totalInUse { 0 };
+  std::atomic<std::size_t> peakInUse { 0 };
+  std::atomic<std::size_t> largestHighWater { 0 };
+  std::atomic<std::size_t> nBlocksAllocated { 0 };
+
+  // The blocks of all arenas, by start address, for contains().
+  std::mutex registryMutex;
+  std::map<char const*, std::size_t, std::greater<char const*>> registry;
+
+  void
+  updateMax(std::atomic<std::size_t>& max, std::size_t const value)
+  {
+    auto seen = max.load(std::memory_order_relaxed);
+    while (seen < value &&
+           !max.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  char*
+  align(char* p, std::size_t const alignment)
+  {
+    auto const addr = reinterpret_cast<std::uintptr_t>(p);
+    return p + ((alignment - addr % alignment) % alignment);
+  }
+
+  // Each object placed by allocateObject() is preceded by the address
+  // of its arena, null for the heap.
+  constexpr std::size_t headerSize = alignof(std::max_align_t);
+
+} // namespace
+
+std::atomic<bool> art::MonotonicArena::placeObjects_ { true };
+std::atomic<bool> art::MonotonicArena::objectsPlaced_ { false };
+std::atomic<bool> art::MonotonicArena::foreignObjects_ { false };
+
+art::MonotonicArena::
+MonotonicArena(std::size_t const blockSize)
+  :
+  blockSize_(blockSize),
+  blocks_(),
+  current_(0),
+  next_(nullptr),
+  end_(nullptr),
+  used_(0),
+  highWaterMark_(0),
+  mutex_()
+{
+}
+
+art::MonotonicArena::
+~MonotonicArena()
+{
+  totalInUse -= used_;
+  freeBlocks_(blocks_.size());
+}
+
+void*
+art::MonotonicArena::
+allocate(std::size_t const n, std::size_t const alignment)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return allocate_(n, alignment);
+}
+
+void
+art::MonotonicArena::
+release()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  totalInUse -= used_;
+  used_ = 0;
+  if (blocks_.empty()) {
+    return;
+  }
+  auto const largest =
+    std::max_element(blocks_.cbegin(), blocks_.cend(),
+                     [](Block const& a, Block const& b) {
+                       return a.second < b.second;
+                     }) - blocks_.cbegin();
+  freeBlocks_(largest);
+  current_ = 0;
+  next_ = blocks_.front().first;
+  end_ = next_ + blocks_.front().second;
+}
+
+art::MonotonicArena::Mark
+art::MonotonicArena::
+mark()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Mark { current_, next_, used_ };
+}
+
+void
+art::MonotonicArena::
+rewind(Mark const& mark)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  totalInUse -= used_ - mark.used;
+  used_ = mark.used;
+  current_ = mark.block;
+  next_ = mark.next;
+  end_ = next_ ? blocks_[current_].first + blocks_[current_].second : nullptr;
+}
+
+void*
+art::MonotonicArena::
+allocate_(std::size_t const n, std::size_t const alignment)
+{
+  char* p = next_ ? align(next_, alignment) : nullptr;
+  if (p == nullptr || n > static_cast<std::size_t>(end_ - p)) {
+    nextBlock_(n + alignment);
+    p = align(next_, alignment);
+  }
+  auto const size = static_cast<std::size_t>(p + n - next_);
+  next_ = p + n;
+  used_ += size;
+  highWaterMark_ = std::max(highWaterMark_, used_);
+  updateMax(peakInUse, totalInUse += size);
+  updateMax(largestHighWater, highWaterMark_);
+  return p;
+}
+
+// Move on to the next block big enough, after a rewind(), or else to
+// a new one. Blocks double in size, so that the number an event needs
+// grows only as the logarithm of its size.
+void
+art::MonotonicArena::
+nextBlock_(std::size_t const minSize)
+{
+  for (auto i = next_ ? current_ + 1 : 0; i < blocks_.size(); ++i) {
+    if (blocks_[i].second >= minSize) {
+      current_ = i;
+      next_ = blocks_[i].first;
+      end_ = next_ + blocks_[i].second;
+      return;
+    }
+  }
+  auto size = blocks_.empty() ? blockSize_ : 2 * blocks_.back().second;
+  size = std::max(size, minSize);
+  auto const block = static_cast<char*>(::operator new(size));
+  blocks_.emplace_back(block, size);
+  current_ = blocks_.size() - 1;
+  ++nBlocksAllocated;
+  {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    registry.emplace(block, size);
+  }
+  next_ = block;
+  end_ = block + size;
+}
+
+// Free all blocks but the one at index keep (all, if out of range).
+void
+art::MonotonicArena::
+freeBlocks_(std::size_t const keep)
+{
+  {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (std::size_t i = 0; i != blocks_.size(); ++i) {
+      if (i != keep) {
+        registry.erase(blocks_[i].first);
+      }
+    }
+  }
+  for (std::size_t i = 0; i != blocks_.size(); ++i) {
+    if (i != keep) {
+      ::operator delete(blocks_[i].first);
+    }
+  }
+  if (keep < blocks_.size()) {
+    blocks_ = { blocks_[keep] };
+  }
+  else {
+    blocks_.clear();
+    current_ = 0;
+    next_ = end_ = nullptr;
+  }
+}
+
+cet::exempt_ptr<art::MonotonicArena>
+art::MonotonicArena::
+current()
+{
+  return cet::exempt_ptr<MonotonicArena>(currentArena);
+}
+
+void*
+art::MonotonicArena::
+allocateObject(std::size_t const n)
+{
+  if (!objectsPlaced_.load(std::memory_order_relaxed)) {
+    objectsPlaced_.store(true);
+  }
+  if (!placeObjects_.load(std::memory_order_relaxed)) {
+    return ::operator new(n);
+  }
+  MonotonicArena* const arena = currentArena;
+  auto const base = static_cast<char*>(arena ?
+                                       arena->allocate(headerSize + n, headerSize) :
+                                       ::operator new(headerSize + n));
+  *reinterpret_cast<MonotonicArena**>(base) = arena;
+  return base + headerSize;
+}
+
+void
+art::MonotonicArena::
+deallocateObject(void* const p) noexcept
+{
+  if (p == nullptr) {
+    return;
+  }
+  if (!placeObjects_.load(std::memory_order_relaxed)) {
+    ::operator delete(p);
+    return;
+  }
+  auto const base = static_cast<char*>(p) - headerSize;
+  if (*reinterpret_cast<MonotonicArena**>(base) == nullptr) {
+    ::operator delete(base);
+  }
+}
+
+void
+art::MonotonicArena::
+setPlaceObjects(bool const place)
+{
+  if (place != placeObjects_.load() && objectsPlaced_.load()) {
+    throw Exception(errors::LogicError)
+      << "MonotonicArena::setPlaceObjects("
+      << (place ? "true" : "false")
+      << ") was called after objects had been allocated.\n";
+  }
+  placeObjects_ = place;
+}
+
+void
+art::MonotonicArena::
+setForeignObjects(bool const foreign)
+{
+  foreignObjects_ = foreign;
+}
+
+bool
+art::MonotonicArena::
+contains(void const* const p)
+{
+  auto const addr = static_cast<char const*>(p);
+  std::lock_guard<std::mutex> lock(registryMutex);
+  // The block starting at or before addr.
+  auto const it = registry.lower_bound(addr);
+  return it != registry.cend() &&
+    static_cast<std::size_t>(addr - it->first) < it->second;
+}
+
+art::MonotonicArena::Statistics
+art::MonotonicArena::
+statistics()
+{
+  return Statistics { totalInUse.load(),
+                      peakInUse.load(),
+                      largestHighWater.load(),
+                      nBlocksAllocated.load() };
+}
+
+art::MonotonicArena::Scope::
+Scope(cet::exempt_ptr<MonotonicArena> const arena)
+  :
+  previous_(currentArena)
+{
+  currentArena = arena.get();
+}
+
+art::MonotonicArena::Scope::
+~Scope()
+{
+  currentArena = previous_;
+}
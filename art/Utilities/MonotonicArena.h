@@ -0,0 +1,172 @@
+#ifndef art_Utilities_MonotonicArena_h
+#define art_Utilities_MonotonicArena_h
+// vim: set sw=2:
+
+//
+// MonotonicArena
+//
+// Memory handed out by bumping a pointer through large blocks, and
+// given back only in bulk, by release() or destruction. Suited to the
+// many small, short-lived objects made for one event, which would
+// otherwise go to and from the general heap one by one.
+//
+// release() keeps the largest block, so an arena reused for event
+// after event settles into a single block of the size the events
+// need.
+//
+// Classes whose objects may live in an arena give themselves
+//
+//   static void* operator new(std::size_t n)
+//   { return MonotonicArena::allocateObject(n); }
+//   static void operator delete(void* p)
+//   { MonotonicArena::deallocateObject(p); }
+//
+// Such an object is placed in the arena made current on the calling
+// thread by a MonotonicArena::Scope, or on the heap if there is none;
+// its deletion frees heap memory, and leaves arena memory to the
+// arena. An object placed in an arena must be destroyed before the
+// arena is released. With setPlaceObjects(false), made before the
+// first such object, all of them go straight to the heap, without the
+// header which otherwise records where each one lives.
+//
+// Objects constructed in memory from allocate() by other means (such
+// as TClass::New(void*)) can be told apart from heap objects by
+// contains(), at the cost of a lookup. That is needed only once
+// setForeignObjects(true) has announced there may be such objects.
+//
+// A principal reused for event after event may keep the objects made
+// before a mark() and give back everything after it with rewind(); the
+// blocks past the mark are then handed out again rather than freed.
+//
+// Allocation is serialized; release() and rewind() must not race with
+// it.
+//
+
+#include "cetlib/exempt_ptr.h"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace art {
+  class MonotonicArena;
+}
+
+class art::MonotonicArena {
+public:
+  static constexpr std::size_t defaultBlockSize = 64 * 1024;
+
+  // Totals over all arenas of the job.
+  struct Statistics {
+    std::size_t bytesInUse;       // In all arenas now.
+    std::size_t peakBytesInUse;   // Largest value of bytesInUse.
+    std::size_t largestArena;     // Largest high-water mark of one arena.
+    std::size_t blocksAllocated;  // Blocks obtained from the heap.
+  };
+
+  // A position in the arena, from mark(). Default-constructed, it is
+  // the position of an empty arena.
+  struct Mark {
+    std::size_t block;
+    char* next;
+    std::size_t used;
+  };
+
+  class Scope;
+
+  explicit MonotonicArena(std::size_t blockSize = defaultBlockSize);
+  ~MonotonicArena();
+
+  MonotonicArena(MonotonicArena const&) = delete;
+  MonotonicArena& operator=(MonotonicArena const&) = delete;
+
+  void* allocate(std::size_t n,
+                 std::size_t alignment = alignof(std::max_align_t));
+
+  // Give back everything allocated, keeping the largest block. Marks
+  // taken before are no longer valid.
+  void release();
+
+  Mark mark();
+
+  // Give back everything allocated since the mark was taken, keeping
+  // all the blocks.
+  void rewind(Mark const& mark);
+
+  // Bytes handed out since the last release().
+  std::size_t bytesInUse() const { return used_; }
+
+  // Largest value of bytesInUse() over the life of the arena.
+  std::size_t highWaterMark() const { return highWaterMark_; }
+
+  std::size_t blocks() const { return blocks_.size(); }
+
+  static cet::exempt_ptr<MonotonicArena> current();
+
+  static void* allocateObject(std::size_t n);
+  static void deallocateObject(void* p) noexcept;
+
+  // Whether allocateObject() uses arenas at all (the default). Fixed
+  // by the first call to allocateObject(); changing it later throws.
+  static void setPlaceObjects(bool place);
+
+  // Whether objects may be constructed in arenas other than by
+  // allocateObject() (not by default).
+  static void setForeignObjects(bool foreign);
+  static bool foreignObjects();
+
+  // True if p is in a block of any arena.
+  static bool contains(void const* p);
+
+  static Statistics statistics();
+
+private:
+  using Block = std::pair<char*, std::size_t>;
+
+  void* allocate_(std::size_t n, std::size_t alignment);
+  void nextBlock_(std::size_t minSize);
+  void freeBlocks_(std::size_t keep);
+
+  std::size_t const blockSize_;
+  std::vector<Block> blocks_;
+  std::size_t current_; // Block holding next_, if not null.
+  char* next_;
+  char* end_;
+  std::size_t used_;
+  std::size_t highWaterMark_;
+  std::mutex mutex_;
+
+  static std::atomic<bool> placeObjects_;
+  static std::atomic<bool> objectsPlaced_;
+  static std::atomic<bool> foreignObjects_;
+};
+
+inline
+bool
+art::MonotonicArena::
+foreignObjects()
+{
+  return foreignObjects_.load(std::memory_order_relaxed);
+}
+
+// Make an arena current on the calling thread while in scope. A null
+// arena makes objects go to the heap.
+class art::MonotonicArena::Scope {
+public:
+  explicit Scope(cet::exempt_ptr<MonotonicArena> arena);
+  ~Scope();
+
+  Scope(Scope const&) = delete;
+  Scope& operator=(Scope const&) = delete;
+
+private:
+  MonotonicArena* previous_;
+};
+
+#endif /* art_Utilities_MonotonicArena_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,204 @@
+#include "art/Utilities/Symbol.h"
+
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+using art::detail::SymbolEntry;
+
+namespace {
+
+  std::size_t
+  hashChars(char const* s, std::size_t len)
+  {
+    // FNV-1a.
+    std::size_t h = 2166136261u;
+    for (std::size_t i = 0; i != len; ++i) {
+      h = (h ^ static_cast<unsigned char>(s[i])) * 16777619u;
+    }
+    return h;
+  }
+
+  // The entries are held in a deque, which never moves them, and are
+  // found through an open-addressed index of entry pointers kept at a
+  // load factor of at most one half.
+  //
+  // Lookups of strings already interned take no lock: the index and
+  // its slots are published with release stores once the entries they
+  // point to are complete. Only insertion is serialized. An index
+  // replaced on growth is kept until the table is destroyed, since
+  // readers may still be probing it.
+  class SymbolTable {
+  public:
+    SymbolTable()
+      :
+      mutex_(),
+      entries_(),
+      indexes_(),
+      index_(nullptr),
+      empty_(nullptr)
+    {
+      indexes_.emplace_back(new Index(64));
+      index_.store(indexes_.back().get(), std::memory_order_release);
+      entries_.push_back(SymbolEntry { std::string(), 0, hashChars("", 0) });
+      empty_ = &entries_.back();
+      insert_(*indexes_.back(), empty_);
+    }
+
+    SymbolEntry const*
+    intern(char const* s, std::size_t len)
+    {
+      if (len == 0) {
+        return emptyEntry();
+      }
+      std::size_t const h = hashChars(s, len);
+      if (SymbolEntry const* e = find_(*index_.load(std::memory_order_acquire), s, len, h)) {
+        return e;
+      }
+      std::lock_guard<std::mutex> lock(mutex_);
+      Index& index = *indexes_.back();
+      if (SymbolEntry const* e = find_(index, s, len, h)) {
+        return e;
+      }
+      entries_.push_back(SymbolEntry { std::string(s, len), entries_.size(), h });
+      SymbolEntry const* const e = &entries_.back();
+      if (2 * entries_.size() > index.size) {
+        rehash_();
+      }
+      else {
+        insert_(index, e);
+      }
+      return e;
+    }
+
+    SymbolEntry const*
+    emptyEntry() const
+    {
+      return empty_;
+    }
+
+    std::size_t
+    size()
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return entries_.size();
+    }
+
+  private:
+    struct Index {
+      explicit Index(std::size_t n)
+        :
+        size(n),
+        slots(new std::atomic<SymbolEntry const*>[n])
+      {
+        for (std::size_t i = 0; i != n; ++i) {
+          slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+      }
+      std::size_t const size; // A power of two.
+      std::unique_ptr<std::atomic<SymbolEntry const*>[]> slots;
+    };
+
+    // Return the entry of the string, or null if it is not in the
+    // index.
+    static
+    SymbolEntry const*
+    find_(Index const& index, char const* s, std::size_t len, std::size_t h)
+    {
+      std::size_t const mask = index.size - 1;
+      for (std::size_t i = h & mask; ; i = (i + 1) & mask) {
+        SymbolEntry const* const e = index.slots[i].load(std::memory_order_acquire);
+        if (e == nullptr) {
+          return nullptr;
+        }
+        if (e->hash == h && e->name.size() == len &&
+            std::memcmp(e->name.data(), s, len) == 0) {
+          return e;
+        }
+      }
+    }
+
+    static
+    void
+    insert_(Index& index, SymbolEntry const* e)
+    {
+      std::size_t const mask = index.size - 1;
+      std::size_t i = e->hash & mask;
+      while (index.slots[i].load(std::memory_order_relaxed) != nullptr) {
+        i = (i + 1) & mask;
+      }
+      index.slots[i].store(e, std::memory_order_release);
+    }
+
+    void
+    rehash_()
+    {
+      std::unique_ptr<Index> index(new Index(2 * indexes_.back()->size));
+      for (auto const& entry : entries_) {
+        insert_(*index, &entry);
+      }
+      indexes_.push_back(std::move(index));
+      index_.store(indexes_.back().get(), std::memory_order_release);
+    }
+
+    std::mutex mutex_;
+    std::deque<SymbolEntry> entries_;
+    // Every index made so far; the last is the current one.
+    std::vector<std::unique_ptr<Index>> indexes_;
+    std::atomic<Index const*> index_;
+    SymbolEntry const* empty_;
+  };
+
+  SymbolTable&
+  table()
+  {
+    static SymbolTable s_table;
+    return s_table;
+  }
+
+}
+
+art::Symbol::
+Symbol()
+  :
+  entry_(table().emptyEntry())
+{
+}
+
+art::Symbol::
+Symbol(std::string const& s)
+  :
+  entry_(table().intern(s.data(), s.size()))
+{
+}
+
+art::Symbol::
+Symbol(char const* s)
+  :
+  entry_(table().intern(s, std::strlen(s)))
+{
+}
+
+art::Symbol::
+Symbol(char const* s, std::size_t len)
+  :
+  entry_(table().intern(s, len))
+{
+}
+
+std::size_t
+art::Symbol::
+tableSize()
+{
+  return table().size();
+}
+
+std::ostream&
+art::operator << (std::ostream& os, Symbol const& s)
+{
+  return os << s.str();
+}
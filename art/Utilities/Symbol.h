@@ -0,0 +1,82 @@
+#ifndef art_Utilities_Symbol_h
+#define art_Utilities_Symbol_h
+// vim: set sw=2:
+
+//
+// Symbol
+//
+// An interned string, used for module labels, product instance names
+// and process names.
+//
+// Each distinct string is stored once, in a process-wide table, and
+// numbered in order of first appearance; the empty string is always
+// id 0.  A Symbol refers to its table entry, so copying one never
+// allocates, and Symbols compare and hash by id without looking at the
+// characters.  Making a Symbol from a string already interned costs
+// one probe of the table, without locking; only the first appearance
+// of a string takes a lock and allocates.
+//
+// Entries are never removed: the labels and process names seen by a
+// job are few.
+//
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#ifndef __GCCXML__
+#include <functional>
+#endif
+
+namespace art {
+  class Symbol;
+
+  namespace detail {
+    struct SymbolEntry {
+      std::string name;
+      std::size_t id;
+      std::size_t hash;
+    };
+  }
+
+  std::ostream& operator << (std::ostream& os, Symbol const& s);
+}
+
+class art::Symbol {
+public:
+  // The empty string.
+  Symbol();
+
+  Symbol(std::string const& s);
+  Symbol(char const* s);
+  Symbol(char const* s, std::size_t len);
+
+  // use compiler-generated copy c'tor, copy assignment, and d'tor
+
+  std::string const& str() const { return entry_->name; }
+  std::size_t id() const { return entry_->id; }
+  bool empty() const { return entry_->id == 0; }
+
+  bool operator == (Symbol const& other) const { return entry_ == other.entry_; }
+  bool operator != (Symbol const& other) const { return entry_ != other.entry_; }
+
+  // The number of distinct strings interned so far.
+  static std::size_t tableSize();
+
+private:
+  detail::SymbolEntry const* entry_;
+};
+
+#ifndef __GCCXML__
+namespace std {
+  template <>
+  struct hash<art::Symbol> {
+    std::size_t operator () (art::Symbol const& s) const { return s.id(); }
+  };
+}
+#endif /* __GCCXML__ */
+
+#endif /* art_Utilities_Symbol_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -131,6 +131,87 @@ void testall(const Strings& paths,
     }
 }
 
+// Selection over more paths than fit in one word of packed states.
+void testManyPaths()
+{
+  const unsigned int n = 100;
+  Strings paths;
+  for (unsigned int i = 0; i != n; ++i) {
+    paths.push_back("p" + std::to_string(i));
+  }
+  HLTGlobalStatus bm(n);
+  std::vector<unsigned char> bitArray((n + 3) / 4, 0);
+  auto set = [&bm, &bitArray](unsigned int i, art::hlt::HLTState s) {
+    bm[i] = HLTPathStatus(s);
+    bitArray[i / 4] = (bitArray[i / 4] & ~(0x3 << (2 * (i % 4)))) | (s << (2 * (i % 4)));
+  };
+  for (unsigned int i = 0; i != n; ++i) {
+    set(i, art::hlt::Fail);
+  }
+  set(70, art::hlt::Pass);
+  set(99, art::hlt::Exception);
+  TriggerResults results(bm, fhicl::ParameterSetID());
+
+  auto check = [&](Strings const& pattern, bool answer) {
+    EventSelector select(pattern, paths);
+    bool const a1 = select.acceptEvent(results);
+    bool const a2 = select.acceptEvent(&bitArray[0], n);
+    if (a1 != answer || a2 != answer) {
+      std::cerr << "failed many-paths selection: "
+                << "correct=" << answer << " "
+                << "results=" << a1 << "  " << a2 << "\n"
+                << "pattern=" << pattern << "\n";
+      abort();
+    }
+  };
+  check(Strings {"p70"}, true);
+  check(Strings {"p71"}, false);
+  check(Strings {"!p71"}, true);
+  check(Strings {"!p7*"}, false); // p70 passed.
+  check(Strings {"!p3*"}, true);
+  check(Strings {"p70&noexception"}, false); // p99 excepted.
+  check(Strings {"exception@p99"}, true);
+  check(Strings {"exception@p98"}, false);
+}
+
+// Events alternating between the TriggerResults of two configurations,
+// with the same paths in a different order: each event must be decided
+// with the selection for its own trigger names.
+void testAlternatingPsetIDs()
+{
+  Strings const paths1 {"a1", "b1", "c1"};
+  Strings const paths2 {"c1", "b1", "a1"};
+  ParameterSet trigger_pset1;
+  trigger_pset1.put<Strings>("trigger_paths", paths1);
+  ParameterSetRegistry::put(trigger_pset1);
+  ParameterSet trigger_pset2;
+  trigger_pset2.put<Strings>("trigger_paths", paths2);
+  ParameterSetRegistry::put(trigger_pset2);
+
+  // Only the first path of the configuration passes.
+  HLTGlobalStatus bm(3);
+  bm[0] = HLTPathStatus(art::hlt::Pass);
+  bm[1] = HLTPathStatus(art::hlt::Fail);
+  bm[2] = HLTPathStatus(art::hlt::Fail);
+  TriggerResults const results1(bm, trigger_pset1.id());
+  TriggerResults const results2(bm, trigger_pset2.id());
+
+  EventSelector selectA(Strings {"a1"});
+  EventSelector selectNotC(Strings {"!c1"});
+  for (int i = 0; i != 6; ++i) {
+    bool const first = (i % 2 == 0);
+    TriggerResults const& results = first ? results1 : results2;
+    bool const a = selectA.acceptEvent(results);
+    bool const notC = selectNotC.acceptEvent(results);
+    if (a != first || notC != first) {
+      std::cerr << "failed alternating selection: "
+                << "event=" << i << " "
+                << "correct=" << first << " "
+                << "results=" << a << "  " << notC << "\n";
+      abort();
+    }
+  }
+}
 
 int main()
 {
@@ -245,5 +326,7 @@ int main()
 
   // We are ready to run some tests
   testall(paths, patterns, testmasks, ans);
+  testManyPaths();
+  testAlternatingPsetIDs();
   return 0;
 }
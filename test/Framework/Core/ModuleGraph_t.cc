@@ -0,0 +1,137 @@
+#define BOOST_TEST_MODULE ( ModuleGraph Test )
+#include "boost/test/auto_unit_test.hpp"
+
+#include "art/Framework/Core/detail/ModuleGraph.h"
+#include "art/Utilities/Exception.h"
+#include "art/Utilities/InputTag.h"
+#include "art/Utilities/TypeID.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using art::detail::ModuleGraph;
+
+namespace {
+  ModuleGraph::Module
+  producer(std::string const & label,
+           std::string const & instance = std::string())
+  {
+    ModuleGraph::Module result;
+    result.label = label;
+    result.declared = true;
+    result.produced.push_back(ModuleGraph::ProductName { "int", instance });
+    return result;
+  }
+
+  void
+  consume(ModuleGraph::Module & mod, art::InputTag const & tag)
+  {
+    mod.consumed.push_back(art::ConsumedProduct { art::TypeID(typeid(int)), tag });
+  }
+}
+
+BOOST_AUTO_TEST_SUITE ( ModuleGraph_t )
+
+BOOST_AUTO_TEST_CASE ( Dependencies )
+{
+  std::vector<ModuleGraph::Module> modules;
+  modules.push_back(producer("a"));
+  modules.push_back(producer("b", "x"));
+  modules.push_back(producer("c"));
+  modules.push_back(producer("d"));
+  consume(modules[2], art::InputTag("a"));
+  consume(modules[2], art::InputTag("b", "x"));
+  consume(modules[2], art::InputTag("a")); // Repeated: one edge.
+  consume(modules[3], art::InputTag("c", "", "TEST"));
+  ModuleGraph const graph(modules, "TEST");
+
+  BOOST_CHECK_EQUAL(graph.size(), 4u);
+  BOOST_CHECK(graph.contains("d"));
+  BOOST_CHECK(!graph.contains("e"));
+  auto const direct = graph.directDependencies("c");
+  BOOST_CHECK_EQUAL(direct.size(), 2u);
+  BOOST_CHECK(graph.dependsOn("c", "a"));
+  BOOST_CHECK(graph.dependsOn("c", "b"));
+  BOOST_CHECK(graph.dependsOn("d", "a")); // Through c.
+  BOOST_CHECK(!graph.dependsOn("a", "c"));
+  BOOST_CHECK(!graph.dependsOn("a", "b"));
+  BOOST_CHECK(!graph.dependsOn("e", "a"));
+}
+
+BOOST_AUTO_TEST_CASE ( NoDependency )
+{
+  std::vector<ModuleGraph::Module> modules;
+  modules.push_back(producer("a"));
+  modules.push_back(producer("b"));
+  consume(modules[1], art::InputTag("a", "", "EARLIER")); // From the input.
+  consume(modules[1], art::InputTag("a", "y")); // Not produced by a.
+  consume(modules[1], art::InputTag("z")); // Not a module.
+  consume(modules[1], art::InputTag("z", "", "TEST")); // Made by no one.
+  ModuleGraph const graph(modules, "TEST");
+  BOOST_CHECK(graph.directDependencies("b").empty());
+  BOOST_CHECK(!graph.dependsOn("b", "a"));
+  auto const & unresolved = graph.unresolved();
+  BOOST_REQUIRE_EQUAL(unresolved.size(), 2u);
+  BOOST_CHECK_EQUAL(unresolved[0], "b consumes int:a:y");
+  BOOST_CHECK_EQUAL(unresolved[1], "b consumes int:z::TEST");
+}
+
+BOOST_AUTO_TEST_CASE ( Undeclared )
+{
+  std::vector<ModuleGraph::Module> modules;
+  modules.push_back(producer("a"));
+  modules.push_back(producer("b"));
+  modules[1].declared = false;
+  ModuleGraph const graph(modules, "TEST");
+  BOOST_CHECK(graph.declared("a"));
+  BOOST_CHECK(!graph.declared("b"));
+  BOOST_CHECK(!graph.declared("c"));
+  BOOST_CHECK(graph.unresolved().empty());
+}
+
+BOOST_AUTO_TEST_CASE ( Cycle )
+{
+  std::vector<ModuleGraph::Module> modules;
+  modules.push_back(producer("a"));
+  modules.push_back(producer("b"));
+  modules.push_back(producer("c"));
+  consume(modules[0], art::InputTag("c"));
+  consume(modules[1], art::InputTag("a"));
+  consume(modules[2], art::InputTag("b"));
+  try {
+    ModuleGraph const graph(modules, "TEST");
+    BOOST_FAIL("A cycle of dependencies was not reported.");
+  }
+  catch (art::Exception const & e) {
+    BOOST_CHECK_EQUAL(e.categoryCode(), art::errors::Configuration);
+    BOOST_CHECK(e.explain_self().find("cycle of data dependencies") != std::string::npos);
+  }
+}
+
+BOOST_AUTO_TEST_CASE ( DuplicateLabel )
+{
+  std::vector<ModuleGraph::Module> modules;
+  modules.push_back(producer("a"));
+  modules.push_back(producer("a"));
+  BOOST_CHECK_THROW(ModuleGraph(modules, "TEST"), art::Exception);
+}
+
+BOOST_AUTO_TEST_CASE ( Dot )
+{
+  std::vector<ModuleGraph::Module> modules;
+  modules.push_back(producer("a", "x"));
+  modules.push_back(producer("b"));
+  consume(modules[1], art::InputTag("a", "x"));
+  ModuleGraph const graph(modules, "TEST");
+  std::ostringstream os;
+  graph.writeDot(os);
+  BOOST_CHECK_EQUAL(os.str(),
+                    "digraph modules {\n"
+                    "  \"a\";\n"
+                    "  \"b\";\n"
+                    "  \"a\" -> \"b\" [label=\"int:x\"];\n"
+                    "}\n");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -131,6 +131,20 @@ BOOST_AUTO_TEST_CASE(SeqNo)
   BOOST_CHECK_EQUAL(fr.applySubstitutions(pattern), std::string("ethel-02-charlie"));
 }
 
+BOOST_AUTO_TEST_CASE(OpenLatencies)
+{
+  fstats.recordFileOpen();
+  fstats.recordInputFile("/tmp/a.root", 0.5);
+  fstats.recordInputFile("");
+  fstats.recordInputFile("/tmp/b.root", 1.25);
+  BOOST_REQUIRE_EQUAL(fstats.parents().size(), 2u);
+  std::vector<double> const expected { 0.5, 1.25 };
+  BOOST_CHECK(fstats.inputFileOpenLatencies() == expected);
+  fstats.recordFileClose();
+  fstats.recordFileOpen();
+  BOOST_CHECK(fstats.inputFileOpenLatencies().empty());
+}
+
 BOOST_AUTO_TEST_CASE(SimpleFileNameSubs)
 {
   std::string const pattern("silly_%ifb_%ifd_%ife_%ifn_%ifp.root");
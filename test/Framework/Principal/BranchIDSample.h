@@ -0,0 +1,36 @@
+#ifndef test_Framework_Principal_BranchIDSample_h
+#define test_Framework_Principal_BranchIDSample_h
+
+// n distinct, valid BranchIDs, scattered as the hashes of branch names
+// are. The same n always gives the same sample.
+
+#include "art/Persistency/Provenance/BranchID.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace arttest {
+  inline
+  std::vector<art::BranchID>
+  makeIDs(std::size_t n)
+  {
+    std::mt19937 gen(4357);
+    std::vector<art::BranchID> result;
+    result.reserve(n);
+    while (result.size() < n) {
+      art::BranchID const id(static_cast<art::BranchID::value_type>(gen()));
+      if (id.isValid() &&
+          std::find(result.cbegin(), result.cend(), id) == result.cend()) {
+        result.push_back(id);
+      }
+    }
+    return result;
+  }
+}
+
+#endif /* test_Framework_Principal_BranchIDSample_h */
+
+// Local Variables:
+// mode: c++
+// End:
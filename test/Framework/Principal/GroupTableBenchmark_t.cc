@@ -0,0 +1,168 @@
+// Micro-benchmark of detail::GroupTable: per-event filling and lookup
+// against the std::map it replaced in Principal, and per-event
+// construction, filling and lookup of the EventPrincipal holding it.
+
+#define BOOST_TEST_MODULE (GroupTableBenchmark_t)
+#include "boost/test/auto_unit_test.hpp"
+
+#include "art/Framework/Core/RootDictionaryManager.h"
+#include "art/Framework/Principal/EventPrincipal.h"
+#include "art/Framework/Principal/Group.h"
+#include "art/Framework/Principal/detail/GroupTable.h"
+#include "art/Persistency/Provenance/BranchDescription.h"
+#include "art/Persistency/Provenance/BranchID.h"
+#include "art/Persistency/Provenance/BranchIDListHelper.h"
+#include "art/Persistency/Provenance/EventAuxiliary.h"
+#include "art/Persistency/Provenance/MasterProductRegistry.h"
+#include "art/Persistency/Provenance/ModuleDescription.h"
+#include "art/Persistency/Provenance/ProcessConfiguration.h"
+#include "art/Persistency/Provenance/ProductMetaData.h"
+#include "art/Persistency/Provenance/Timestamp.h"
+#include "art/Persistency/Provenance/TypeLabel.h"
+#include "art/Utilities/GetPassID.h"
+#include "art/Utilities/TypeID.h"
+#include "art/Version/GetReleaseVersion.h"
+#include "cetlib/cpu_timer.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "test/Framework/Principal/BranchIDSample.h"
+#include "test/TestObjects/ToyProducts.h"
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+using art::BranchID;
+using art::Group;
+using art::detail::GroupTable;
+
+using arttest::makeIDs;
+
+namespace {
+  template <typename COLL>
+  std::size_t
+  fillAndLookup(std::vector<BranchID> const & ids,
+                std::shared_ptr<Group> const & g,
+                std::size_t nLookups)
+  {
+    COLL coll;
+    for (auto const & id : ids) {
+      coll.insert(std::make_pair(id, g));
+    }
+    std::size_t nFound {0};
+    for (std::size_t i = 0; i != nLookups; ++i) {
+      if (coll.find(ids[(i * 7) % ids.size()]) != coll.end()) {
+        ++nFound;
+      }
+    }
+    return nFound;
+  }
+
+  // Register n event products of one process, as read from an input
+  // file, and return their descriptions.
+  std::vector<art::BranchDescription>
+  registerProducts(art::MasterProductRegistry & mpr,
+                   art::ProcessConfiguration const & pc,
+                   std::size_t n)
+  {
+    fhicl::ParameterSet modParams;
+    modParams.put<std::string>("module_type", "DummyModule");
+    modParams.put<std::string>("module_label", "dummyMod");
+    art::ModuleDescription const md(modParams.id(),
+                                    "DummyModule",
+                                    "dummyMod",
+                                    pc);
+    art::TypeID const dummyType(typeid(arttest::DummyProduct));
+    for (std::size_t i = 0; i != n; ++i) {
+      std::unique_ptr<art::BranchDescription>
+        bd(new art::BranchDescription(art::TypeLabel(art::InEvent,
+                                                     dummyType,
+                                                     "i" + std::to_string(i)),
+                                      md));
+      mpr.addProduct(std::move(bd));
+    }
+    mpr.setFrozen();
+    art::BranchIDListHelper::updateRegistries(mpr);
+    art::ProductMetaData::create_instance(mpr);
+    std::vector<art::BranchDescription> result;
+    for (auto const & val : mpr.productList()) {
+      result.push_back(val.second);
+    }
+    return result;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(GroupTableBenchmark_t)
+
+BOOST_AUTO_TEST_CASE(benchmark)
+{
+  std::size_t const nBranches {500};
+  std::size_t const nLookups {2000};
+  std::size_t const nEvents {2000};
+  auto const ids = makeIDs(nBranches);
+  auto const g = std::make_shared<Group>();
+  cet::cpu_timer mapTimer, tableTimer;
+  mapTimer.start();
+  for (std::size_t i = 0; i != nEvents; ++i) {
+    BOOST_REQUIRE_EQUAL((fillAndLookup<std::map<BranchID, std::shared_ptr<Group>>>(ids, g, nLookups)),
+                        nLookups);
+  }
+  mapTimer.stop();
+  tableTimer.start();
+  for (std::size_t i = 0; i != nEvents; ++i) {
+    BOOST_REQUIRE_EQUAL(fillAndLookup<GroupTable>(ids, g, nLookups),
+                        nLookups);
+  }
+  tableTimer.stop();
+  std::cout << "Per event (" << nBranches << " groups, "
+            << nLookups << " lookups):\n"
+            << "  std::map:   "
+            << mapTimer.realTime() / nEvents * 1.0e6 << " us\n"
+            << "  GroupTable: "
+            << tableTimer.realTime() / nEvents * 1.0e6 << " us\n";
+}
+
+BOOST_AUTO_TEST_CASE(principal)
+{
+  std::size_t const nBranches {500};
+  std::size_t const nLookups {2000};
+  std::size_t const nEvents {2000};
+  art::RootDictionaryManager rdm;
+  fhicl::ParameterSet processParams;
+  processParams.put<std::string>("process_name", "PROD");
+  art::ProcessConfiguration const pc("PROD",
+                                     processParams.id(),
+                                     art::getReleaseVersion(),
+                                     art::getPassID());
+  art::MasterProductRegistry mpr;
+  auto const descriptions = registerProducts(mpr, pc, nBranches);
+  art::Timestamp const now(1234567UL);
+  cet::cpu_timer fillTimer, lookupTimer;
+  for (std::size_t i = 0; i != nEvents; ++i) {
+    art::EventAuxiliary const aux(art::EventID(1, 1, i + 1), now, true);
+    fillTimer.start();
+    art::EventPrincipal ep(aux, pc);
+    for (auto const & bd : descriptions) {
+      ep.addGroup(bd);
+    }
+    fillTimer.stop();
+    std::size_t nFound {0};
+    lookupTimer.start();
+    for (std::size_t j = 0; j != nLookups; ++j) {
+      if (ep.getGroup(descriptions[(j * 7) % nBranches].branchID())) {
+        ++nFound;
+      }
+    }
+    lookupTimer.stop();
+    BOOST_REQUIRE_EQUAL(nFound, nLookups);
+  }
+  std::cout << "Per EventPrincipal (" << nBranches << " groups):\n"
+            << "  construct and fill: "
+            << fillTimer.realTime() / nEvents * 1.0e6 << " us\n"
+            << "  " << nLookups << " lookups:       "
+            << lookupTimer.realTime() / nEvents * 1.0e6 << " us\n";
+}
+
+BOOST_AUTO_TEST_SUITE_END()
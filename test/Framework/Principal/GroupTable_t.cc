@@ -0,0 +1,92 @@
+// Test of detail::GroupTable. See GroupTableBenchmark_t for timings.
+
+#define BOOST_TEST_MODULE (GroupTable_t)
+#include "boost/test/auto_unit_test.hpp"
+
+#include "art/Framework/Principal/Group.h"
+#include "art/Framework/Principal/detail/GroupTable.h"
+#include "art/Persistency/Provenance/BranchID.h"
+#include "test/Framework/Principal/BranchIDSample.h"
+
+#include <memory>
+#include <vector>
+
+using art::BranchID;
+using art::Group;
+using art::detail::GroupTable;
+using arttest::makeIDs;
+
+BOOST_AUTO_TEST_SUITE(GroupTable_t)
+
+BOOST_AUTO_TEST_CASE(insertionOrderFirstWins)
+{
+  GroupTable table;
+  auto g1 = std::make_shared<Group>();
+  auto g2 = std::make_shared<Group>();
+  table.insert(std::make_pair(BranchID(30), g1));
+  table.insert(std::make_pair(BranchID(10), g1));
+  table.insert(std::make_pair(BranchID(20), g1));
+  table.insert(std::make_pair(BranchID(10), g2));
+  BOOST_REQUIRE_EQUAL(table.size(), 3u);
+  BOOST_REQUIRE(table.find(BranchID(10))->second == g1);
+  BOOST_REQUIRE(table.find(BranchID(15)) == table.end());
+  std::vector<BranchID> const expected { BranchID(30), BranchID(10), BranchID(20) };
+  std::vector<BranchID> seen;
+  for (auto const & val : table) {
+    seen.push_back(val.first);
+  }
+  BOOST_REQUIRE(seen == expected);
+  std::vector<BranchID> const expectedSorted { BranchID(10), BranchID(20), BranchID(30) };
+  std::vector<BranchID> sorted;
+  for (auto const i : table.sorted()) {
+    sorted.push_back(i->first);
+  }
+  BOOST_REQUIRE(sorted == expectedSorted);
+  table.clear();
+  BOOST_REQUIRE(table.empty());
+  BOOST_REQUIRE(table.find(BranchID(10)) == table.end());
+}
+
+BOOST_AUTO_TEST_CASE(growth)
+{
+  auto const ids = makeIDs(1000);
+  auto const g = std::make_shared<Group>();
+  GroupTable table;
+  for (auto const & id : ids) {
+    table.insert(std::make_pair(id, g));
+  }
+  BOOST_REQUIRE_EQUAL(table.size(), ids.size());
+  for (std::size_t i = 0; i != ids.size(); ++i) {
+    BOOST_REQUIRE(table.find(ids[i]) == table.cbegin() + i);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(truncate)
+{
+  auto const ids = makeIDs(100);
+  auto const g = std::make_shared<Group>();
+  GroupTable table;
+  for (auto const & id : ids) {
+    table.insert(std::make_pair(id, g));
+  }
+  table.truncate(40);
+  BOOST_REQUIRE_EQUAL(table.size(), 40u);
+  for (std::size_t i = 0; i != ids.size(); ++i) {
+    if (i < 40) {
+      BOOST_REQUIRE(table.find(ids[i]) == table.cbegin() + i);
+    }
+    else {
+      BOOST_REQUIRE(table.find(ids[i]) == table.end());
+    }
+  }
+  // Refilled as before.
+  for (std::size_t i = 40; i != ids.size(); ++i) {
+    table.insert(std::make_pair(ids[i], g));
+  }
+  BOOST_REQUIRE_EQUAL(table.size(), ids.size());
+  BOOST_REQUIRE(table.find(ids[99]) == table.cbegin() + 99);
+  table.truncate(200);
+  BOOST_REQUIRE_EQUAL(table.size(), ids.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
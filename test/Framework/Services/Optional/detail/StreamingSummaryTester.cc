@@ -0,0 +1,107 @@
+#include "art/Framework/Services/Optional/detail/StreamingSummary.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using art::detail::StreamingSummary;
+
+//==========================================================
+namespace {
+
+  unsigned nFailures {0};
+
+  void check( bool const ok, std::string const & what ) {
+    if ( !ok ) {
+      std::cerr << "FAILED: " << what << std::endl;
+      ++nFailures;
+    }
+  }
+
+  // Compare the summary with exact values computed from the sorted
+  // sample.
+  void compare( StreamingSummary const & summary,
+                std::vector<double> values,
+                std::string const & name ) {
+
+    std::sort( values.begin(), values.end() );
+    double const tolerance = summary.relativeAccuracy()*1.0001;
+
+    check( summary.count() == values.size(), name+": count" );
+    check( summary.min() == values.front(), name+": min" );
+    check( summary.max() == values.back() , name+": max" );
+
+    double sum {0.};
+    for ( auto const v : values ) sum += v;
+    double const mean = sum/values.size();
+    double ss {0.};
+    for ( auto const v : values ) ss += (v-mean)*(v-mean);
+    double const rms = std::sqrt( ss/values.size() );
+
+    check( std::abs( summary.mean()-mean ) <= 1.e-9*std::max(1.,std::abs(mean)), name+": mean" );
+    check( std::abs( summary.rms() -rms  ) <= 1.e-9*std::max(1.,rms), name+": rms" );
+
+    for ( double const p : { 0., 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999, 1. } ) {
+      double const exact    = values[ static_cast<std::size_t>( std::floor( p*(values.size()-1) ) ) ];
+      double const estimate = summary.quantile( p );
+      bool const ok = ( exact == 0. ) ?
+        estimate == 0. :
+        std::abs( estimate-exact ) <= tolerance*std::abs( exact );
+      if ( !ok ) {
+        std::cerr << name << ": p = " << p << " exact = " << exact
+                  << " estimate = " << estimate << std::endl;
+      }
+      check( ok, name+": quantile" );
+    }
+  }
+
+}
+
+//==========================================================
+int main() {
+
+  std::default_random_engine engine;
+
+  // Timing-like values: log-normal, spanning several decades.
+  {
+    std::lognormal_distribution<double> dist( -7., 2. );
+    StreamingSummary summary;
+    std::vector<double> values;
+    for ( unsigned i(0) ; i != 100000 ; ++i ) {
+      double const v = dist( engine );
+      summary.add( v );
+      values.push_back( v );
+    }
+    compare( summary, values, "lognormal" );
+    check( summary.nBins() < 2000, "lognormal: bounded number of bins" );
+  }
+
+  // Memory-increment-like values: mostly zero, of either sign.
+  {
+    std::uniform_int_distribution<int> sign( -1, 1 );
+    std::exponential_distribution<double> dist( 0.5 );
+    StreamingSummary summary;
+    std::vector<double> values;
+    for ( unsigned i(0) ; i != 10000 ; ++i ) {
+      double const v = sign( engine )*dist( engine );
+      summary.add( v );
+      values.push_back( v );
+    }
+    compare( summary, values, "signed" );
+  }
+
+  // A single value, and an empty summary.
+  {
+    StreamingSummary summary( 0.001 );
+    summary.add( 3.25 );
+    compare( summary, { 3.25 }, "single" );
+    check( StreamingSummary().median() == 0., "empty: median" );
+    check( StreamingSummary().rms() == 0., "empty: rms" );
+  }
+
+  return nFailures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -100,6 +100,16 @@ BOOST_AUTO_TEST_CASE(TestSignal2_clear_t)
   BOOST_CHECK(os.is_empty());
 }
 
+BOOST_AUTO_TEST_CASE(TestSignal2_empty_t)
+{
+  TestSignal2 s;
+  BOOST_CHECK(s.empty());
+  s.watch(testCallback<0>);
+  BOOST_CHECK(!s.empty());
+  s.clear();
+  BOOST_CHECK(s.empty());
+}
+
 BOOST_AUTO_TEST_CASE(TestSignal1_t)
 {
   TestSignal1 s;
@@ -10,25 +10,24 @@ namespace arttest {
 class arttest::AddIntsProducer : public art::EDProducer {
 public:
    explicit AddIntsProducer(fhicl::ParameterSet const& p) :
-      labels_(p.get<std::vector<std::string> >("labels")) {
+      tokens_() {
+      for (auto const& label : p.get<std::vector<std::string> >("labels")) {
+         tokens_.push_back(consumes<IntProduct>(label));
+      }
       produces<IntProduct>();
    }
    virtual ~AddIntsProducer() { }
    virtual void produce(art::Event& e);
 private:
-   std::vector<std::string> labels_;
+   std::vector<art::ProductToken<IntProduct> > tokens_;
 };
 
 void
 arttest::AddIntsProducer::produce(art::Event& e) {
    int value = 0;
-   for(std::vector<std::string>::iterator
-          itLabel = labels_.begin(),
-          itLabelEnd = labels_.end();
-       itLabel != itLabelEnd;
-       ++itLabel) {
+   for (auto const& token : tokens_) {
       art::Handle<IntProduct> anInt;
-      e.getByLabel(*itLabel, anInt);
+      e.getByToken(token, anInt);
       value +=anInt->value;
    }
    std::unique_ptr<IntProduct> p(new IntProduct(value));
@@ -47,6 +47,7 @@ public:
 private:
   std::string const producerLabel_;
   bool const perTrackDiag_;
+  std::size_t const nQueries_;
 };
 
 
@@ -54,7 +55,8 @@ arttest::FindManySpeedTestAnalyzer::FindManySpeedTestAnalyzer(fhicl::ParameterSe
   :
   EDAnalyzer(p),
   producerLabel_(p.get<std::string>("producerLabel")),
-  perTrackDiag_(p.get<bool>("perTrackDiag", false))
+  perTrackDiag_(p.get<bool>("perTrackDiag", false)),
+  nQueries_(p.get<std::size_t>("nQueries", 1))
 {}
 
 void arttest::FindManySpeedTestAnalyzer::analyze(art::Event const & e)
@@ -86,6 +88,30 @@ void arttest::FindManySpeedTestAnalyzer::analyze(art::Event const & e)
       std::cout << "Track # " << i << " has " << fmp.at(i).size() << " associated hits.\n";
     }
   }
+
+  // Further queries on the same Assns use the index made by the first.
+  if (nQueries_ > 1) {
+    cet::cpu_timer qTimer;
+    qTimer.start();
+    for (std::size_t q = 1; q != nQueries_; ++q) {
+      art::FindManyP<Hit> fmp2(tPtrs, e, producerLabel_);
+      assert(fmp2.size() == fmp.size());
+      for (size_t i = 0, e = fmp.size(); i != e; ++i) {
+        assert(fmp2.at(i) == fmp.at(i));
+      }
+    }
+    qTimer.stop();
+    std::cout << "FindManyP construction time for " << nQueries_ - 1
+              << " further queries (CPU, real): (" << qTimer.cpuTime() << ", " << qTimer.realTime() << ") s.\n";
+  }
+
+  // The same query made with the collection itself, looking up items
+  // by address, must give the same answer.
+  art::FindManyP<Hit> fmpByAddress(hT, e, producerLabel_);
+  assert(fmpByAddress.size() == fmp.size());
+  for (size_t i = 0, e = fmp.size(); i != e; ++i) {
+    assert(fmpByAddress.at(i) == fmp.at(i));
+  }
 }
 
 DEFINE_ART_MODULE(arttest::FindManySpeedTestAnalyzer)
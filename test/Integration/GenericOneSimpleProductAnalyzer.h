@@ -4,6 +4,7 @@
 #include "art/Framework/Core/EDAnalyzer.h"
 #include "art/Framework/Principal/Event.h"
 #include "art/Framework/Principal/Handle.h"
+#include "art/Framework/Principal/ProductToken.h"
 #include "art/Utilities/detail/metaprogramming.h"
 #include "cetlib/exception.h"
 #include "fhiclcpp/ParameterSet.h"
@@ -51,7 +52,9 @@ public:
     art::EDAnalyzer(conf),
     value_(),
     input_label_(conf.get<std::string>("input_label")),
-    require_presence_(conf.get<bool>("require_presence", true))
+    require_presence_(conf.get<bool>("require_presence", true)),
+    use_token_(conf.get<bool>("use_token", false)),
+    token_(input_label_)
   {
     if (require_presence_) {
       value_ = conf.get<V>("expected_value");
@@ -60,7 +63,12 @@ public:
 
   void analyze(const art::Event &e) {
     art::Handle<P> handle;
-    e.getByLabel(input_label_, handle);
+    if (use_token_) {
+      e.getByToken(token_, handle);
+    }
+    else {
+      e.getByLabel(input_label_, handle);
+    }
     assert (handle.isValid() == require_presence_);
     if (require_presence_) {
       typename std::conditional<detail::has_value_member<V, P>::value, detail::GetValue<V, P>, detail::DereferenceHandle<V, P> >::type get_value;
@@ -77,6 +85,8 @@ public:
   void reconfigure(fhicl::ParameterSet const & pset) override {
     input_label_ = pset.get<std::string>("input_label");
     require_presence_ = pset.get<bool>("require_presence", true);
+    use_token_ = pset.get<bool>("use_token", false);
+    token_ = art::ProductToken<P>(input_label_);
     if (require_presence_) {
       value_ = pset.get<V>("expected_value");
     } else {
@@ -89,6 +99,8 @@ private:
   V value_;
   std::string input_label_;
   bool require_presence_;
+  bool use_token_;
+  art::ProductToken<P> token_;
 };
 
 #endif /* test_Integration_GenericOneSimpleProductAnalyzer_h */
@@ -33,6 +33,7 @@ public:
       // enums don't usually have a conversion from string
       branchType_( art::BranchType(p.get<unsigned long>("branchType", art::InEvent)) )
   {
+    consumesNothing();
     switch (branchType_) {
     case art::InEvent:
       produces<IntProduct>();
@@ -54,6 +55,7 @@ public:
   explicit IntProducer( int i )
   : value_(i)
   {
+    consumesNothing();
     produces<IntProduct>();
   }
 
@@ -0,0 +1,113 @@
+// ======================================================================
+//
+// SkippedEventsAnalyzer
+//
+// Checks the first event read, and that no Run or SubRun other than
+// those of the events read has been begun, after events have been
+// skipped by the source.
+//
+// ======================================================================
+
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Run.h"
+#include "art/Framework/Principal/SubRun.h"
+#include "art/Persistency/Provenance/EventID.h"
+#include "cetlib/exception.h"
+#include "fhiclcpp/ParameterSet.h"
+
+#include <vector>
+
+namespace arttest {
+  class SkippedEventsAnalyzer;
+}
+
+class arttest::SkippedEventsAnalyzer : public art::EDAnalyzer {
+public:
+  explicit SkippedEventsAnalyzer(fhicl::ParameterSet const& p);
+
+  void beginRun(art::Run const& r) override;
+  void beginSubRun(art::SubRun const& sr) override;
+  void analyze(art::Event const& e) override;
+  void endJob() override;
+
+private:
+  art::EventID const firstEventID_;
+  unsigned const nRuns_;
+  unsigned const nSubRuns_;
+  unsigned nRunsSeen_;
+  unsigned nSubRunsSeen_;
+  bool seenEvent_;
+};
+
+namespace {
+  art::EventID toEventID(std::vector<unsigned> const& v)
+  {
+    if (v.size() != 3) {
+      throw cet::exception("Configuration")
+        << "firstEventID must be given as [ run, subRun, event ].\n";
+    }
+    return art::EventID(v[0], v[1], v[2]);
+  }
+}
+
+arttest::SkippedEventsAnalyzer::
+SkippedEventsAnalyzer(fhicl::ParameterSet const& p)
+  :
+  art::EDAnalyzer(p),
+  firstEventID_(toEventID(p.get<std::vector<unsigned>>("firstEventID"))),
+  nRuns_(p.get<unsigned>("nRuns")),
+  nSubRuns_(p.get<unsigned>("nSubRuns")),
+  nRunsSeen_(0),
+  nSubRunsSeen_(0),
+  seenEvent_(false)
+{
+}
+
+void
+arttest::SkippedEventsAnalyzer::
+beginRun(art::Run const&)
+{
+  ++nRunsSeen_;
+}
+
+void
+arttest::SkippedEventsAnalyzer::
+beginSubRun(art::SubRun const&)
+{
+  ++nSubRunsSeen_;
+}
+
+void
+arttest::SkippedEventsAnalyzer::
+analyze(art::Event const& e)
+{
+  if (seenEvent_) {
+    return;
+  }
+  seenEvent_ = true;
+  if (e.id() != firstEventID_) {
+    throw cet::exception("SkippedEvents")
+      << "First event read was "
+      << e.id()
+      << ", expected "
+      << firstEventID_
+      << ".\n";
+  }
+}
+
+void
+arttest::SkippedEventsAnalyzer::
+endJob()
+{
+  if (!seenEvent_ || nRunsSeen_ != nRuns_ || nSubRunsSeen_ != nSubRuns_) {
+    throw cet::exception("SkippedEvents")
+      << "Saw " << (seenEvent_ ? "" : "no ") << "events, "
+      << nRunsSeen_ << " runs and " << nSubRunsSeen_ << " subruns"
+      << ", expected "
+      << nRuns_ << " runs and " << nSubRuns_ << " subruns.\n";
+  }
+}
+
+DEFINE_ART_MODULE(arttest::SkippedEventsAnalyzer)
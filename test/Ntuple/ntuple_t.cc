@@ -98,7 +98,8 @@ void test_file_create()
     for (std::size_t i = 0; i < 103; ++i) table.insert(i, 0.5*i, i*i);
   }
   sqlite3* db;
-  assert(sqlite3_open(filename, &db) == SQLITE_OK);
+  int const rc = sqlite3_open(filename, &db);
+  assert(rc == SQLITE_OK);
   assert(db);
   std::string query { "SELECT count(*) as cnt FROM tab1" };
   sqlite3_stmt* select_stmt;
@@ -109,6 +110,91 @@ void test_file_create()
   sqlite3_close(db);
 }
 
+// Fill a table in the background while another is filled
+// synchronously on the same connection.
+void test_background_filling(sqlite3* db)
+{
+  std::cout << "start test_background_filling\n";
+  assert(db);
+  // fg writes to the file while the writer of bg may be doing so.
+  sqlite3_busy_timeout(db, 60000);
+  constexpr int nrows { 1003 };
+  {
+    Ntuple<int, double, std::string> bg(db, "bg", {"i", "x", "txt"}, false, 100, FlushMode::background);
+    Ntuple<int, double> fg(db, "fg", {"i", "x"}, false, 10);
+    assert(bg.mode() == FlushMode::background);
+    assert(fg.mode() == FlushMode::synchronous);
+    for (int i = 0; i < nrows; ++i)
+      {
+        bg.insert(i, 1.5 * i, "row " + std::to_string(i));
+        assert(bg.lastRowid() == i + 1);
+        if (i % 3 == 0) fg.insert(i, 0.5 * i);
+      }
+    bg.flush();
+    int nmatches = 0;
+    char* errmsg;
+    int rc = sqlite3_exec(db, "select count(*) from \"bg\"", count_rows, &nmatches, &errmsg);
+    assert(rc == SQLITE_OK);
+    assert(nmatches == nrows);
+  }
+  // Check that the rows are all there, in order.
+  int nmatches = 0;
+  char* errmsg;
+  int rc = sqlite3_exec(db, "select count(*) from \"bg\" where rowid = i+1 and txt = 'row ' || i", count_rows, &nmatches, &errmsg);
+  assert(rc == SQLITE_OK);
+  assert(nmatches == nrows);
+  rc = sqlite3_exec(db, "select count(*) from \"fg\"", count_rows, &nmatches, &errmsg);
+  assert(rc == SQLITE_OK);
+  assert(nmatches == (nrows + 2) / 3);
+  std::cout << "end test_background_filling\n";
+}
+
+// An in-memory database cannot be written in the background.
+void test_background_in_memory()
+{
+  std::cout << "start test_background_in_memory\n";
+  sqlite3* db = nullptr;
+  int rc = sqlite3_open(":memory:", &db);
+  assert(rc == SQLITE_OK);
+  {
+    Ntuple<int> t(db, "t", {"i"}, false, 7, FlushMode::background);
+    assert(t.mode() == FlushMode::synchronous);
+    for (int i = 0; i < 50; ++i) t.insert(i);
+  }
+  int nmatches = 0;
+  char* errmsg;
+  rc = sqlite3_exec(db, "select count(*) from t", count_rows, &nmatches, &errmsg);
+  assert(rc == SQLITE_OK);
+  assert(nmatches == 50);
+  sqlite3_close(db);
+  std::cout << "end test_background_in_memory\n";
+}
+
+// A write failing in the background is reported by the destructor,
+// which must neither throw nor leave the writer thread running.
+void test_background_error()
+{
+  std::cout << "start test_background_error\n";
+  const char* filename = "background_error.db";
+  remove(filename);
+  sqlite3* db = nullptr;
+  int rc = sqlite3_open(filename, &db);
+  assert(rc == SQLITE_OK);
+  sqlite3_busy_timeout(db, 60000);
+  {
+    Ntuple<int> t(db, "t", {"i"}, false, 5, FlushMode::background);
+    assert(t.mode() == FlushMode::background);
+    char* errmsg;
+    rc = sqlite3_exec(db, "drop table t", nullptr, nullptr, &errmsg);
+    assert(rc == SQLITE_OK);
+    // Fewer rows than the buffer holds: they are only written on
+    // destruction.
+    for (int i = 0; i < 4; ++i) t.insert(i);
+  }
+  sqlite3_close(db);
+  std::cout << "end test_background_error\n";
+}
+
 int main()
 try
   {
@@ -131,10 +217,13 @@ try
     test_with_colliding_table<int, double, int>(db, {"x", "txt", "z"});
     test_with_colliding_table<int>(db, {"x"});
     test_filling_table(db);
+    test_background_filling(db);
     // Close database.
     sqlite3_close(db);
 
     test_file_create();
+    test_background_in_memory();
+    test_background_error();
   }
 catch (std::exception const& x)
   {
@@ -26,6 +26,10 @@ public:
     os_(os) {
   }
 
+  TClassStreamer * Generate() const override {
+    return new TestProdStreamer(*this);
+  }
+
   void operator()(TBuffer & R_b, void * objp) {
     static TClassRef cl(TClass::GetClass(typeid(TestProd<A, B>)));
     TestProd<A, B> *obj = reinterpret_cast<TestProd<A, B>*>(objp);
@@ -12,6 +12,7 @@ class testFileIndex: public CppUnit::TestFixture {
    CPPUNIT_TEST(eventSortAndSearchTest);
    CPPUNIT_TEST(eventEntrySortAndSearchTest);
    CPPUNIT_TEST(eventsUniqueAndOrderedTest);
+   CPPUNIT_TEST(eventHashIndexTest);
    CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -22,6 +23,7 @@ public:
    void eventSortAndSearchTest();
    void eventEntrySortAndSearchTest();
    void eventsUniqueAndOrderedTest();
+   void eventHashIndexTest();
 
    bool areEntryVectorsTheSame(art::FileIndex &i1, art::FileIndex &i2);
 };
@@ -447,6 +449,77 @@ void testFileIndex::eventsUniqueAndOrderedTest() {
  CPPUNIT_ASSERT(fileIndex8.eventsUniqueAndOrdered());
 }
 
+void testFileIndex::eventHashIndexTest()
+{
+ art::FileIndex fileIndex;
+ for (unsigned r = 1; r != 4; ++r) {
+   fileIndex.addEntry(art::EventID::invalidEvent(art::RunID(r)), r);
+   for (unsigned sr = 0; sr != 5; ++sr) {
+     fileIndex.addEntry(art::EventID::invalidEvent(art::SubRunID(r, sr)), sr);
+     for (unsigned e = 1; e < 40; e += 2) {
+       fileIndex.addEntry(art::EventID(r, sr, e), 100 * r + 10 * sr + e);
+     }
+   }
+ }
+ // A duplicate: the first one must be found, as by binary search.
+ fileIndex.addEntry(art::EventID(2, 3, 7), 1000);
+ fileIndex.sortBy_Run_SubRun_Event();
+ art::FileIndex const noHash(fileIndex);
+ CPPUNIT_ASSERT(!fileIndex.hasEventHashIndex());
+ fileIndex.buildEventHashIndex();
+ CPPUNIT_ASSERT(fileIndex.hasEventHashIndex());
+
+ for (unsigned r = 1; r != 5; ++r) {
+   for (unsigned sr = 0; sr != 6; ++sr) {
+     for (unsigned e = 1; e != 42; ++e) {
+       art::EventID const id(r, sr, e);
+       for (bool exact : { true, false }) {
+         CPPUNIT_ASSERT((fileIndex.findEventPosition(id, exact) - fileIndex.cbegin()) ==
+                        (noHash.findEventPosition(id, exact) - noHash.cbegin()));
+       }
+     }
+   }
+ }
+ art::FileIndex::const_iterator iter = fileIndex.findEventPosition(art::EventID(2, 3, 7), true);
+ CPPUNIT_ASSERT(iter->entry_ == 237);
+
+ // The index may be handed to an identical file index, as on input.
+ art::FileIndex::EventHashIndex slots(fileIndex.eventHashIndex());
+ art::FileIndex copy(noHash);
+ CPPUNIT_ASSERT(copy.checksum() == fileIndex.checksum());
+ CPPUNIT_ASSERT(copy.adoptEventHashIndex(slots, fileIndex.size(), fileIndex.checksum()));
+ CPPUNIT_ASSERT(copy.hasEventHashIndex());
+ CPPUNIT_ASSERT(copy.containsEvent(art::EventID(3, 4, 39), true));
+ CPPUNIT_ASSERT(!copy.containsEvent(art::EventID(3, 4, 40), true));
+
+ // A table which cannot be a hash table is refused.
+ art::FileIndex::EventHashIndex bad(17, art::FileIndex::Element::invalidEntry);
+ art::FileIndex other(noHash);
+ CPPUNIT_ASSERT(!other.adoptEventHashIndex(bad, fileIndex.size(), fileIndex.checksum()));
+ CPPUNIT_ASSERT(!other.hasEventHashIndex());
+
+ // So is a stale table, which would miss the events added since.
+ art::FileIndex::EventHashIndex stale(fileIndex.eventHashIndex());
+ art::FileIndex longer(noHash);
+ longer.addEntry(art::EventID(3, 4, 41), 2000);
+ longer.sortBy_Run_SubRun_Event();
+ CPPUNIT_ASSERT(!longer.adoptEventHashIndex(stale, fileIndex.size(), fileIndex.checksum()));
+ CPPUNIT_ASSERT(!longer.hasEventHashIndex());
+
+ // And one written for an index of the same size but other contents.
+ stale = fileIndex.eventHashIndex();
+ art::FileIndex changed(noHash);
+ changed.begin()->entry_ += 1;
+ CPPUNIT_ASSERT(changed.size() == fileIndex.size());
+ CPPUNIT_ASSERT(changed.checksum() != fileIndex.checksum());
+ CPPUNIT_ASSERT(!changed.adoptEventHashIndex(stale, fileIndex.size(), fileIndex.checksum()));
+ CPPUNIT_ASSERT(!changed.hasEventHashIndex());
+
+ // Any change to the index discards the hash index.
+ fileIndex.addEntry(art::EventID(4, 0, 1), 2000);
+ CPPUNIT_ASSERT(!fileIndex.hasEventHashIndex());
+}
+
 bool testFileIndex::areEntryVectorsTheSame(art::FileIndex &i1, art::FileIndex &i2) {
    if (i1.size() != i2.size()) return false;
    for (art::FileIndex::const_iterator
@@ -0,0 +1,149 @@
+// Test of MonotonicArena
+#define BOOST_TEST_MODULE (MonotonicArena_t)
+#include "boost/test/auto_unit_test.hpp"
+
+#include "art/Utilities/Exception.h"
+#include "art/Utilities/MonotonicArena.h"
+
+#include <cstdint>
+#include <memory>
+
+using art::MonotonicArena;
+
+namespace {
+  struct Placed {
+    static void* operator new(std::size_t n)
+    {
+      return MonotonicArena::allocateObject(n);
+    }
+    static void operator delete(void* p)
+    {
+      MonotonicArena::deallocateObject(p);
+    }
+    double value[4];
+  };
+
+  bool aligned(void const* p, std::size_t alignment)
+  {
+    return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(MonotonicArena_t)
+
+BOOST_AUTO_TEST_CASE(allocate)
+{
+  MonotonicArena arena(1024);
+  BOOST_CHECK_EQUAL(arena.blocks(), 0u);
+  auto const a = static_cast<char*>(arena.allocate(3, 1));
+  auto const b = arena.allocate(8, 8);
+  BOOST_CHECK(aligned(b, 8));
+  BOOST_CHECK(static_cast<char*>(b) >= a + 3);
+  BOOST_CHECK_EQUAL(arena.blocks(), 1u);
+  BOOST_CHECK(MonotonicArena::contains(a));
+  BOOST_CHECK(MonotonicArena::contains(b));
+  int onStack {0};
+  BOOST_CHECK(!MonotonicArena::contains(&onStack));
+  // Larger than a block: a new one, big enough.
+  auto const c = arena.allocate(4096);
+  BOOST_CHECK(aligned(c, alignof(std::max_align_t)));
+  BOOST_CHECK_EQUAL(arena.blocks(), 2u);
+  BOOST_CHECK(arena.bytesInUse() >= 3 + 8 + 4096);
+  BOOST_CHECK_EQUAL(arena.highWaterMark(), arena.bytesInUse());
+}
+
+BOOST_AUTO_TEST_CASE(release)
+{
+  MonotonicArena arena(256);
+  for (int i = 0; i != 100; ++i) {
+    arena.allocate(64);
+  }
+  auto const used = arena.bytesInUse();
+  BOOST_CHECK(arena.blocks() > 1u);
+  arena.release();
+  BOOST_CHECK_EQUAL(arena.bytesInUse(), 0u);
+  BOOST_CHECK_EQUAL(arena.highWaterMark(), used);
+  BOOST_CHECK_EQUAL(arena.blocks(), 1u);
+  // The kept block is the largest, which holds the last allocation.
+  auto const p = arena.allocate(64);
+  BOOST_CHECK(MonotonicArena::contains(p));
+  BOOST_CHECK_EQUAL(arena.blocks(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(mark_rewind)
+{
+  MonotonicArena arena(256);
+  auto const kept = arena.allocate(64);
+  auto const mark = arena.mark();
+  auto const first = arena.allocate(64);
+  for (int i = 0; i != 100; ++i) {
+    arena.allocate(64);
+  }
+  auto const nBlocks = arena.blocks();
+  arena.rewind(mark);
+  BOOST_CHECK_EQUAL(arena.bytesInUse(), 64u);
+  BOOST_CHECK_EQUAL(arena.blocks(), nBlocks);
+  // The same memory again, with no new blocks.
+  BOOST_CHECK_EQUAL(arena.allocate(64), first);
+  for (int i = 0; i != 100; ++i) {
+    arena.allocate(64);
+  }
+  BOOST_CHECK_EQUAL(arena.blocks(), nBlocks);
+  BOOST_CHECK(MonotonicArena::contains(kept));
+  // Back to empty: the first block is reused.
+  arena.rewind(MonotonicArena::Mark());
+  BOOST_CHECK_EQUAL(arena.bytesInUse(), 0u);
+  BOOST_CHECK_EQUAL(arena.allocate(64), kept);
+  BOOST_CHECK_EQUAL(arena.blocks(), nBlocks);
+}
+
+BOOST_AUTO_TEST_CASE(current_arena)
+{
+  MonotonicArena arena;
+  BOOST_CHECK(!MonotonicArena::current());
+  std::unique_ptr<Placed> onHeap(new Placed);
+  BOOST_CHECK(!MonotonicArena::contains(onHeap.get()));
+  {
+    cet::exempt_ptr<MonotonicArena> const arenaPtr(&arena);
+    MonotonicArena::Scope withArena(arenaPtr);
+    BOOST_CHECK(MonotonicArena::current().get() == &arena);
+    {
+      MonotonicArena::Scope noArena((cet::exempt_ptr<MonotonicArena>()));
+      BOOST_CHECK(!MonotonicArena::current());
+    }
+    std::unique_ptr<Placed> inArena(new Placed);
+    BOOST_CHECK(MonotonicArena::contains(inArena.get()));
+    BOOST_CHECK(aligned(inArena.get(), alignof(std::max_align_t)));
+  }
+  BOOST_CHECK(!MonotonicArena::current());
+  BOOST_CHECK(arena.bytesInUse() >= sizeof(Placed));
+}
+
+BOOST_AUTO_TEST_CASE(object_options)
+{
+  BOOST_CHECK(!MonotonicArena::foreignObjects());
+  MonotonicArena::setForeignObjects(true);
+  BOOST_CHECK(MonotonicArena::foreignObjects());
+  MonotonicArena::setForeignObjects(false);
+  // Objects have been placed by now.
+  std::unique_ptr<Placed> placed(new Placed);
+  BOOST_CHECK_NO_THROW(MonotonicArena::setPlaceObjects(true));
+  BOOST_CHECK_THROW(MonotonicArena::setPlaceObjects(false), art::Exception);
+}
+
+BOOST_AUTO_TEST_CASE(statistics)
+{
+  auto const before = MonotonicArena::statistics();
+  {
+    MonotonicArena arena(1024);
+    arena.allocate(100);
+    auto const during = MonotonicArena::statistics();
+    BOOST_CHECK_EQUAL(during.bytesInUse, before.bytesInUse + 100);
+    BOOST_CHECK(during.peakBytesInUse >= during.bytesInUse);
+    BOOST_CHECK(during.largestArena >= 100u);
+    BOOST_CHECK_EQUAL(during.blocksAllocated, before.blocksAllocated + 1);
+  }
+  BOOST_CHECK_EQUAL(MonotonicArena::statistics().bytesInUse, before.bytesInUse);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
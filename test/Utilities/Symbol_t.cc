@@ -0,0 +1,113 @@
+#define BOOST_TEST_MODULE ( Symbol_t )
+#include "boost/test/auto_unit_test.hpp"
+
+#include "art/Utilities/InputTag.h"
+#include "art/Utilities/Symbol.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using art::InputTag;
+using art::Symbol;
+
+BOOST_AUTO_TEST_SUITE ( Symbol_t )
+
+BOOST_AUTO_TEST_CASE ( Symbol_empty )
+{
+  Symbol s;
+  BOOST_CHECK(s.empty());
+  BOOST_CHECK_EQUAL(s.id(), 0u);
+  BOOST_CHECK_EQUAL(s.str(), std::string());
+  BOOST_CHECK(s == Symbol(""));
+  BOOST_CHECK(s == Symbol(std::string()));
+}
+
+BOOST_AUTO_TEST_CASE ( Symbol_interning )
+{
+  std::string const label("aVeryLongModuleLabelIndeed");
+  Symbol a(label);
+  auto const n = Symbol::tableSize();
+  Symbol b(label.c_str());
+  Symbol c("aVeryLongModuleLabelIndeedNot", label.size());
+  BOOST_CHECK_EQUAL(Symbol::tableSize(), n);
+  BOOST_CHECK(a == b);
+  BOOST_CHECK(a == c);
+  BOOST_CHECK_EQUAL(&a.str(), &b.str());
+  BOOST_CHECK_EQUAL(a.str(), label);
+  BOOST_CHECK(!a.empty());
+  Symbol d("anotherLabel");
+  BOOST_CHECK(a != d);
+  BOOST_CHECK_NE(a.id(), d.id());
+  std::ostringstream os;
+  os << d;
+  BOOST_CHECK_EQUAL(os.str(), std::string("anotherLabel"));
+}
+
+BOOST_AUTO_TEST_CASE ( Symbol_many )
+{
+  // Enough to make the table grow several times.
+  for (int i = 0; i != 5000; ++i) {
+    std::string const name("label" + std::to_string(i));
+    Symbol const s(name);
+    BOOST_REQUIRE_EQUAL(s.str(), name);
+  }
+  for (int i = 0; i != 5000; ++i) {
+    std::string const name("label" + std::to_string(i));
+    BOOST_REQUIRE_EQUAL(Symbol(name).str(), name);
+  }
+}
+
+BOOST_AUTO_TEST_CASE ( Symbol_concurrent )
+{
+  // Lookups and insertions racing with the growth of the table.
+  std::vector<std::thread> threads;
+  std::vector<int> failures(4, 0);
+  for (int t = 0; t != 4; ++t) {
+    threads.emplace_back([t, &failures]() {
+        for (int i = 0; i != 8000; ++i) {
+          std::string const name("concurrent" + std::to_string((i * 7 + t) % 4000));
+          Symbol const s(name);
+          if (s.str() != name || Symbol(name) != s) {
+            ++failures[t];
+          }
+        }
+      });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto const n : failures) {
+    BOOST_CHECK_EQUAL(n, 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE ( InputTag_symbols )
+{
+  InputTag const a("alabel:aninstance:aprocess");
+  InputTag const b("alabel", "aninstance", "aprocess");
+  BOOST_CHECK(a.labelSymbol() == Symbol("alabel"));
+  BOOST_CHECK(a.instanceSymbol() == Symbol("aninstance"));
+  BOOST_CHECK(a.processSymbol() == Symbol("aprocess"));
+  BOOST_CHECK(InputTag("alabel").processSymbol().empty());
+  std::hash<InputTag> h;
+  BOOST_CHECK_EQUAL(h(a), h(b));
+  std::unordered_set<InputTag> tags { a, b, InputTag("alabel:aninstance") };
+  BOOST_CHECK_EQUAL(tags.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE ( InputTag_copy_does_not_intern )
+{
+  InputTag const a("some:tag:here");
+  auto const n = Symbol::tableSize();
+  for (int i = 0; i != 100; ++i) {
+    InputTag const b(a);
+    InputTag const c("some", "tag", "here");
+    BOOST_REQUIRE(b == c);
+  }
+  BOOST_CHECK_EQUAL(Symbol::tableSize(), n);
+}
+
+BOOST_AUTO_TEST_SUITE_END()